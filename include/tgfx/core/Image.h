@@ -346,5 +346,6 @@ class Image {
   friend class RasterizedImage;
   friend class ImageShader;
   friend class Caster;
+  friend class ImageAtlas;
 };
 }  // namespace tgfx
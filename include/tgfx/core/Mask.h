@@ -145,5 +145,6 @@ class Mask {
 
   friend class ImageReader;
   friend class GlyphRasterizer;
+  friend class GlyphAtlas;
 };
 }  // namespace tgfx
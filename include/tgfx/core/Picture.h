@@ -22,7 +22,7 @@
 #include "tgfx/core/Path.h"
 
 namespace tgfx {
-class Record;
+class PictureRecords;
 class Canvas;
 class DrawContext;
 class SVGExportContext;
@@ -44,6 +44,8 @@ class Picture {
    * factors, it's best to use the final drawing matrix to calculate the bounds for accuracy.
    * Note that the bounds only include the combined geometry of each drawing command, but some
    * commands may draw outside these bounds. Use the hasUnboundedFill() method to check for this.
+   * The bounds without a matrix are computed once when the recording finishes, so they are cheap
+   * to query.
    */
   Rect getBounds(const Matrix* matrix = nullptr) const;
 
@@ -64,12 +66,17 @@ class Picture {
   void playback(Canvas* canvas) const;
 
  private:
-  std::vector<Record*> records = {};
+  std::unique_ptr<PictureRecords> records;
   bool _hasUnboundedFill = false;
 
-  Picture(std::vector<Record*> records, bool hasUnboundedFill);
+  Picture(std::unique_ptr<PictureRecords> records, bool hasUnboundedFill);
 
-  void playback(DrawContext* drawContext, const MCState& state) const;
+  /**
+   * Replays the drawing commands to the given context. The commands outside the clip of the state
+   * and the optional device-space cullRect are skipped.
+   */
+  void playback(DrawContext* drawContext, const MCState& state,
+                const Rect* cullRect = nullptr) const;
 
   std::shared_ptr<Image> asImage(Point* offset, const Matrix* matrix = nullptr,
                                  const ISize* clipSize = nullptr) const;
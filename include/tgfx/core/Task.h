@@ -19,10 +19,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace tgfx {
 class TaskGroup;
@@ -49,6 +51,63 @@ enum class TaskStatus {
   Canceled
 };
 
+/**
+ * Defines the priority classes of a Task. Queued tasks with a higher priority are always picked
+ * before the ones with a lower priority, but a running task is never preempted.
+ */
+enum class TaskPriority {
+  /**
+   * For work that the current frame is waiting for, such as decoding images or rasterizing shapes
+   * that are about to be drawn.
+   */
+  High,
+  /**
+   * For general work that has no specific urgency.
+   */
+  Default,
+  /**
+   * For speculative work, such as prefetching or pre-decoding content that may be drawn later.
+   */
+  Low
+};
+
+/**
+ * ThreadPoolOptions configures the worker threads that execute Tasks.
+ */
+struct ThreadPoolOptions {
+  /**
+   * The maximum number of worker threads. If it is less than or equal to 0, the number of CPU
+   * cores is used, capped at 16.
+   */
+  int maxThreads = 0;
+
+  /**
+   * The capacity of the lock-free queue shared by all workers for each task priority. Tasks
+   * submitted while the queue is full are kept in an unbounded overflow list, which takes a lock on
+   * every access. The capacity is rounded up to the nearest power of 2.
+   */
+  uint32_t queueCapacity = 1024;
+
+  /**
+   * How long a worker thread stays alive without any task to execute. Idle workers are restarted
+   * on demand when new tasks arrive. If it is zero or negative, idle workers never exit.
+   */
+  std::chrono::milliseconds idleTimeout = std::chrono::seconds(10);
+
+  /**
+   * The CPU indices to pin the worker threads to. The i-th worker is pinned to the CPU at
+   * cpuAffinity[i % cpuAffinity.size()]. If empty, the workers are not pinned. Only supported on
+   * Linux, Android and Windows, ignored on other platforms.
+   */
+  std::vector<int> cpuAffinity = {};
+
+  /**
+   * The NUMA node whose CPUs the worker threads are restricted to, or -1 to leave them unbound.
+   * Ignored if cpuAffinity is not empty. Only supported on Linux and Android.
+   */
+  int numaNode = -1;
+};
+
 /**
  * The Task class manages the concurrent execution of one or more code blocks.
  */
@@ -59,13 +118,45 @@ class Task {
    * block. Hold a reference to the returned Task if you want to cancel it or wait for it to finish
    * execution. Returns nullptr if the block is nullptr.
    */
-  static std::shared_ptr<Task> Run(std::function<void()> block);
+  static std::shared_ptr<Task> Run(std::function<void()> block,
+                                   TaskPriority priority = TaskPriority::Default);
 
   /**
    * Submits a Task for asynchronous execution immediately. Hold a reference to the Task if you want
    * to cancel it or wait for it to finish execution. Does nothing if the Task is nullptr.
    */
-  static void Run(std::shared_ptr<Task> task);
+  static void Run(std::shared_ptr<Task> task, TaskPriority priority = TaskPriority::Default);
+
+  /**
+   * Splits the range [0, count) into chunks of at most grain elements and calls the block for each
+   * chunk in parallel, passing the begin and end indices of the chunk. A grain of 0 is treated as
+   * 1. The calling thread also processes chunks, and the method returns after all chunks are done.
+   * Chunks are executed in no particular order, so the block must be safe to call concurrently.
+   */
+  static void ParallelFor(size_t count, size_t grain,
+                          const std::function<void(size_t begin, size_t end)>& block,
+                          TaskPriority priority = TaskPriority::High);
+
+  /**
+   * Configures the thread pool that executes Tasks. It only takes effect before the thread pool
+   * starts its first worker thread, so call it before submitting any Task. Returns false if the
+   * worker threads have already started, in which case the options are ignored.
+   */
+  static bool SetThreadPoolOptions(const ThreadPoolOptions& options);
+
+  /**
+   * Starts all the worker threads of the thread pool up front, so that the first Tasks submitted
+   * after a quiet period don't pay for the thread creation. Returns the number of running worker
+   * threads.
+   */
+  static int PrewarmThreadPool();
+
+  /**
+   * Returns the maximum number of worker threads of the thread pool, as configured by
+   * SetThreadPoolOptions(). Work split into parallel chunks should be sized by this number rather
+   * than the number of hardware threads. Returns 0 if the platform has no worker threads.
+   */
+  static int MaxThreadCount();
 
   virtual ~Task() = default;
 
@@ -76,6 +167,13 @@ class Task {
     return _status.load(std::memory_order_relaxed);
   }
 
+  /**
+   * Returns the priority the Task was submitted with.
+   */
+  TaskPriority priority() const {
+    return _priority;
+  }
+
   /**
    * Requests the Task to skip executing its Runnable object. Cancellation does not affect the
    * execution of a Task that has already begun.
@@ -96,8 +194,12 @@ class Task {
   std::mutex locker = {};
   std::condition_variable condition = {};
   std::atomic<TaskStatus> _status = TaskStatus::Queueing;
+  TaskPriority _priority = TaskPriority::Default;
+
+  static void Submit(std::shared_ptr<Task> task);
 
   void execute();
+  void finish();
 
   friend class TaskGroup;
 };
@@ -51,5 +51,19 @@ class Caps {
   bool mipmapSupport = true;
   bool textureBarrierSupport = false;
   bool frameBufferFetchSupport = false;
+  /**
+   * Whether per-instance vertex attributes and instanced draw calls are supported. Available in
+   * desktop GL 3.3, GLES 3.0 and WebGL 2.0.
+   */
+  bool instancedDrawSupport = false;
+  /**
+   * Whether program uniforms are sourced from a std140 uniform block bound to a buffer range
+   * instead of being set one by one. Available in desktop GL 3.1.
+   */
+  bool uniformBufferSupport = false;
+  /**
+   * The required alignment of the offset of a uniform block inside its buffer, in bytes.
+   */
+  int uniformBufferOffsetAlignment = 256;
 };
 }  // namespace tgfx
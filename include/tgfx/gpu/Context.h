@@ -23,6 +23,8 @@
 #include "tgfx/gpu/Backend.h"
 #include "tgfx/gpu/Caps.h"
 #include "tgfx/gpu/Device.h"
+#include "tgfx/gpu/PersistentCache.h"
+#include "tgfx/gpu/ProgramManifest.h"
 
 namespace tgfx {
 class ProgramCache;
@@ -80,6 +82,63 @@ class Context {
     return _proxyProvider;
   }
 
+  /**
+   * Returns the cache that stores compiled programs across application launches, or nullptr if
+   * none is set.
+   */
+  PersistentCache* persistentCache() const {
+    return _persistentCache.get();
+  }
+
+  /**
+   * Sets the cache that stores compiled programs across application launches. Programs that are
+   * not found in the cache are compiled from source and then stored into it. The cache is ignored
+   * if the GPU backend can't retrieve program binaries. Set to nullptr to disable it.
+   */
+  void setPersistentCache(std::shared_ptr<PersistentCache> cache) {
+    _persistentCache = std::move(cache);
+  }
+
+  /**
+   * Starts adding every shader program built by this context to the given manifest, which can then
+   * be serialized and passed to precompilePrograms() in a later session. Pass nullptr to stop
+   * recording.
+   */
+  void recordPrograms(std::shared_ptr<ProgramManifest> manifest);
+
+  /**
+   * Compiles the shader programs listed in the manifest ahead of their first use, so that the first
+   * frames that need them don't stall on shader compilation. At most maxPrograms programs are
+   * compiled per call, which allows spreading the work across idle frames by calling this method
+   * repeatedly until it returns 0. Programs that have already been built are skipped. Returns the
+   * number of programs left to compile.
+   */
+  size_t precompilePrograms(const ProgramManifest& manifest, size_t maxPrograms = SIZE_MAX);
+
+  /**
+   * Returns the byte budget of the cached shader programs.
+   */
+  size_t programCacheLimit() const;
+
+  /**
+   * Sets the byte budget of the cached shader programs. The size of a program is estimated from
+   * the length of its binary when the driver reports one, and from its source length otherwise.
+   * The least recently used programs are released once the budget is exceeded.
+   */
+  void setProgramCacheLimit(size_t bytesLimit);
+
+  /**
+   * Returns the maximum width or height of the images that are packed into shared atlas textures.
+   */
+  int imageAtlasLimit() const;
+
+  /**
+   * Sets the maximum width or height of the images that are packed into shared atlas textures.
+   * Consecutive draws of atlas images with compatible paints are merged into a single draw call.
+   * Setting it to 0 disables the atlas. The default value is 128.
+   */
+  void setImageAtlasLimit(int maxImageSize);
+
   /**
    * Returns the number of bytes consumed by internal gpu caches.
    */
@@ -194,6 +253,7 @@ class Context {
   DrawingManager* _drawingManager = nullptr;
   ResourceProvider* _resourceProvider = nullptr;
   ProxyProvider* _proxyProvider = nullptr;
+  std::shared_ptr<PersistentCache> _persistentCache = nullptr;
 
   void releaseAll(bool releaseGPU);
 
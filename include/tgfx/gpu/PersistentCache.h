@@ -0,0 +1,52 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * PersistentCache stores compiled GPU programs across application launches, so the shaders don't
+ * need to be compiled again on the next cold start. The keys and values are opaque blobs produced
+ * by the GPU backend. Implementations must be thread-safe, since a cache may be shared by multiple
+ * contexts that run on different threads.
+ */
+class PersistentCache {
+ public:
+  /**
+   * Creates a PersistentCache that stores each entry as a file in the given directory. The
+   * directory must already exist and be writable. Returns nullptr if the directory is empty.
+   */
+  static std::shared_ptr<PersistentCache> MakeFromDirectory(const std::string& directory);
+
+  virtual ~PersistentCache() = default;
+
+  /**
+   * Returns the data previously stored for the key, or nullptr if there is no such entry.
+   */
+  virtual std::shared_ptr<Data> load(const Data& key) = 0;
+
+  /**
+   * Stores the data for the key, replacing any previous entry with the same key.
+   */
+  virtual void store(const Data& key, const Data& data) = 0;
+};
+}  // namespace tgfx
@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * ProgramManifest lists the GPU programs built during a session, so they can be precompiled at the
+ * start of the next one with Context::precompilePrograms() before the first frame that needs them.
+ * A manifest is filled by Context::recordPrograms() and can be saved with serialize(). It is only
+ * meaningful for the same version of the library, but can be reused across devices since the
+ * programs are stored as shader sources. ProgramManifest is thread-safe.
+ */
+class ProgramManifest {
+ public:
+  /**
+   * Creates an empty ProgramManifest.
+   */
+  static std::shared_ptr<ProgramManifest> Make();
+
+  /**
+   * Creates a ProgramManifest from the data previously returned by serialize(). Returns nullptr if
+   * the data is not a valid manifest.
+   */
+  static std::shared_ptr<ProgramManifest> MakeFrom(std::shared_ptr<Data> data);
+
+  /**
+   * Returns the number of programs in the manifest.
+   */
+  size_t size() const;
+
+  /**
+   * Serializes the manifest into a Data object that can be stored and restored with MakeFrom().
+   */
+  std::shared_ptr<Data> serialize() const;
+
+ private:
+  struct ProgramSource {
+    std::string vertex;
+    std::string fragment;
+  };
+
+  mutable std::mutex locker = {};
+  std::vector<ProgramSource> programs = {};
+  std::unordered_set<uint64_t> programHashes = {};
+
+  ProgramManifest() = default;
+
+  void addProgram(const std::string& vertex, const std::string& fragment, uint64_t hash);
+
+  friend class ProgramCache;
+};
+}  // namespace tgfx
@@ -109,6 +109,9 @@ namespace tgfx {
 #define GL_VERTEX_ARRAY_BINDING 0x85B5
 #define GL_PIXEL_PACK_BUFFER 0x88EB
 #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_INVALID_INDEX 0xFFFFFFFFu
 
 #define GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM 0x78EC
 #define GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM 0x78ED
@@ -804,7 +807,10 @@ namespace tgfx {
 #define GL_NUM_SHADER_BINARY_FORMATS 0x8DF9
 
 // Program Binary
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
 #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
 
 // Shader Precision-Specified Types
 #define GL_LOW_FLOAT 0x8DF0
@@ -901,6 +907,10 @@ namespace tgfx {
 
 #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
 #define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
 
 #endif
 }  // namespace tgfx
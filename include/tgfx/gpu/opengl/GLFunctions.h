@@ -41,6 +41,8 @@ using GLAttachShader = void GL_FUNCTION_TYPE(unsigned program, unsigned shader);
 using GLBindAttribLocation = void GL_FUNCTION_TYPE(unsigned program, unsigned index,
                                                    const char* name);
 using GLBindBuffer = void GL_FUNCTION_TYPE(unsigned target, unsigned buffer);
+using GLBindBufferRange = void GL_FUNCTION_TYPE(unsigned target, unsigned index, unsigned buffer,
+                                                GLintptr offset, GLsizeiptr size);
 using GLBindVertexArray = void GL_FUNCTION_TYPE(unsigned vertexArray);
 using GLBindFramebuffer = void GL_FUNCTION_TYPE(unsigned target, unsigned framebuffer);
 using GLBindRenderbuffer = void GL_FUNCTION_TYPE(unsigned target, unsigned renderbuffer);
@@ -60,6 +62,7 @@ using GLClear = void GL_FUNCTION_TYPE(unsigned mask);
 using GLClearColor = void GL_FUNCTION_TYPE(float red, float green, float blue, float alpha);
 using GLClearDepthf = void GL_FUNCTION_TYPE(float depth);
 using GLClearStencil = void GL_FUNCTION_TYPE(int s);
+using GLClientWaitSync = unsigned GL_FUNCTION_TYPE(void* sync, unsigned flags, uint64_t timeout);
 using GLColorMask = void GL_FUNCTION_TYPE(unsigned char red, unsigned char green,
                                           unsigned char blue, unsigned char alpha);
 using GLCompileShader = void GL_FUNCTION_TYPE(unsigned shader);
@@ -88,8 +91,12 @@ using GLDepthMask = void GL_FUNCTION_TYPE(unsigned char flag);
 using GLDisable = void GL_FUNCTION_TYPE(unsigned cap);
 using GLDisableVertexAttribArray = void GL_FUNCTION_TYPE(unsigned index);
 using GLDrawArrays = void GL_FUNCTION_TYPE(unsigned mode, int first, int count);
+using GLDrawArraysInstanced = void GL_FUNCTION_TYPE(unsigned mode, int first, int count,
+                                                    int instanceCount);
 using GLDrawElements = void GL_FUNCTION_TYPE(unsigned mode, int count, unsigned type,
                                              const void* indices);
+using GLDrawElementsInstanced = void GL_FUNCTION_TYPE(unsigned mode, int count, unsigned type,
+                                                      const void* indices, int instanceCount);
 using GLEnable = void GL_FUNCTION_TYPE(unsigned cap);
 using GLIsEnabled = unsigned char GL_FUNCTION_TYPE(unsigned cap);
 using GLEnableVertexAttribArray = void GL_FUNCTION_TYPE(unsigned index);
@@ -123,6 +130,8 @@ using GLGetFramebufferAttachmentParameteriv = void GL_FUNCTION_TYPE(unsigned tar
 using GLGetIntegerv = void GL_FUNCTION_TYPE(unsigned pname, int* params);
 using GLGetInternalformativ = void GL_FUNCTION_TYPE(unsigned target, unsigned internalformat,
                                                     unsigned pname, int bufSize, int* params);
+using GLGetProgramBinary = void GL_FUNCTION_TYPE(unsigned program, int bufSize, int* length,
+                                                 unsigned* binaryFormat, void* binary);
 using GLGetProgramInfoLog = void GL_FUNCTION_TYPE(unsigned program, int bufsize, int* length,
                                                   char* infolog);
 using GLGetProgramiv = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int* params);
@@ -140,11 +149,16 @@ using GLGetVertexAttribiv = void GL_FUNCTION_TYPE(unsigned index, unsigned pname
 using GLGetVertexAttribPointerv = void GL_FUNCTION_TYPE(unsigned index, unsigned pname,
                                                         void** pointer);
 using GLGetAttribLocation = int GL_FUNCTION_TYPE(unsigned program, const char* name);
+using GLGetUniformBlockIndex = unsigned GL_FUNCTION_TYPE(unsigned program,
+                                                         const char* uniformBlockName);
 using GLGetUniformLocation = int GL_FUNCTION_TYPE(unsigned program, const char* name);
 using GLIsTexture = unsigned char GL_FUNCTION_TYPE(unsigned texture);
 using GLLineWidth = void GL_FUNCTION_TYPE(float width);
 using GLLinkProgram = void GL_FUNCTION_TYPE(unsigned program);
 using GLPixelStorei = void GL_FUNCTION_TYPE(unsigned pname, int param);
+using GLProgramBinary = void GL_FUNCTION_TYPE(unsigned program, unsigned binaryFormat,
+                                              const void* binary, int length);
+using GLProgramParameteri = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int value);
 using GLReadPixels = void GL_FUNCTION_TYPE(int x, int y, int width, int height, unsigned format,
                                            unsigned type, void* pixels);
 using GLRenderbufferStorage = void GL_FUNCTION_TYPE(unsigned target, unsigned internalformat,
@@ -207,11 +221,14 @@ using GLUniformMatrix3fv = void GL_FUNCTION_TYPE(int location, int count, unsign
                                                  const float* value);
 using GLUniformMatrix4fv = void GL_FUNCTION_TYPE(int location, int count, unsigned char transpose,
                                                  const float* value);
+using GLUniformBlockBinding = void GL_FUNCTION_TYPE(unsigned program, unsigned uniformBlockIndex,
+                                                    unsigned uniformBlockBinding);
 using GLUseProgram = void GL_FUNCTION_TYPE(unsigned program);
 using GLVertexAttrib1f = void GL_FUNCTION_TYPE(unsigned indx, float value);
 using GLVertexAttrib2fv = void GL_FUNCTION_TYPE(unsigned indx, const float* values);
 using GLVertexAttrib3fv = void GL_FUNCTION_TYPE(unsigned indx, const float* values);
 using GLVertexAttrib4fv = void GL_FUNCTION_TYPE(unsigned indx, const float* values);
+using GLVertexAttribDivisor = void GL_FUNCTION_TYPE(unsigned index, unsigned divisor);
 using GLVertexAttribPointer = void GL_FUNCTION_TYPE(unsigned indx, int size, unsigned type,
                                                     unsigned char normalized, int stride,
                                                     const void* ptr);
@@ -234,6 +251,7 @@ class GLFunctions {
   GLAttachShader* attachShader = nullptr;
   GLBindAttribLocation* bindAttribLocation = nullptr;
   GLBindBuffer* bindBuffer = nullptr;
+  GLBindBufferRange* bindBufferRange = nullptr;
   GLBindFramebuffer* bindFramebuffer = nullptr;
   GLBindRenderbuffer* bindRenderbuffer = nullptr;
   GLBindTexture* bindTexture = nullptr;
@@ -250,6 +268,7 @@ class GLFunctions {
   GLClearColor* clearColor = nullptr;
   GLClearDepthf* clearDepthf = nullptr;
   GLClearStencil* clearStencil = nullptr;
+  GLClientWaitSync* clientWaitSync = nullptr;
   GLColorMask* colorMask = nullptr;
   GLCompileShader* compileShader = nullptr;
   GLCompressedTexImage2D* compressedTexImage2D = nullptr;
@@ -271,7 +290,9 @@ class GLFunctions {
   GLDisable* disable = nullptr;
   GLDisableVertexAttribArray* disableVertexAttribArray = nullptr;
   GLDrawArrays* drawArrays = nullptr;
+  GLDrawArraysInstanced* drawArraysInstanced = nullptr;
   GLDrawElements* drawElements = nullptr;
+  GLDrawElementsInstanced* drawElementsInstanced = nullptr;
   GLEnable* enable = nullptr;
   GLIsEnabled* isEnabled = nullptr;
   GLEnableVertexAttribArray* enableVertexAttribArray = nullptr;
@@ -294,6 +315,7 @@ class GLFunctions {
   GLGetIntegerv* getIntegerv = nullptr;
   GLGetInternalformativ* getInternalformativ = nullptr;
   GLGetBooleanv* getBooleanv = nullptr;
+  GLGetProgramBinary* getProgramBinary = nullptr;
   GLGetProgramInfoLog* getProgramInfoLog = nullptr;
   GLGetProgramiv* getProgramiv = nullptr;
   GLGetRenderbufferParameteriv* getRenderbufferParameteriv = nullptr;
@@ -305,11 +327,14 @@ class GLFunctions {
   GLGetVertexAttribiv* getVertexAttribiv = nullptr;
   GLGetVertexAttribPointerv* getVertexAttribPointerv = nullptr;
   GLGetAttribLocation* getAttribLocation = nullptr;
+  GLGetUniformBlockIndex* getUniformBlockIndex = nullptr;
   GLGetUniformLocation* getUniformLocation = nullptr;
   GLIsTexture* isTexture = nullptr;
   GLLineWidth* lineWidth = nullptr;
   GLLinkProgram* linkProgram = nullptr;
   GLPixelStorei* pixelStorei = nullptr;
+  GLProgramBinary* programBinary = nullptr;
+  GLProgramParameteri* programParameteri = nullptr;
   GLReadPixels* readPixels = nullptr;
   GLRenderbufferStorage* renderbufferStorage = nullptr;
   GLRenderbufferStorageMultisample* renderbufferStorageMultisample = nullptr;
@@ -351,11 +376,13 @@ class GLFunctions {
   GLUniformMatrix2fv* uniformMatrix2fv = nullptr;
   GLUniformMatrix3fv* uniformMatrix3fv = nullptr;
   GLUniformMatrix4fv* uniformMatrix4fv = nullptr;
+  GLUniformBlockBinding* uniformBlockBinding = nullptr;
   GLUseProgram* useProgram = nullptr;
   GLVertexAttrib1f* vertexAttrib1f = nullptr;
   GLVertexAttrib2fv* vertexAttrib2fv = nullptr;
   GLVertexAttrib3fv* vertexAttrib3fv = nullptr;
   GLVertexAttrib4fv* vertexAttrib4fv = nullptr;
+  GLVertexAttribDivisor* vertexAttribDivisor = nullptr;
   GLVertexAttribPointer* vertexAttribPointer = nullptr;
   GLViewport* viewport = nullptr;
   GLWaitSync* waitSync = nullptr;
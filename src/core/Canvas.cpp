@@ -141,19 +141,15 @@ const Matrix& Canvas::getMatrix() const {
 }
 
 const Path& Canvas::getTotalClip() const {
-  return mcState->clip;
+  return mcState->clip.getPath();
 }
 
 void Canvas::clipRect(const tgfx::Rect& rect) {
-  Path path = {};
-  path.addRect(rect);
-  clipPath(path);
+  mcState->clip.clipRect(rect, mcState->matrix);
 }
 
 void Canvas::clipPath(const Path& path) {
-  auto clipPath = path;
-  clipPath.transform(mcState->matrix);
-  mcState->clip.addPath(clipPath, PathOp::Intersect);
+  mcState->clip.clipPath(path, mcState->matrix);
 }
 
 void Canvas::resetStateStack() {
@@ -440,7 +436,7 @@ void Canvas::drawLayer(std::shared_ptr<Picture> picture, const MCState& state, c
       drawContext->drawImage(std::move(image), {}, drawState, fill);
       return;
     }
-  } else if (picture->records.size() == 1 && fill.maskFilter == nullptr) {
+  } else if (picture->records->size() == 1 && fill.maskFilter == nullptr) {
     LayerUnrollContext layerContext(drawContext, fill);
     picture->playback(&layerContext, state);
     if (layerContext.hasUnrolled()) {
@@ -0,0 +1,334 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ClipStack.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tgfx {
+static bool RRectContainsRect(const RRect& rRect, const Rect& rect) {
+  if (!rRect.rect.contains(rect)) {
+    return false;
+  }
+  auto& radii = rRect.radii;
+  if (radii.x <= 0 || radii.y <= 0) {
+    return true;
+  }
+  auto innerRect = rRect.rect.makeInset(radii.x, radii.y);
+  Point corners[4] = {{rect.left, rect.top},
+                      {rect.right, rect.top},
+                      {rect.right, rect.bottom},
+                      {rect.left, rect.bottom}};
+  for (auto& corner : corners) {
+    auto dx = std::max({innerRect.left - corner.x, corner.x - innerRect.right, 0.0f}) / radii.x;
+    auto dy = std::max({innerRect.top - corner.y, corner.y - innerRect.bottom, 0.0f}) / radii.y;
+    if (dx * dx + dy * dy > 1.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static ClipElement MakeElementFromPath(Path path) {
+  if (!path.isInverseFillType()) {
+    Rect rect = {};
+    if (path.isRect(&rect)) {
+      return ClipElement::MakeRect(rect);
+    }
+    RRect rRect = {};
+    if (path.isOval(&rect)) {
+      rRect.setOval(rect);
+      return ClipElement::MakeRRect(rRect);
+    }
+    if (path.isRRect(&rRect)) {
+      return ClipElement::MakeRRect(rRect);
+    }
+  }
+  return ClipElement::MakePath(std::move(path));
+}
+
+ClipElement ClipElement::MakeRect(const Rect& rect) {
+  ClipElement element = {};
+  element._type = Type::Rect;
+  element._rRect.rect = rect.makeSorted();
+  return element;
+}
+
+ClipElement ClipElement::MakeRRect(const RRect& rRect) {
+  if (rRect.isRect()) {
+    return MakeRect(rRect.rect);
+  }
+  ClipElement element = {};
+  element._type = Type::RRect;
+  element._rRect = rRect;
+  return element;
+}
+
+ClipElement ClipElement::MakePath(Path path) {
+  ClipElement element = {};
+  element._type = Type::Path;
+  element._rRect.rect = path.getBounds();
+  element._path = std::move(path);
+  return element;
+}
+
+bool ClipElement::contains(const Rect& rect) const {
+  switch (_type) {
+    case Type::Rect:
+      return _rRect.rect.contains(rect);
+    case Type::RRect:
+      return RRectContainsRect(_rRect, rect);
+    default:
+      // Testing the containment of arbitrary paths is too expensive to be worth it.
+      return false;
+  }
+}
+
+Path ClipElement::asPath() const {
+  if (_type == Type::Path) {
+    return _path;
+  }
+  Path path = {};
+  if (_type == Type::Rect) {
+    path.addRect(_rRect.rect);
+  } else {
+    path.addRRect(_rRect);
+  }
+  return path;
+}
+
+ClipElement ClipElement::makeTransform(const Matrix& matrix) const {
+  if (matrix.isIdentity()) {
+    return *this;
+  }
+  switch (_type) {
+    case Type::Rect:
+      if (matrix.rectStaysRect()) {
+        return MakeRect(matrix.mapRect(_rRect.rect));
+      }
+      break;
+    case Type::RRect:
+      if (matrix.getSkewX() == 0 && matrix.getSkewY() == 0) {
+        RRect rRect = {};
+        rRect.rect = matrix.mapRect(_rRect.rect);
+        rRect.radii = {_rRect.radii.x * std::fabs(matrix.getScaleX()),
+                       _rRect.radii.y * std::fabs(matrix.getScaleY())};
+        return MakeRRect(rRect);
+      }
+      break;
+    default:
+      break;
+  }
+  auto path = asPath();
+  path.transform(matrix);
+  return MakePath(std::move(path));
+}
+
+bool operator==(const ClipElement& a, const ClipElement& b) {
+  if (a._type != b._type) {
+    return false;
+  }
+  switch (a._type) {
+    case ClipElement::Type::Rect:
+      return a._rRect.rect == b._rRect.rect;
+    case ClipElement::Type::RRect:
+      return a._rRect.rect == b._rRect.rect && a._rRect.radii == b._rRect.radii;
+    default:
+      return a._path == b._path;
+  }
+}
+
+ClipStack::Data::Data(const Data& other)
+    : elements(other.elements), bounds(other.bounds), empty(other.empty), bounded(other.bounded) {
+}
+
+void ClipStack::Data::setEmpty() {
+  elements.clear();
+  bounds.setEmpty();
+  empty = true;
+}
+
+void ClipStack::Data::addElement(ClipElement element) {
+  if (element.isInverse()) {
+    if (element.path().isEmpty()) {
+      // An empty inverse-filled path clips nothing out.
+      return;
+    }
+    elements.push_back(std::move(element));
+  } else {
+    auto& elementBounds = element.rect();
+    if (bounded) {
+      if (!bounds.intersect(elementBounds)) {
+        setEmpty();
+        return;
+      }
+    } else if (elementBounds.isEmpty()) {
+      setEmpty();
+      return;
+    } else {
+      bounds = elementBounds;
+      bounded = true;
+    }
+    for (auto& existing : elements) {
+      if (!existing.isInverse() && element.contains(existing.rect())) {
+        // The new element clips nothing more out than the existing one.
+        return;
+      }
+    }
+    elements.erase(std::remove_if(elements.begin(), elements.end(),
+                                  [&](const ClipElement& existing) {
+                                    return existing.contains(element.rect());
+                                  }),
+                   elements.end());
+    if (element.type() == ClipElement::Type::Rect) {
+      for (auto& existing : elements) {
+        if (existing.type() == ClipElement::Type::Rect) {
+          auto rect = existing.rect();
+          rect.intersect(element.rect());
+          existing = ClipElement::MakeRect(rect);
+          return;
+        }
+      }
+    }
+    elements.push_back(std::move(element));
+  }
+  if (elements.size() > MaxElements) {
+    collapse();
+  }
+}
+
+void ClipStack::Data::collapse() {
+  auto path = elements.front().asPath();
+  for (size_t i = 1; i < elements.size(); i++) {
+    path.addPath(elements[i].asPath(), PathOp::Intersect);
+  }
+  elements.clear();
+  if (path.isEmpty() && !path.isInverseFillType()) {
+    setEmpty();
+    return;
+  }
+  auto element = MakeElementFromPath(std::move(path));
+  if (!element.isInverse() && !bounds.intersect(element.rect())) {
+    setEmpty();
+    return;
+  }
+  elements.push_back(std::move(element));
+}
+
+ClipStack::ClipStack() {
+  static const auto WideOpenData = std::make_shared<const Data>();
+  data = WideOpenData;
+}
+
+ClipStack::ClipStack(const Path& path) : ClipStack() {
+  clipPath(path);
+}
+
+bool ClipStack::isRect(Rect* rect) const {
+  auto& elements = data->elements;
+  if (elements.size() != 1 || elements.front().type() != ClipElement::Type::Rect) {
+    return false;
+  }
+  if (rect != nullptr) {
+    *rect = elements.front().rect();
+  }
+  return true;
+}
+
+const Path& ClipStack::getPath() const {
+  std::call_once(data->pathFlag, [this] {
+    auto& path = data->path;
+    if (data->empty) {
+      return;
+    }
+    auto& elements = data->elements;
+    if (elements.empty()) {
+      path.toggleInverseFillType();
+      return;
+    }
+    path = elements.front().asPath();
+    for (size_t i = 1; i < elements.size(); i++) {
+      path.addPath(elements[i].asPath(), PathOp::Intersect);
+    }
+  });
+  return data->path;
+}
+
+bool operator==(const ClipStack& a, const ClipStack& b) {
+  if (a.data == b.data) {
+    return true;
+  }
+  if (a.data->empty || b.data->empty) {
+    return a.data->empty == b.data->empty;
+  }
+  return a.data->elements == b.data->elements;
+}
+
+void ClipStack::clipRect(const Rect& rect, const Matrix& matrix) {
+  addElement(ClipElement::MakeRect(rect).makeTransform(matrix));
+}
+
+void ClipStack::clipRRect(const RRect& rRect, const Matrix& matrix) {
+  addElement(ClipElement::MakeRRect(rRect).makeTransform(matrix));
+}
+
+void ClipStack::clipPath(const Path& path, const Matrix& matrix) {
+  addElement(MakeElementFromPath(path).makeTransform(matrix));
+}
+
+void ClipStack::clip(const ClipStack& other) {
+  if (data->empty || other.isWideOpen()) {
+    return;
+  }
+  if (isWideOpen() || other.data->empty) {
+    data = other.data;
+    return;
+  }
+  auto newData = std::make_shared<Data>(*data);
+  for (auto& element : other.data->elements) {
+    newData->addElement(element);
+    if (newData->empty) {
+      break;
+    }
+  }
+  data = std::move(newData);
+}
+
+void ClipStack::transform(const Matrix& matrix) {
+  if (matrix.isIdentity() || data->elements.empty()) {
+    return;
+  }
+  auto newData = std::make_shared<Data>();
+  for (auto& element : data->elements) {
+    newData->addElement(element.makeTransform(matrix));
+    if (newData->empty) {
+      break;
+    }
+  }
+  data = std::move(newData);
+}
+
+void ClipStack::addElement(ClipElement element) {
+  if (data->empty) {
+    return;
+  }
+  auto newData = std::make_shared<Data>(*data);
+  newData->addElement(std::move(element));
+  data = std::move(newData);
+}
+}  // namespace tgfx
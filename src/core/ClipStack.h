@@ -0,0 +1,232 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "tgfx/core/Matrix.h"
+#include "tgfx/core/Path.h"
+#include "tgfx/core/RRect.h"
+
+namespace tgfx {
+/**
+ * ClipElement is a single device-space geometry of a ClipStack. Rects and round rects are kept
+ * analytically, while everything else is stored as a Path.
+ */
+class ClipElement {
+ public:
+  enum class Type { Rect, RRect, Path };
+
+  static ClipElement MakeRect(const Rect& rect);
+
+  static ClipElement MakeRRect(const RRect& rRect);
+
+  static ClipElement MakePath(Path path);
+
+  Type type() const {
+    return _type;
+  }
+
+  /**
+   * Returns the rect of a Rect element, or the bounds of the other elements.
+   */
+  const Rect& rect() const {
+    return _rRect.rect;
+  }
+
+  /**
+   * Returns the round rect of a RRect element.
+   */
+  const RRect& rRect() const {
+    return _rRect;
+  }
+
+  /**
+   * Returns the path of a Path element.
+   */
+  const Path& path() const {
+    return _path;
+  }
+
+  /**
+   * Returns true if the element is an inverse-filled path, which has no finite bounds.
+   */
+  bool isInverse() const {
+    return _type == Type::Path && _path.isInverseFillType();
+  }
+
+  /**
+   * Returns true if everything inside the given rect is also inside the element.
+   */
+  bool contains(const Rect& rect) const;
+
+  /**
+   * Returns the element as a Path.
+   */
+  Path asPath() const;
+
+  /**
+   * Returns a copy of the element transformed by the given matrix.
+   */
+  ClipElement makeTransform(const Matrix& matrix) const;
+
+  friend bool operator==(const ClipElement& a, const ClipElement& b);
+
+ private:
+  Type _type = Type::Rect;
+  RRect _rRect = {};
+  Path _path = {};
+};
+
+/**
+ * ClipStack holds the intersection of all clips applied to a canvas in device space. Rect clips are
+ * intersected analytically, and round rects and paths are kept as separate elements, so most clip
+ * calls never run path boolean operations. ClipStack is immutable once shared, copying it only
+ * copies a pointer.
+ */
+class ClipStack {
+ public:
+  /**
+   * The maximum number of elements kept in the stack. Once exceeded, the elements are merged into
+   * a single path.
+   */
+  static constexpr size_t MaxElements = 4;
+
+  /**
+   * Creates a wide-open ClipStack.
+   */
+  ClipStack();
+
+  /**
+   * Creates a ClipStack from the given device-space path.
+   */
+  explicit ClipStack(const Path& path);
+
+  /**
+   * Returns true if the clip does not clip anything out.
+   */
+  bool isWideOpen() const {
+    return !data->empty && data->elements.empty();
+  }
+
+  /**
+   * Returns true if the clip clips out everything.
+   */
+  bool isEmpty() const {
+    return data->empty;
+  }
+
+  /**
+   * Returns true if the clip has no finite bounds, which happens if it is wide open or only holds
+   * inverse-filled paths.
+   */
+  bool isUnbounded() const {
+    return !data->empty && !data->bounded;
+  }
+
+  /**
+   * Returns the device-space bounds of the clip. The result is only meaningful if the clip is not
+   * unbounded.
+   */
+  const Rect& getBounds() const {
+    return data->bounds;
+  }
+
+  /**
+   * Returns true if the clip is a single rect, and stores it in the rect parameter if it is not
+   * nullptr.
+   */
+  bool isRect(Rect* rect = nullptr) const;
+
+  /**
+   * Returns the elements of the clip. The clip is their intersection.
+   */
+  const std::vector<ClipElement>& elements() const {
+    return data->elements;
+  }
+
+  /**
+   * Returns the clip as a single Path. The path is computed with boolean operations the first
+   * time it is requested, and then cached.
+   */
+  const Path& getPath() const;
+
+  /**
+   * Returns true if the two clips share the same underlying data, which is much cheaper than
+   * comparing them with operator==.
+   */
+  bool isSame(const ClipStack& other) const {
+    return data == other.data || (isWideOpen() && other.isWideOpen());
+  }
+
+  friend bool operator==(const ClipStack& a, const ClipStack& b);
+
+  friend bool operator!=(const ClipStack& a, const ClipStack& b) {
+    return !(a == b);
+  }
+
+  /**
+   * Intersects the clip with the rect transformed by the matrix.
+   */
+  void clipRect(const Rect& rect, const Matrix& matrix = Matrix::I());
+
+  /**
+   * Intersects the clip with the round rect transformed by the matrix.
+   */
+  void clipRRect(const RRect& rRect, const Matrix& matrix = Matrix::I());
+
+  /**
+   * Intersects the clip with the path transformed by the matrix.
+   */
+  void clipPath(const Path& path, const Matrix& matrix = Matrix::I());
+
+  /**
+   * Intersects the clip with another clip.
+   */
+  void clip(const ClipStack& other);
+
+  /**
+   * Applies the matrix to all elements of the clip.
+   */
+  void transform(const Matrix& matrix);
+
+ private:
+  struct Data {
+    Data() = default;
+
+    Data(const Data& other);
+
+    std::vector<ClipElement> elements = {};
+    Rect bounds = Rect::MakeEmpty();
+    bool empty = false;
+    bool bounded = false;
+    mutable std::once_flag pathFlag = {};
+    mutable Path path = {};
+
+    void setEmpty();
+    void addElement(ClipElement element);
+    void collapse();
+  };
+
+  std::shared_ptr<const Data> data = nullptr;
+
+  void addElement(ClipElement element);
+};
+}  // namespace tgfx
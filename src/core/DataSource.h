@@ -45,13 +45,14 @@ class DataSource {
 
   /**
    * Wraps the existing data source into an asynchronous DataSource and starts loading the data
-	 * immediately.
+	 * immediately with the given priority.
    */
-  static std::unique_ptr<DataSource> Async(std::unique_ptr<DataSource> source) {
+  static std::unique_ptr<DataSource> Async(std::unique_ptr<DataSource> source,
+                                           TaskPriority priority = TaskPriority::Default) {
     if (source == nullptr) {
       return nullptr;
     }
-    return std::make_unique<AsyncDataSource<T>>(std::move(source));
+    return std::make_unique<AsyncDataSource<T>>(std::move(source), priority);
   }
 
   virtual ~DataSource() = default;
@@ -110,9 +111,10 @@ class DataTask : public Task {
 template <typename T>
 class AsyncDataSource : public DataSource<T> {
  public:
-  explicit AsyncDataSource(std::unique_ptr<DataSource<T>> source) {
+  explicit AsyncDataSource(std::unique_ptr<DataSource<T>> source,
+                           TaskPriority priority = TaskPriority::Default) {
     task = std::make_shared<DataTask<T>>(std::move(source));
-    Task::Run(task);
+    Task::Run(task, priority);
   }
 
   ~AsyncDataSource() override {
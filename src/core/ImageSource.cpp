@@ -20,7 +20,8 @@
 
 namespace tgfx {
 std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeFrom(
-    std::shared_ptr<ImageGenerator> generator, bool tryHardware, bool asyncDecoding) {
+    std::shared_ptr<ImageGenerator> generator, bool tryHardware, bool asyncDecoding,
+    TaskPriority priority) {
   if (generator == nullptr) {
     return nullptr;
   }
@@ -32,7 +33,7 @@ std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeFrom(
   }
   auto imageSource = std::make_unique<ImageSource>(std::move(generator), tryHardware);
   if (asyncDecoding) {
-    return Async(std::move(imageSource));
+    return Async(std::move(imageSource), priority);
   }
   return imageSource;
 }
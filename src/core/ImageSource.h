@@ -29,11 +29,13 @@ class ImageSource : public DataSource<ImageBuffer> {
  public:
   /**
    * Create an image source from the specified ImageGenerator. If asyncDecoding is true, the
-   * returned image source schedules an asynchronous image-decoding task immediately. Otherwise, the
-   * image will be decoded synchronously when the getData() method is called.
+   * returned image source schedules an asynchronous image-decoding task with the given priority
+   * immediately. Otherwise, the image will be decoded synchronously when the getData() method is
+   * called.
    */
   static std::unique_ptr<DataSource> MakeFrom(std::shared_ptr<ImageGenerator> generator,
-                                              bool tryHardware = true, bool asyncDecoding = true);
+                                              bool tryHardware = true, bool asyncDecoding = true,
+                                              TaskPriority priority = TaskPriority::Default);
 
   ImageSource(std::shared_ptr<ImageGenerator> generator, bool tryHardware);
 
@@ -87,5 +87,6 @@ class ImageStream {
   void detachFromStream(ImageReader* imageReader);
 
   friend class ImageReader;
+  friend class GlyphAtlas;
 };
 }  // namespace tgfx
@@ -18,28 +18,25 @@
 
 #pragma once
 
+#include "core/ClipStack.h"
 #include "tgfx/core/Matrix.h"
 #include "tgfx/core/Paint.h"
-#include "tgfx/core/Path.h"
 
 namespace tgfx {
 class MCState {
  public:
   explicit MCState(const Matrix& matrix) : matrix(matrix) {
-    clip.toggleInverseFillType();
   }
 
-  explicit MCState(Path initClip) : clip(std::move(initClip)) {
+  explicit MCState(ClipStack initClip) : clip(std::move(initClip)) {
   }
 
-  MCState(const Matrix& matrix, Path clip) : matrix(matrix), clip(std::move(clip)) {
+  MCState(const Matrix& matrix, ClipStack clip) : matrix(matrix), clip(std::move(clip)) {
   }
 
-  MCState() {
-    clip.toggleInverseFillType();
-  }
+  MCState() = default;
 
   Matrix matrix = Matrix::I();
-  Path clip = {};
+  ClipStack clip = {};
 };
 }  // namespace tgfx
@@ -82,18 +82,15 @@ void MeasureContext::addLocalBounds(const MCState& state, const Fill& fill, cons
   addDeviceBounds(state.clip, fill, deviceBounds, unbounded);
 }
 
-void MeasureContext::addDeviceBounds(const Path& clip, const Fill& fill, const Rect& deviceBounds,
-                                     bool unbounded) {
-  if (fill.nothingToDraw()) {
+void MeasureContext::addDeviceBounds(const ClipStack& clip, const Fill& fill,
+                                     const Rect& deviceBounds, bool unbounded) {
+  if (fill.nothingToDraw() || clip.isEmpty()) {
     return;
   }
-  if (clip.isInverseFillType()) {
+  if (clip.isUnbounded()) {
     bounds.join(deviceBounds);
     return;
   }
-  if (clip.isEmpty()) {
-    return;
-  }
   auto intersectBounds = clip.getBounds();
   if (!unbounded && !intersectBounds.intersect(deviceBounds)) {
     return;
@@ -55,7 +55,7 @@ class MeasureContext : public DrawContext {
 
   void addLocalBounds(const MCState& state, const Fill& fill, const Rect& localBounds,
                       bool unbounded = false);
-  void addDeviceBounds(const Path& clip, const Fill& fill, const Rect& deviceBounds,
+  void addDeviceBounds(const ClipStack& clip, const Fill& fill, const Rect& deviceBounds,
                        bool unbounded = false);
 };
 }  // namespace tgfx
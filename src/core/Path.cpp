@@ -559,6 +559,8 @@ PathRef* Path::writableRef() {
   } else {
     pathRef->uniqueKey.reset();
     pathRef->resetBounds();
+    pathRef->contentHash = 0;
+    pathRef->contentKey = {};
   }
   return pathRef.get();
 }
@@ -17,6 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PathRef.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "tgfx/core/Path.h"
 
 namespace tgfx {
@@ -34,6 +39,67 @@ UniqueKey PathRef::GetUniqueKey(const Path& path) {
   return path.pathRef->uniqueKey.get();
 }
 
+/**
+ * ContentKeyEntry remembers the geometry a content key was issued for, so that paths whose content
+ * hashes collide are told apart by a full comparison instead of sharing cached resources.
+ */
+struct ContentKeyEntry {
+  SkPath path = {};
+  UniqueKey key = {};
+};
+
+/**
+ * Entries are swept once their count reaches this threshold, which then grows with the number of
+ * live entries.
+ */
+static constexpr size_t MinContentKeySweepCount = 64;
+
+static std::mutex contentKeyLocker = {};
+static std::unordered_map<uint64_t, std::vector<ContentKeyEntry>> contentKeyMap = {};
+static size_t contentKeyCount = 0;
+static size_t contentKeySweepCount = MinContentKeySweepCount;
+
+/**
+ * Removes the entries whose keys are only referenced by the map, which means that neither a path
+ * nor a cached resource uses them anymore.
+ */
+static void SweepContentKeys() {
+  for (auto result = contentKeyMap.begin(); result != contentKeyMap.end();) {
+    auto& entries = result->second;
+    auto end = std::remove_if(entries.begin(), entries.end(), [](const ContentKeyEntry& entry) {
+      return entry.key.useCount() == 1;
+    });
+    contentKeyCount -= static_cast<size_t>(entries.end() - end);
+    entries.erase(end, entries.end());
+    result = entries.empty() ? contentKeyMap.erase(result) : std::next(result);
+  }
+  contentKeySweepCount = std::max(MinContentKeySweepCount, contentKeyCount * 2);
+}
+
+UniqueKey PathRef::GetContentKey(const Path& path) {
+  auto pathRef = path.pathRef.get();
+  auto hash = pathRef->getContentHash();
+  std::lock_guard<std::mutex> autoLock(contentKeyLocker);
+  if (!pathRef->contentKey.empty()) {
+    return pathRef->contentKey;
+  }
+  auto& entries = contentKeyMap[hash];
+  for (auto& entry : entries) {
+    if (entry.path == pathRef->path) {
+      pathRef->contentKey = entry.key;
+      return entry.key;
+    }
+  }
+  // The path is copied by reference to its immutable geometry, which is cheap and keeps the
+  // comparison valid even if the original path is modified later.
+  entries.push_back({pathRef->path, UniqueKey::Make()});
+  pathRef->contentKey = entries.back().key;
+  if (++contentKeyCount >= contentKeySweepCount) {
+    SweepContentKeys();
+  }
+  return pathRef->contentKey;
+}
+
 PathRef::~PathRef() {
   resetBounds();
 }
@@ -63,4 +129,67 @@ void PathRef::resetBounds() {
   auto oldBounds = bounds.exchange(nullptr, std::memory_order_acq_rel);
   delete oldBounds;
 }
+
+static void HashValue(uint64_t* hash, uint32_t value) {
+  *hash ^= value;
+  *hash *= 0x9E3779B97F4A7C15ull;
+  *hash ^= *hash >> 32;
+}
+
+static void HashPoints(uint64_t* hash, const SkPoint* points, int count) {
+  for (int i = 0; i < count; i++) {
+    uint32_t values[2] = {};
+    memcpy(values, &points[i], sizeof(values));
+    HashValue(hash, values[0]);
+    HashValue(hash, values[1]);
+  }
+}
+
+uint64_t PathRef::getContentHash() {
+  auto cacheHash = contentHash.load(std::memory_order_relaxed);
+  if (cacheHash != 0) {
+    return cacheHash;
+  }
+  // Use the iterator instead of reading the verb and point arrays directly to pick up the conic
+  // weights as well. The iterator is also thread-safe, as it doesn't touch any lazy state of
+  // SkPath.
+  uint64_t hash = 0xCBF29CE484222325ull;
+  HashValue(&hash, static_cast<uint32_t>(path.getFillType()));
+  SkPath::Iter iter(path, false);
+  SkPoint points[4];
+  SkPath::Verb verb;
+  while ((verb = iter.next(points)) != SkPath::kDone_Verb) {
+    HashValue(&hash, static_cast<uint32_t>(verb));
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        HashPoints(&hash, points, 1);
+        break;
+      case SkPath::kLine_Verb:
+        HashPoints(&hash, points + 1, 1);
+        break;
+      case SkPath::kQuad_Verb:
+        HashPoints(&hash, points + 1, 2);
+        break;
+      case SkPath::kConic_Verb: {
+        HashPoints(&hash, points + 1, 2);
+        auto weight = iter.conicWeight();
+        uint32_t value = 0;
+        memcpy(&value, &weight, sizeof(value));
+        HashValue(&hash, value);
+        break;
+      }
+      case SkPath::kCubic_Verb:
+        HashPoints(&hash, points + 1, 3);
+        break;
+      default:
+        break;
+    }
+  }
+  if (hash == 0) {
+    // Zero is reserved for the uncomputed state.
+    hash = 1;
+  }
+  contentHash.store(hash, std::memory_order_relaxed);
+  return hash;
+}
 }  // namespace tgfx
\ No newline at end of file
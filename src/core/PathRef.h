@@ -33,6 +33,15 @@ class PathRef {
 
   static UniqueKey GetUniqueKey(const Path& path);
 
+  /**
+   * Returns a UniqueKey shared by all paths with identical verbs, points, conic weights and fill
+   * type. Unlike GetUniqueKey(), paths that are built separately but have identical contents share
+   * the same key, which allows cached GPU resources to be reused across re-created paths. Paths are
+   * looked up by a content hash and then compared in full, so different paths never share a key
+   * even if their hashes collide. The key is cached on the PathRef after the first lookup.
+   */
+  static UniqueKey GetContentKey(const Path& path);
+
   PathRef() = default;
 
   explicit PathRef(const pk::SkPath& path) : path(path) {
@@ -45,10 +54,15 @@ class PathRef {
  private:
   LazyUniqueKey uniqueKey = {};
   std::atomic<Rect*> bounds = {nullptr};
+  std::atomic<uint64_t> contentHash = {0};
+  // Guarded by the lock of the content key map.
+  UniqueKey contentKey = {};
   pk::SkPath path = {};
 
   void resetBounds();
 
+  uint64_t getContentHash();
+
   friend bool operator==(const Path& a, const Path& b);
   friend bool operator!=(const Path& a, const Path& b);
   friend class Path;
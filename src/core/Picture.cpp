@@ -18,24 +18,27 @@
 
 #include "tgfx/core/Picture.h"
 #include "core/MeasureContext.h"
-#include "core/Records.h"
+#include "core/PictureRecords.h"
 #include "core/TransformContext.h"
 #include "core/utils/Log.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Surface.h"
 
 namespace tgfx {
-Picture::Picture(std::vector<Record*> records, bool hasUnboundedFill)
+Picture::Picture(std::unique_ptr<PictureRecords> records, bool hasUnboundedFill)
     : records(std::move(records)), _hasUnboundedFill(hasUnboundedFill) {
 }
 
-Picture::~Picture() {
-  for (auto& record : records) {
-    delete record;
-  }
-}
+Picture::~Picture() = default;
 
 Rect Picture::getBounds(const Matrix* matrix) const {
+  auto& bounds = records->bounds();
+  if (matrix == nullptr || matrix->isIdentity() || bounds.isEmpty()) {
+    return bounds;
+  }
+  if (matrix->rectStaysRect() && !records->hasScaleDependentBounds()) {
+    return matrix->mapRect(bounds);
+  }
   MeasureContext context = {};
   MCState state(matrix ? *matrix : Matrix::I());
   playback(&context, state);
@@ -49,26 +52,50 @@ void Picture::playback(Canvas* canvas) const {
   playback(canvas->drawContext, *canvas->mcState);
 }
 
-void Picture::playback(DrawContext* drawContext, const MCState& state) const {
+static bool GetLocalCullRect(const MCState& state, const Rect* cullRect, Rect* localCullRect) {
+  Rect deviceRect = {};
+  if (!state.clip.isUnbounded()) {
+    deviceRect = state.clip.getBounds();
+    if (cullRect != nullptr && !deviceRect.intersect(*cullRect)) {
+      localCullRect->setEmpty();
+      return true;
+    }
+  } else if (cullRect != nullptr) {
+    deviceRect = *cullRect;
+  } else {
+    return false;
+  }
+  Matrix invertMatrix = {};
+  if (!state.matrix.invert(&invertMatrix)) {
+    return false;
+  }
+  // The record bounds are measured with an identity matrix. Outset by a pixel to cover the
+  // antialiasing and the hairlines or glyphs whose bounds change slightly with the scale.
+  deviceRect.outset(1.0f, 1.0f);
+  *localCullRect = invertMatrix.mapRect(deviceRect);
+  return true;
+}
+
+void Picture::playback(DrawContext* drawContext, const MCState& state, const Rect* cullRect) const {
   DEBUG_ASSERT(drawContext != nullptr);
   auto transformContext = TransformContext::Make(drawContext, state.matrix, state.clip);
   if (transformContext) {
     drawContext = transformContext.get();
-  } else if (state.clip.isEmpty() && !state.clip.isInverseFillType()) {
+  } else if (state.clip.isEmpty()) {
     return;
   }
-  for (auto& record : records) {
-    record->playback(drawContext);
+  Rect localCullRect = {};
+  if (GetLocalCullRect(state, cullRect, &localCullRect)) {
+    records->playback(drawContext, &localCullRect);
+  } else {
+    records->playback(drawContext);
   }
 }
 
-static bool GetClipRect(const Path& clip, const Matrix* matrix, Rect* clipRect) {
-  if (clip.isInverseFillType()) {
-    if (clip.isEmpty()) {
-      clipRect->setEmpty();
-      return true;
-    }
-    return false;
+static bool GetClipRect(const ClipStack& clip, const Matrix* matrix, Rect* clipRect) {
+  if (clip.isWideOpen()) {
+    clipRect->setEmpty();
+    return true;
   }
   Rect rect = {};
   if (!clip.isRect(&rect)) {
@@ -86,10 +113,10 @@ static bool GetClipRect(const Path& clip, const Matrix* matrix, Rect* clipRect)
 
 std::shared_ptr<Image> Picture::asImage(Point* offset, const Matrix* matrix,
                                         const ISize* clipSize) const {
-  if (records.size() != 1) {
+  if (records->size() != 1) {
     return nullptr;
   }
-  auto record = records[0];
+  auto record = (*records)[0];
   if (record->type() != RecordType::DrawImage && record->type() != RecordType::DrawImageRect) {
     return nullptr;
   }
@@ -104,7 +131,7 @@ std::shared_ptr<Image> Picture::asImage(Point* offset, const Matrix* matrix,
       return nullptr;
     }
   }
-  auto imageMatrix = imageRecord->state.matrix;
+  auto imageMatrix = records->matrix(record);
   if (matrix) {
     imageMatrix.postConcat(*matrix);
   }
@@ -112,7 +139,7 @@ std::shared_ptr<Image> Picture::asImage(Point* offset, const Matrix* matrix,
     return nullptr;
   }
   auto clipRect = Rect::MakeEmpty();
-  if (!GetClipRect(imageRecord->state.clip, matrix, &clipRect)) {
+  if (!GetClipRect(records->clip(record), matrix, &clipRect)) {
     return nullptr;
   }
   auto subset = Rect::MakeEmpty();
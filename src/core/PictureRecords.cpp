@@ -0,0 +1,256 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PictureRecords.h"
+#include <algorithm>
+#include "core/MeasureContext.h"
+
+namespace tgfx {
+// Pictures with fewer records are culled by testing the bounds of each record directly.
+static constexpr size_t MinRecordsForRTree = 64;
+
+// The records don't have virtual destructors, so each one is destroyed as its concrete type.
+static void DestroyRecord(Record* record) {
+  switch (record->type()) {
+    case RecordType::DrawFill:
+      static_cast<DrawFill*>(record)->~DrawFill();
+      break;
+    case RecordType::DrawRect:
+      static_cast<DrawRect*>(record)->~DrawRect();
+      break;
+    case RecordType::DrawRRect:
+      static_cast<DrawRRect*>(record)->~DrawRRect();
+      break;
+    case RecordType::DrawShape:
+      static_cast<DrawShape*>(record)->~DrawShape();
+      break;
+    case RecordType::DrawImage:
+      static_cast<DrawImage*>(record)->~DrawImage();
+      break;
+    case RecordType::DrawImageRect:
+      static_cast<DrawImageRect*>(record)->~DrawImageRect();
+      break;
+    case RecordType::DrawGlyphRunList:
+      static_cast<DrawGlyphRunList*>(record)->~DrawGlyphRunList();
+      break;
+    case RecordType::StrokeGlyphRunList:
+      static_cast<StrokeGlyphRunList*>(record)->~StrokeGlyphRunList();
+      break;
+    case RecordType::DrawPicture:
+      static_cast<DrawPicture*>(record)->~DrawPicture();
+      break;
+    case RecordType::DrawLayer:
+      static_cast<DrawLayer*>(record)->~DrawLayer();
+      break;
+  }
+}
+
+PictureRecords::~PictureRecords() {
+  for (auto& record : records) {
+    DestroyRecord(record);
+  }
+}
+
+void PictureRecords::finish() {
+  recordBounds.clear();
+  recordBounds.reserve(records.size());
+  unboundedRecords.clear();
+  _bounds.setEmpty();
+  _hasScaleDependentBounds = false;
+  PlaybackState playbackState = {};
+  for (size_t i = 0; i < records.size(); i++) {
+    auto record = records[i];
+    MeasureContext context = {};
+    PlaybackRecord(record, updateState(record, &playbackState), &context);
+    auto bounds = context.getBounds();
+    _bounds.join(bounds);
+    if (isUnbounded(record)) {
+      unboundedRecords.push_back(static_cast<uint32_t>(i));
+      bounds.setEmpty();
+    }
+    recordBounds.push_back(bounds);
+    switch (record->type()) {
+      case RecordType::DrawShape:
+      case RecordType::DrawGlyphRunList:
+      case RecordType::StrokeGlyphRunList:
+      case RecordType::DrawPicture:
+      case RecordType::DrawLayer:
+        _hasScaleDependentBounds = true;
+        break;
+      default:
+        break;
+    }
+  }
+  rTree = nullptr;
+  if (records.size() >= MinRecordsForRTree) {
+    rTree = std::make_unique<RTree>(recordBounds);
+  }
+}
+
+void PictureRecords::playback(DrawContext* context, const Rect* cullRect) const {
+  PlaybackState playbackState = {};
+  if (cullRect == nullptr || cullRect->contains(_bounds)) {
+    for (auto& record : records) {
+      PlaybackRecord(record, updateState(record, &playbackState), context);
+    }
+    return;
+  }
+  std::vector<uint32_t> indices = {};
+  if (rTree != nullptr) {
+    rTree->search(*cullRect, &indices);
+  } else {
+    for (size_t i = 0; i < recordBounds.size(); i++) {
+      if (Rect::Intersects(recordBounds[i], *cullRect)) {
+        indices.push_back(static_cast<uint32_t>(i));
+      }
+    }
+  }
+  if (!unboundedRecords.empty()) {
+    auto middle = static_cast<std::ptrdiff_t>(indices.size());
+    indices.insert(indices.end(), unboundedRecords.begin(), unboundedRecords.end());
+    std::inplace_merge(indices.begin(), indices.begin() + middle, indices.end());
+  }
+  for (auto index : indices) {
+    auto record = records[index];
+    PlaybackRecord(record, updateState(record, &playbackState), context);
+  }
+}
+
+const MCState& PictureRecords::updateState(const Record* record,
+                                           PlaybackState* playbackState) const {
+  // Rebuild the state only when a record switches to another matrix or clip.
+  if (record->matrixIndex != playbackState->matrixIndex) {
+    playbackState->matrixIndex = record->matrixIndex;
+    playbackState->state.matrix = matrices[record->matrixIndex];
+  }
+  if (record->clipIndex != playbackState->clipIndex) {
+    playbackState->clipIndex = record->clipIndex;
+    playbackState->state.clip = clips[record->clipIndex];
+  }
+  return playbackState->state;
+}
+
+void PictureRecords::PlaybackRecord(const Record* record, const MCState& state,
+                                    DrawContext* context) {
+  switch (record->type()) {
+    case RecordType::DrawFill:
+      context->drawFill(state, static_cast<const DrawFill*>(record)->fill);
+      break;
+    case RecordType::DrawRect: {
+      auto drawRect = static_cast<const DrawRect*>(record);
+      context->drawRect(drawRect->rect, state, drawRect->fill);
+      break;
+    }
+    case RecordType::DrawRRect: {
+      auto drawRRect = static_cast<const DrawRRect*>(record);
+      context->drawRRect(drawRRect->rRect, state, drawRRect->fill);
+      break;
+    }
+    case RecordType::DrawShape: {
+      auto drawShape = static_cast<const DrawShape*>(record);
+      context->drawShape(drawShape->shape, state, drawShape->fill);
+      break;
+    }
+    case RecordType::DrawImage: {
+      auto drawImage = static_cast<const DrawImage*>(record);
+      context->drawImage(drawImage->image, drawImage->sampling, state, drawImage->fill);
+      break;
+    }
+    case RecordType::DrawImageRect: {
+      auto drawImageRect = static_cast<const DrawImageRect*>(record);
+      context->drawImageRect(drawImageRect->image, drawImageRect->rect, drawImageRect->sampling,
+                             state, drawImageRect->fill);
+      break;
+    }
+    case RecordType::DrawGlyphRunList: {
+      auto drawGlyphRunList = static_cast<const DrawGlyphRunList*>(record);
+      context->drawGlyphRunList(drawGlyphRunList->glyphRunList, state, drawGlyphRunList->fill,
+                                nullptr);
+      break;
+    }
+    case RecordType::StrokeGlyphRunList: {
+      auto strokeGlyphRunList = static_cast<const StrokeGlyphRunList*>(record);
+      context->drawGlyphRunList(strokeGlyphRunList->glyphRunList, state,
+                                strokeGlyphRunList->fill, &strokeGlyphRunList->stroke);
+      break;
+    }
+    case RecordType::DrawPicture:
+      context->drawPicture(static_cast<const DrawPicture*>(record)->picture, state);
+      break;
+    case RecordType::DrawLayer: {
+      auto drawLayer = static_cast<const DrawLayer*>(record);
+      context->drawLayer(drawLayer->picture, drawLayer->filter, state, drawLayer->fill);
+      break;
+    }
+  }
+}
+
+bool PictureRecords::isUnbounded(const Record* record) const {
+  if (!clip(record).isUnbounded()) {
+    return false;
+  }
+  switch (record->type()) {
+    case RecordType::DrawFill:
+      return true;
+    case RecordType::DrawShape:
+      return static_cast<const DrawShape*>(record)->shape->isInverseFillType();
+    case RecordType::DrawPicture:
+      return static_cast<const DrawPicture*>(record)->picture->hasUnboundedFill();
+    case RecordType::DrawLayer:
+      return static_cast<const DrawLayer*>(record)->picture->hasUnboundedFill();
+    default:
+      return false;
+  }
+}
+
+void PictureRecords::clear() {
+  for (auto& record : records) {
+    DestroyRecord(record);
+  }
+  records.clear();
+  matrices.clear();
+  clips.clear();
+  recordBounds.clear();
+  unboundedRecords.clear();
+  rTree = nullptr;
+  _bounds.setEmpty();
+  _hasScaleDependentBounds = false;
+  allocator.clear();
+}
+
+size_t PictureRecords::memoryUsage() const {
+  return allocator.memoryUsage() + records.capacity() * sizeof(Record*) +
+         matrices.capacity() * sizeof(Matrix) + clips.capacity() * sizeof(ClipStack) +
+         recordBounds.capacity() * sizeof(Rect) + unboundedRecords.capacity() * sizeof(uint32_t) +
+         (rTree ? rTree->memoryUsage() : 0);
+}
+
+uint32_t PictureRecords::addMatrix(const Matrix& matrix) {
+  if (matrices.empty() || matrices.back() != matrix) {
+    matrices.push_back(matrix);
+  }
+  return static_cast<uint32_t>(matrices.size() - 1);
+}
+
+uint32_t PictureRecords::addClip(const ClipStack& clip) {
+  if (clips.empty() || clips.back() != clip) {
+    clips.push_back(clip);
+  }
+  return static_cast<uint32_t>(clips.size() - 1);
+}
+}  // namespace tgfx
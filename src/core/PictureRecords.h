@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/RTree.h"
+#include "core/Records.h"
+#include "core/utils/BlockAllocator.h"
+
+namespace tgfx {
+/**
+ * PictureRecords stores the records of a Picture back to back in a BlockAllocator instead of
+ * allocating each one on the heap. The matrices and clips of the records are de-duplicated into
+ * side tables, since consecutive draws usually share them. Once the recording is finished, the
+ * bounds of each record are computed, so the records outside the clip can be skipped at playback.
+ */
+class PictureRecords {
+ public:
+  PictureRecords() = default;
+
+  ~PictureRecords();
+
+  PictureRecords(const PictureRecords&) = delete;
+
+  PictureRecords& operator=(const PictureRecords&) = delete;
+
+  PictureRecords(PictureRecords&&) = default;
+
+  size_t size() const {
+    return records.size();
+  }
+
+  bool empty() const {
+    return records.empty();
+  }
+
+  const Record* operator[](size_t index) const {
+    return records[index];
+  }
+
+  std::vector<Record*>::const_iterator begin() const {
+    return records.begin();
+  }
+
+  std::vector<Record*>::const_iterator end() const {
+    return records.end();
+  }
+
+  /**
+   * Returns the matrix the given record was drawn with.
+   */
+  const Matrix& matrix(const Record* record) const {
+    return matrices[record->matrixIndex];
+  }
+
+  /**
+   * Returns the clip the given record was drawn with.
+   */
+  const ClipStack& clip(const Record* record) const {
+    return clips[record->clipIndex];
+  }
+
+  /**
+   * Constructs a record of type T at the end of the list, drawn with the given state.
+   */
+  template <typename T, typename... Args>
+  void append(const MCState& state, Args&&... args) {
+    auto record = allocator.make<T>(std::forward<Args>(args)...);
+    record->matrixIndex = addMatrix(state.matrix);
+    record->clipIndex = addClip(state.clip);
+    records.push_back(record);
+  }
+
+  /**
+   * Computes the bounds of each record and the total bounds, and builds an RTree over them if there
+   * are enough records. Called once after the last record is appended.
+   */
+  void finish();
+
+  /**
+   * Returns the combined bounds of all records, as measured by a MeasureContext with an identity
+   * matrix.
+   */
+  const Rect& bounds() const {
+    return _bounds;
+  }
+
+  /**
+   * Returns true if any record fills an unbounded area, which is never skipped at playback.
+   */
+  bool hasUnboundedFill() const {
+    return !unboundedRecords.empty();
+  }
+
+  /**
+   * Returns true if any record has bounds that depend on the scale of the drawing matrix, such as
+   * shapes and glyphs. The bounds of such records can't be mapped to another matrix directly.
+   */
+  bool hasScaleDependentBounds() const {
+    return _hasScaleDependentBounds;
+  }
+
+  /**
+   * Replays the records to the given context. If cullRect is not nullptr, the records whose bounds
+   * don't intersect it are skipped.
+   */
+  void playback(DrawContext* context, const Rect* cullRect = nullptr) const;
+
+  /**
+   * Removes all records.
+   */
+  void clear();
+
+  /**
+   * Returns the number of bytes used by the records and the side tables, not counting the objects
+   * they share with others, such as images and shapes.
+   */
+  size_t memoryUsage() const;
+
+ private:
+  BlockAllocator allocator = {};
+  std::vector<Record*> records = {};
+  std::vector<Matrix> matrices = {};
+  std::vector<ClipStack> clips = {};
+  // The bounds of each record. They are empty for the records in unboundedRecords.
+  std::vector<Rect> recordBounds = {};
+  std::vector<uint32_t> unboundedRecords = {};
+  std::unique_ptr<RTree> rTree = nullptr;
+  Rect _bounds = Rect::MakeEmpty();
+  bool _hasScaleDependentBounds = false;
+
+  struct PlaybackState {
+    MCState state = {};
+    uint32_t matrixIndex = UINT32_MAX;
+    uint32_t clipIndex = UINT32_MAX;
+  };
+
+  static void PlaybackRecord(const Record* record, const MCState& state, DrawContext* context);
+
+  const MCState& updateState(const Record* record, PlaybackState* playbackState) const;
+  bool isUnbounded(const Record* record) const;
+
+  uint32_t addMatrix(const Matrix& matrix);
+  uint32_t addClip(const ClipStack& clip);
+};
+}  // namespace tgfx
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tgfx {
+static constexpr size_t MaxChildren = 8;
+
+/**
+ * Sorts the items into runs of MaxChildren neighbours: the items are sorted into vertical slices
+ * by their centers along the x axis, and then each slice is sorted along the y axis.
+ */
+template <typename T>
+static void SortTileRecursive(std::vector<T>* items) {
+  auto groupCount = (items->size() + MaxChildren - 1) / MaxChildren;
+  auto sliceCount = static_cast<size_t>(ceil(sqrt(static_cast<double>(groupCount))));
+  auto sliceSize = sliceCount * MaxChildren;
+  std::sort(items->begin(), items->end(), [](const T& a, const T& b) {
+    return a.bounds.centerX() < b.bounds.centerX();
+  });
+  for (size_t start = 0; start < items->size(); start += sliceSize) {
+    auto end = std::min(start + sliceSize, items->size());
+    std::sort(items->begin() + static_cast<std::ptrdiff_t>(start),
+              items->begin() + static_cast<std::ptrdiff_t>(end), [](const T& a, const T& b) {
+                return a.bounds.centerY() < b.bounds.centerY();
+              });
+  }
+}
+
+RTree::RTree(const std::vector<Rect>& rects) {
+  for (size_t i = 0; i < rects.size(); i++) {
+    if (!rects[i].isEmpty()) {
+      entries.push_back({rects[i], static_cast<uint32_t>(i)});
+    }
+  }
+  if (entries.empty()) {
+    return;
+  }
+  SortTileRecursive(&entries);
+  std::vector<Node> level = {};
+  for (size_t start = 0; start < entries.size(); start += MaxChildren) {
+    auto end = std::min(start + MaxChildren, entries.size());
+    Node node = {};
+    node.firstChild = static_cast<uint32_t>(start);
+    node.childCount = static_cast<uint32_t>(end - start);
+    for (auto i = start; i < end; i++) {
+      node.bounds.join(entries[i].bounds);
+    }
+    level.push_back(node);
+  }
+  // Each level is appended to the nodes in sorted order, so the children of every parent node are
+  // contiguous. The root ends up as the last node.
+  while (true) {
+    if (level.size() > 1) {
+      SortTileRecursive(&level);
+    }
+    auto levelStart = nodes.size();
+    nodes.insert(nodes.end(), level.begin(), level.end());
+    if (level.size() == 1) {
+      break;
+    }
+    std::vector<Node> parents = {};
+    for (size_t start = 0; start < level.size(); start += MaxChildren) {
+      auto end = std::min(start + MaxChildren, level.size());
+      Node node = {};
+      node.firstChild = static_cast<uint32_t>(levelStart + start);
+      node.childCount = static_cast<uint32_t>(end - start);
+      node.isLeaf = false;
+      for (auto i = start; i < end; i++) {
+        node.bounds.join(level[i].bounds);
+      }
+      parents.push_back(node);
+    }
+    level = std::move(parents);
+  }
+}
+
+void RTree::search(const Rect& query, std::vector<uint32_t>* results) const {
+  if (nodes.empty() || !Rect::Intersects(nodes.back().bounds, query)) {
+    return;
+  }
+  auto firstResult = results->size();
+  std::vector<const Node*> stack = {&nodes.back()};
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    auto end = node->firstChild + node->childCount;
+    for (auto i = node->firstChild; i < end; i++) {
+      if (node->isLeaf) {
+        if (Rect::Intersects(entries[i].bounds, query)) {
+          results->push_back(entries[i].index);
+        }
+      } else if (Rect::Intersects(nodes[i].bounds, query)) {
+        stack.push_back(&nodes[i]);
+      }
+    }
+  }
+  std::sort(results->begin() + static_cast<std::ptrdiff_t>(firstResult), results->end());
+}
+
+size_t RTree::memoryUsage() const {
+  return entries.capacity() * sizeof(Entry) + nodes.capacity() * sizeof(Node);
+}
+}  // namespace tgfx
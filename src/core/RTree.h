@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+/**
+ * RTree is a bounding volume hierarchy over a fixed list of rects, bulk loaded once with the
+ * sort-tile-recursive algorithm. It finds the rects that intersect a query rect without testing
+ * each one of them.
+ */
+class RTree {
+ public:
+  /**
+   * Builds an RTree over the given rects. Empty rects are left out, since they never intersect
+   * anything.
+   */
+  explicit RTree(const std::vector<Rect>& rects);
+
+  /**
+   * Appends the indices of the rects intersecting the query rect to the results, in ascending
+   * order.
+   */
+  void search(const Rect& query, std::vector<uint32_t>* results) const;
+
+  /**
+   * Returns the number of bytes used by the tree.
+   */
+  size_t memoryUsage() const;
+
+ private:
+  struct Entry {
+    Rect bounds = Rect::MakeEmpty();
+    uint32_t index = 0;
+  };
+
+  struct Node {
+    Rect bounds = Rect::MakeEmpty();
+    // The range of the children, in entries for leaf nodes and in nodes for the others.
+    uint32_t firstChild = 0;
+    uint32_t childCount = 0;
+    bool isLeaf = true;
+  };
+
+  std::vector<Entry> entries = {};
+  std::vector<Node> nodes = {};
+};
+}  // namespace tgfx
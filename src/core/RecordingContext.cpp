@@ -32,92 +32,61 @@ std::shared_ptr<Picture> RecordingContext::finishRecordingAsPicture() {
   if (records.empty()) {
     return nullptr;
   }
-  bool hasUnboundedFill = false;
-  for (auto& record : records) {
-    if (!record->state.clip.isInverseFillType()) {
-      continue;
-    }
-    switch (record->type()) {
-      case RecordType::DrawFill:
-        hasUnboundedFill = true;
-        break;
-      case RecordType::DrawShape:
-        if (static_cast<DrawShape*>(record)->shape->isInverseFillType()) {
-          hasUnboundedFill = true;
-        }
-        break;
-      case RecordType::DrawPicture:
-        if (static_cast<DrawPicture*>(record)->picture->hasUnboundedFill()) {
-          hasUnboundedFill = true;
-        }
-        break;
-      case RecordType::DrawLayer:
-        if (static_cast<DrawLayer*>(record)->picture->hasUnboundedFill()) {
-          hasUnboundedFill = true;
-        }
-        break;
-      default:
-        break;
-    }
-    if (hasUnboundedFill) {
-      break;
-    }
-  }
-  return std::shared_ptr<Picture>(new Picture(std::move(records), hasUnboundedFill));
+  records.finish();
+  auto hasUnboundedFill = records.hasUnboundedFill();
+  auto pictureRecords = std::make_unique<PictureRecords>(std::move(records));
+  return std::shared_ptr<Picture>(new Picture(std::move(pictureRecords), hasUnboundedFill));
 }
 
 void RecordingContext::clear() {
-  for (auto& record : records) {
-    delete record;
-  }
   records.clear();
 }
 
 void RecordingContext::drawFill(const MCState& state, const Fill& fill) {
-  if (state.clip.isInverseFillType() && state.clip.isEmpty() && fill.isOpaque()) {
+  if (state.clip.isWideOpen() && fill.isOpaque()) {
     // The clip is wide open, and the fill is opaque, so we can discard all previous records as
     // they are now invisible.
     clear();
   }
   if (fill.color.alpha > 0.0f) {
-    records.push_back(new DrawFill(state, fill));
+    records.append<DrawFill>(state, fill);
   }
 }
 
 void RecordingContext::drawRect(const Rect& rect, const MCState& state, const Fill& fill) {
-  records.push_back(new DrawRect(rect, state, fill));
+  records.append<DrawRect>(state, rect, fill);
 }
 
 void RecordingContext::drawRRect(const RRect& rRect, const MCState& state, const Fill& fill) {
-  records.push_back(new DrawRRect(rRect, state, fill));
+  records.append<DrawRRect>(state, rRect, fill);
 }
 
 void RecordingContext::drawShape(std::shared_ptr<Shape> shape, const MCState& state,
                                  const Fill& fill) {
   DEBUG_ASSERT(shape != nullptr);
-  records.push_back(new DrawShape(std::move(shape), state, fill));
+  records.append<DrawShape>(state, std::move(shape), fill);
 }
 
 void RecordingContext::drawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling,
                                  const MCState& state, const Fill& fill) {
   DEBUG_ASSERT(image != nullptr);
-  records.push_back(new DrawImage(std::move(image), sampling, state, fill));
+  records.append<DrawImage>(state, std::move(image), sampling, fill);
 }
 
 void RecordingContext::drawImageRect(std::shared_ptr<Image> image, const Rect& rect,
                                      const SamplingOptions& sampling, const MCState& state,
                                      const Fill& fill) {
   DEBUG_ASSERT(image != nullptr);
-  records.push_back(new DrawImageRect(std::move(image), rect, sampling, state, fill));
+  records.append<DrawImageRect>(state, std::move(image), rect, sampling, fill);
 }
 
 void RecordingContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
                                         const MCState& state, const Fill& fill,
                                         const Stroke* stroke) {
   if (stroke) {
-    records.push_back(new StrokeGlyphRunList(std::move(glyphRunList), state, fill, *stroke));
+    records.append<StrokeGlyphRunList>(state, std::move(glyphRunList), fill, *stroke);
   } else {
-    records.push_back(new DrawGlyphRunList(std::move(glyphRunList), state, fill));
+    records.append<DrawGlyphRunList>(state, std::move(glyphRunList), fill);
   }
 }
 
@@ -125,13 +94,13 @@ void RecordingContext::drawLayer(std::shared_ptr<Picture> picture,
                                  std::shared_ptr<ImageFilter> filter, const MCState& state,
                                  const Fill& fill) {
   DEBUG_ASSERT(picture != nullptr);
-  records.push_back(new DrawLayer(std::move(picture), std::move(filter), state, fill));
+  records.append<DrawLayer>(state, std::move(picture), std::move(filter), fill);
 }
 
 void RecordingContext::drawPicture(std::shared_ptr<Picture> picture, const MCState& state) {
   DEBUG_ASSERT(picture != nullptr);
-  if (picture->records.size() > MaxPictureDrawsToUnrollInsteadOfReference) {
-    records.push_back(new DrawPicture(picture, state));
+  if (picture->records->size() > MaxPictureDrawsToUnrollInsteadOfReference) {
+    records.append<DrawPicture>(state, picture);
   } else {
     picture->playback(this, state);
   }
@@ -20,7 +20,7 @@
 
 #include <functional>
 #include "core/DrawContext.h"
-#include "core/Records.h"
+#include "core/PictureRecords.h"
 
 namespace tgfx {
 class RecordingContext : public DrawContext {
@@ -53,6 +53,6 @@ class RecordingContext : public DrawContext {
                  const MCState& state, const Fill& fill) override;
 
  private:
-  std::vector<Record*> records = {};
+  PictureRecords records = {};
 };
 }  // namespace tgfx
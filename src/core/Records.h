@@ -21,7 +21,7 @@
 #include "core/DrawContext.h"
 
 namespace tgfx {
-enum class RecordType {
+enum class RecordType : uint8_t {
   DrawFill,
   DrawRect,
   DrawRRect,
@@ -34,31 +34,31 @@ enum class RecordType {
   DrawLayer
 };
 
+/**
+ * Record is the common header of all drawing commands stored in a PictureRecords. Records have no
+ * virtual functions. They are dispatched by type(), and their matrices and clips are kept in the
+ * side tables of the PictureRecords, referenced by index.
+ */
 class Record {
  public:
-  explicit Record(MCState state) : state(std::move(state)) {
+  RecordType type() const {
+    return _type;
   }
 
-  virtual ~Record() = default;
+  uint32_t matrixIndex = 0;
+  uint32_t clipIndex = 0;
 
-  virtual RecordType type() const = 0;
-
-  virtual void playback(DrawContext* context) const = 0;
+ protected:
+  explicit Record(RecordType type) : _type(type) {
+  }
 
-  MCState state;
+ private:
+  RecordType _type = RecordType::DrawFill;
 };
 
 class DrawFill : public Record {
  public:
-  DrawFill(MCState state, Fill fill) : Record(std::move(state)), fill(std::move(fill)) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawFill;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawFill(state, fill);
+  explicit DrawFill(Fill fill) : Record(RecordType::DrawFill), fill(std::move(fill)) {
   }
 
   Fill fill;
@@ -66,16 +66,8 @@ class DrawFill : public Record {
 
 class DrawRect : public Record {
  public:
-  DrawRect(const Rect& rect, MCState state, Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), rect(rect) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawRect;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawRect(rect, state, fill);
+  DrawRect(const Rect& rect, Fill fill)
+      : Record(RecordType::DrawRect), fill(std::move(fill)), rect(rect) {
   }
 
   Fill fill;
@@ -84,16 +76,8 @@ class DrawRect : public Record {
 
 class DrawRRect : public Record {
  public:
-  DrawRRect(const RRect& rRect, MCState state, Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), rRect(rRect) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawRRect;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawRRect(rRect, state, fill);
+  DrawRRect(const RRect& rRect, Fill fill)
+      : Record(RecordType::DrawRRect), fill(std::move(fill)), rRect(rRect) {
   }
 
   Fill fill;
@@ -102,16 +86,8 @@ class DrawRRect : public Record {
 
 class DrawShape : public Record {
  public:
-  DrawShape(std::shared_ptr<Shape> shape, MCState state, Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), shape(std::move(shape)) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawShape;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawShape(shape, state, fill);
+  DrawShape(std::shared_ptr<Shape> shape, Fill fill)
+      : Record(RecordType::DrawShape), fill(std::move(fill)), shape(std::move(shape)) {
   }
 
   Fill fill;
@@ -120,37 +96,27 @@ class DrawShape : public Record {
 
 class DrawImage : public Record {
  public:
-  DrawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling, MCState state, Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), image(std::move(image)),
-        sampling(sampling) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawImage;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawImage(image, sampling, state, fill);
+  DrawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling, Fill fill)
+      : DrawImage(RecordType::DrawImage, std::move(image), sampling, std::move(fill)) {
   }
 
   Fill fill;
   std::shared_ptr<Image> image;
   SamplingOptions sampling;
+
+ protected:
+  DrawImage(RecordType type, std::shared_ptr<Image> image, const SamplingOptions& sampling,
+            Fill fill)
+      : Record(type), fill(std::move(fill)), image(std::move(image)), sampling(sampling) {
+  }
 };
 
 class DrawImageRect : public DrawImage {
  public:
   DrawImageRect(std::shared_ptr<Image> image, const Rect& rect, const SamplingOptions& sampling,
-                MCState state, Fill fill)
-      : DrawImage(std::move(image), sampling, std::move(state), std::move(fill)), rect(rect) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawImageRect;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawImageRect(image, rect, sampling, state, fill);
+                Fill fill)
+      : DrawImage(RecordType::DrawImageRect, std::move(image), sampling, std::move(fill)),
+        rect(rect) {
   }
 
   Rect rect;
@@ -158,53 +124,34 @@ class DrawImageRect : public DrawImage {
 
 class DrawGlyphRunList : public Record {
  public:
-  DrawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList, MCState state, Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), glyphRunList(std::move(glyphRunList)) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawGlyphRunList;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawGlyphRunList(glyphRunList, state, fill, nullptr);
+  DrawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList, Fill fill)
+      : DrawGlyphRunList(RecordType::DrawGlyphRunList, std::move(glyphRunList), std::move(fill)) {
   }
 
   Fill fill;
   std::shared_ptr<GlyphRunList> glyphRunList;
+
+ protected:
+  DrawGlyphRunList(RecordType type, std::shared_ptr<GlyphRunList> glyphRunList, Fill fill)
+      : Record(type), fill(std::move(fill)), glyphRunList(std::move(glyphRunList)) {
+  }
 };
 
 class StrokeGlyphRunList : public DrawGlyphRunList {
  public:
-  StrokeGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList, MCState state, Fill fill,
-                     const Stroke& stroke)
-      : DrawGlyphRunList(std::move(glyphRunList), std::move(state), std::move(fill)),
+  StrokeGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList, Fill fill, const Stroke& stroke)
+      : DrawGlyphRunList(RecordType::StrokeGlyphRunList, std::move(glyphRunList),
+                         std::move(fill)),
         stroke(stroke) {
   }
 
-  RecordType type() const override {
-    return RecordType::StrokeGlyphRunList;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawGlyphRunList(glyphRunList, state, fill, &stroke);
-  }
-
   Stroke stroke;
 };
 
 class DrawPicture : public Record {
  public:
-  DrawPicture(std::shared_ptr<Picture> picture, MCState state)
-      : Record(std::move(state)), picture(std::move(picture)) {
-  }
-
-  RecordType type() const override {
-    return RecordType::DrawPicture;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawPicture(picture, state);
+  explicit DrawPicture(std::shared_ptr<Picture> picture)
+      : Record(RecordType::DrawPicture), picture(std::move(picture)) {
   }
 
   std::shared_ptr<Picture> picture;
@@ -212,20 +159,11 @@ class DrawPicture : public Record {
 
 class DrawLayer : public Record {
  public:
-  DrawLayer(std::shared_ptr<Picture> picture, std::shared_ptr<ImageFilter> filter, MCState state,
-            Fill fill)
-      : Record(std::move(state)), fill(std::move(fill)), picture(std::move(picture)),
+  DrawLayer(std::shared_ptr<Picture> picture, std::shared_ptr<ImageFilter> filter, Fill fill)
+      : Record(RecordType::DrawLayer), fill(std::move(fill)), picture(std::move(picture)),
         filter(std::move(filter)) {
   }
 
-  RecordType type() const override {
-    return RecordType::DrawLayer;
-  }
-
-  void playback(DrawContext* context) const override {
-    context->drawLayer(picture, filter, state, fill);
-  }
-
   Fill fill;
   std::shared_ptr<Picture> picture;
   std::shared_ptr<ImageFilter> filter;
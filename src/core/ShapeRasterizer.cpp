@@ -17,11 +17,39 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeRasterizer.h"
+#include <algorithm>
 #include "core/PathTriangulator.h"
 #include "tgfx/core/Mask.h"
+#include "tgfx/core/Task.h"
 #include "utils/Log.h"
 
 namespace tgfx {
+/**
+ * Paths with at least this many verbs are tessellated in horizontal bands in parallel. Clipping a
+ * path into bands costs a path operation per band, which only pays off for really large paths.
+ */
+static constexpr int BANDED_TESSELLATION_MIN_VERBS = 10000;
+
+/**
+ * The minimum height of a band in pixels.
+ */
+static constexpr int MIN_BAND_HEIGHT = 64;
+
+/**
+ * The maximum number of bands a path can be split into.
+ */
+static constexpr int MAX_BAND_COUNT = 16;
+
+int ShapeRasterizer::GetBandCount(const Path& path, int height) {
+  if (path.countVerbs() < BANDED_TESSELLATION_MIN_VERBS || path.isInverseFillType()) {
+    return 1;
+  }
+  // One band per worker of the thread pool, more bands would only wait in the queue.
+  auto threadCount = Task::MaxThreadCount();
+  auto bandCount = std::min(std::min(threadCount, MAX_BAND_COUNT), height / MIN_BAND_HEIGHT);
+  return std::max(bandCount, 1);
+}
+
 ShapeRasterizer::ShapeRasterizer(int width, int height, std::shared_ptr<Shape> shape, AAType aaType)
     : Rasterizer(width, height), shape(std::move(shape)), aaType(aaType) {
 }
@@ -51,8 +79,14 @@ std::shared_ptr<Data> ShapeRasterizer::makeTriangles(const Path& finalPath) cons
     count = PathTriangulator::ToAATriangles(finalPath, bounds, &vertices);
   } else {
     // If MSAA is enabled, we skip generating AA triangles since the shape will be drawn directly to
-    // the screen.
-    count = PathTriangulator::ToTriangles(finalPath, bounds, &vertices);
+    // the screen. Without the antialiasing ramps, the triangles of adjacent bands tile seamlessly,
+    // so huge paths can be tessellated band by band in parallel.
+    auto bandCount = GetBandCount(finalPath, height());
+    if (bandCount > 1) {
+      count = makeBandedTriangles(finalPath, bandCount, &vertices);
+    } else {
+      count = PathTriangulator::ToTriangles(finalPath, bounds, &vertices);
+    }
   }
   if (count == 0) {
     // The path is not a filled path, or it is invisible.
@@ -61,6 +95,44 @@ std::shared_ptr<Data> ShapeRasterizer::makeTriangles(const Path& finalPath) cons
   return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
 }
 
+size_t ShapeRasterizer::makeBandedTriangles(const Path& finalPath, int bandCount,
+                                            std::vector<float>* vertices) const {
+  // Computes the bounds on the current thread, the path caches them lazily.
+  auto pathBounds = finalPath.getBounds();
+  auto top = floorf(pathBounds.top);
+  auto bottom = ceilf(pathBounds.bottom);
+  // Cut the bands at whole pixels, so no pixel center lies on the seam between two bands.
+  auto bandHeight = ceilf((bottom - top) / static_cast<float>(bandCount));
+  std::vector<std::vector<float>> bandVertices(static_cast<size_t>(bandCount));
+  std::vector<size_t> bandTriangles(static_cast<size_t>(bandCount), 0);
+  Task::ParallelFor(bandVertices.size(), 1, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto bandTop = top + bandHeight * static_cast<float>(i);
+      auto bandBottom = std::min(bandTop + bandHeight, bottom);
+      if (bandTop >= bandBottom) {
+        continue;
+      }
+      auto bandRect =
+          Rect::MakeLTRB(pathBounds.left - 1.0f, bandTop, pathBounds.right + 1.0f, bandBottom);
+      Path bandPath = {};
+      bandPath.addRect(bandRect);
+      bandPath.addPath(finalPath, PathOp::Intersect);
+      bandTriangles[i] = PathTriangulator::ToTriangles(bandPath, bandRect, &bandVertices[i]);
+    }
+  });
+  size_t count = 0;
+  size_t totalSize = 0;
+  for (size_t i = 0; i < bandVertices.size(); i++) {
+    count += bandTriangles[i];
+    totalSize += bandVertices[i].size();
+  }
+  vertices->reserve(vertices->size() + totalSize);
+  for (auto& band : bandVertices) {
+    vertices->insert(vertices->end(), band.begin(), band.end());
+  }
+  return count;
+}
+
 std::shared_ptr<ImageBuffer> ShapeRasterizer::makeImageBuffer(const Path& finalPath,
                                                               bool tryHardware) const {
   auto mask = Mask::Make(width(), height(), tryHardware);
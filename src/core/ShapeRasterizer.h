@@ -51,8 +51,13 @@ class ShapeRasterizer : public Rasterizer, public DataSource<ShapeBuffer> {
   std::shared_ptr<Shape> shape = nullptr;
   AAType aaType = AAType::None;
 
+  static int GetBandCount(const Path& path, int height);
+
   std::shared_ptr<Data> makeTriangles(const Path& finalPath) const;
 
+  size_t makeBandedTriangles(const Path& finalPath, int bandCount,
+                             std::vector<float>* vertices) const;
+
   std::shared_ptr<ImageBuffer> makeImageBuffer(const Path& finalPath, bool tryHardware) const;
 };
 }  // namespace tgfx
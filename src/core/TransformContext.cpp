@@ -39,8 +39,8 @@ class MatrixDrawContext : public TransformContext {
 
 class ClipDrawContext : public TransformContext {
  public:
-  ClipDrawContext(DrawContext* drawContext, Path clip)
-      : TransformContext(drawContext), initClip(std::move(clip)) {
+  ClipDrawContext(DrawContext* drawContext, ClipStack clip)
+      : TransformContext(drawContext), initClip(std::move(clip)), lastIntersectedClip(initClip) {
   }
 
  protected:
@@ -49,21 +49,21 @@ class ClipDrawContext : public TransformContext {
     if (state.clip != lastClip) {
       lastClip = state.clip;
       lastIntersectedClip = initClip;
-      lastIntersectedClip.addPath(state.clip, PathOp::Intersect);
+      lastIntersectedClip.clip(state.clip);
       newState.clip = lastIntersectedClip;
     }
     return newState;
   }
 
  private:
-  Path initClip = {};
-  Path lastClip = {};
-  Path lastIntersectedClip = {};
+  ClipStack initClip = {};
+  ClipStack lastClip = {};
+  ClipStack lastIntersectedClip = {};
 };
 
 class MCStateDrawContext : public ClipDrawContext {
  public:
-  MCStateDrawContext(DrawContext* drawContext, const Matrix& matrix, Path clip)
+  MCStateDrawContext(DrawContext* drawContext, const Matrix& matrix, ClipStack clip)
       : ClipDrawContext(drawContext, std::move(clip)), initMatrix(matrix) {
   }
 
@@ -88,11 +88,12 @@ std::unique_ptr<TransformContext> TransformContext::Make(DrawContext* drawContex
 }
 
 std::unique_ptr<TransformContext> TransformContext::Make(DrawContext* drawContext,
-                                                         const Matrix& matrix, const Path& clip) {
+                                                         const Matrix& matrix,
+                                                         const ClipStack& clip) {
+  if (clip.isWideOpen()) {
+    return Make(drawContext, matrix);
+  }
   if (clip.isEmpty()) {
-    if (clip.isInverseFillType()) {
-      return Make(drawContext, matrix);
-    }
     return nullptr;
   }
   if (drawContext == nullptr) {
@@ -38,7 +38,7 @@ class TransformContext : public DrawContext {
    * the clip is empty.
    */
   static std::unique_ptr<TransformContext> Make(DrawContext* drawContext, const Matrix& matrix,
-                                                const Path& clip);
+                                                const ClipStack& clip);
 
   explicit TransformContext(DrawContext* drawContext) : drawContext(drawContext) {
   }
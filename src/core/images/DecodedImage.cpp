@@ -30,7 +30,9 @@ std::shared_ptr<Image> DecodedImage::MakeFrom(UniqueKey uniqueKey,
   auto width = generator->width();
   auto height = generator->height();
   auto alphaOnly = generator->isAlphaOnly();
-  auto source = ImageSource::MakeFrom(std::move(generator), tryHardware, asyncDecoding);
+  // Decoding ahead of drawing is speculative, let the decoding for the current frame go first.
+  auto source =
+      ImageSource::MakeFrom(std::move(generator), tryHardware, asyncDecoding, TaskPriority::Low);
   auto image = std::shared_ptr<DecodedImage>(
       new DecodedImage(std::move(uniqueKey), width, height, alphaOnly, std::move(source)));
   image->weakThis = image;
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PictureImage.h"
+#include "core/PictureRecords.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/OpsCompositor.h"
 #include "gpu/ProxyProvider.h"
@@ -33,7 +34,7 @@ std::shared_ptr<Image> Image::MakeFrom(std::shared_ptr<Picture> picture, int wid
   if (matrix && !matrix->invertible()) {
     return nullptr;
   }
-  if (picture->records.size() == 1) {
+  if (picture->records->size() == 1) {
     ISize clipSize = {width, height};
     auto image = picture->asImage(nullptr, matrix, &clipSize);
     if (image) {
@@ -50,5 +50,6 @@ class ResourceImage : public Image {
                                                          const Matrix* uvMatrix) const override;
 
   friend class MipmapImage;
+  friend class ImageAtlas;
 };
 }  // namespace tgfx
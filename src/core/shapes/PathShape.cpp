@@ -63,7 +63,7 @@ Path PathShape::getPath(float) const {
 }
 
 UniqueKey PathShape::getUniqueKey() const {
-  return PathRef::GetUniqueKey(path);
+  return PathRef::GetContentKey(path);
 }
 
 }  // namespace tgfx
@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BlockAllocator.h"
+#include <algorithm>
+#include "core/utils/Log.h"
+
+namespace tgfx {
+static constexpr size_t MaxBlockSize = 256 * 1024;
+
+static size_t AlignTo(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+BlockAllocator::BlockAllocator(size_t initBlockSize)
+    : initBlockSize(std::max(initBlockSize, static_cast<size_t>(64))) {
+}
+
+BlockAllocator::~BlockAllocator() {
+  releaseBlocks(0);
+}
+
+BlockAllocator::BlockAllocator(BlockAllocator&& other) noexcept
+    : initBlockSize(other.initBlockSize), blocks(std::move(other.blocks)), offset(other.offset) {
+  other.blocks.clear();
+  other.offset = 0;
+}
+
+BlockAllocator& BlockAllocator::operator=(BlockAllocator&& other) noexcept {
+  if (this != &other) {
+    releaseBlocks(0);
+    initBlockSize = other.initBlockSize;
+    blocks = std::move(other.blocks);
+    offset = other.offset;
+    other.blocks.clear();
+    other.offset = 0;
+  }
+  return *this;
+}
+
+void* BlockAllocator::allocate(size_t size, size_t alignment) {
+  DEBUG_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  DEBUG_ASSERT(alignment <= alignof(std::max_align_t));
+  if (!blocks.empty()) {
+    auto& block = blocks.back();
+    auto start = AlignTo(offset, alignment);
+    if (start + size <= block.size) {
+      offset = start + size;
+      return block.data + start;
+    }
+  }
+  auto blockSize = blocks.empty() ? initBlockSize : std::min(blocks.back().size * 2, MaxBlockSize);
+  blockSize = std::max(blockSize, size);
+  // The blocks come from operator new[], which aligns them for any fundamental type.
+  blocks.push_back({new uint8_t[blockSize], blockSize});
+  offset = size;
+  return blocks.back().data;
+}
+
+void BlockAllocator::clear() {
+  releaseBlocks(1);
+  offset = 0;
+}
+
+size_t BlockAllocator::memoryUsage() const {
+  size_t usage = 0;
+  for (auto& block : blocks) {
+    usage += block.size;
+  }
+  return usage;
+}
+
+void BlockAllocator::releaseBlocks(size_t keepCount) {
+  while (blocks.size() > keepCount) {
+    delete[] blocks.back().data;
+    blocks.pop_back();
+  }
+}
+}  // namespace tgfx
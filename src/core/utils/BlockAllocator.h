@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace tgfx {
+/**
+ * BlockAllocator hands out memory from a list of blocks by bumping an offset, so many small
+ * objects can be stored close together without a heap allocation each. The memory is only
+ * released all at once by clear() or the destructor, and the allocator never runs the destructors
+ * of the objects it holds.
+ */
+class BlockAllocator {
+ public:
+  BlockAllocator() = default;
+
+  /**
+   * Creates a BlockAllocator whose first block has the given size. Each new block doubles the size
+   * of the previous one, up to a fixed maximum.
+   */
+  explicit BlockAllocator(size_t initBlockSize);
+
+  ~BlockAllocator();
+
+  BlockAllocator(const BlockAllocator&) = delete;
+
+  BlockAllocator& operator=(const BlockAllocator&) = delete;
+
+  BlockAllocator(BlockAllocator&& other) noexcept;
+
+  BlockAllocator& operator=(BlockAllocator&& other) noexcept;
+
+  /**
+   * Returns a pointer to the given number of bytes with the given alignment, which must be a power
+   * of two no larger than alignof(std::max_align_t).
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * Constructs an object of type T in the allocator.
+   */
+  template <typename T, typename... Args>
+  T* make(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /**
+   * Releases all blocks except the first one, which is kept for reuse.
+   */
+  void clear();
+
+  /**
+   * Returns the total number of bytes held by the blocks.
+   */
+  size_t memoryUsage() const;
+
+ private:
+  struct Block {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+  };
+
+  size_t initBlockSize = 1024;
+  std::vector<Block> blocks = {};
+  size_t offset = 0;
+
+  void releaseBlocks(size_t keepCount);
+};
+}  // namespace tgfx
@@ -95,7 +95,6 @@ class LockFreeQueue {
 
     do {
       if (getIndex(oldTail) == getIndex(headPosition.load(std::memory_order_acquire))) {
-        LOGI("The queue has reached its maximum capacity, capacity: %u!\n", _capacity);
         return false;
       }
       newTail = oldTail + 1;
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/Task.h"
+#include <algorithm>
 #include "core/utils/TaskGroup.h"
 
 namespace tgfx {
@@ -34,19 +35,74 @@ class BlockTask : public Task {
   std::function<void()> block;
 };
 
-std::shared_ptr<Task> Task::Run(std::function<void()> block) {
+std::shared_ptr<Task> Task::Run(std::function<void()> block, TaskPriority priority) {
   if (block == nullptr) {
     return nullptr;
   }
   auto task = std::make_shared<BlockTask>(std::move(block));
-  Run(task);
+  Run(task, priority);
   return task;
 }
 
-void Task::Run(std::shared_ptr<Task> task) {
+void Task::Run(std::shared_ptr<Task> task, TaskPriority priority) {
   if (task == nullptr) {
     return;
   }
+  task->_priority = priority;
+  Submit(std::move(task));
+}
+
+void Task::ParallelFor(size_t count, size_t grain,
+                       const std::function<void(size_t begin, size_t end)>& block,
+                       TaskPriority priority) {
+  if (count == 0 || block == nullptr) {
+    return;
+  }
+  grain = std::max(grain, static_cast<size_t>(1));
+  auto chunkCount = (count + grain - 1) / grain;
+  if (chunkCount == 1) {
+    block(0, count);
+    return;
+  }
+  // Chunks are claimed dynamically, so a slow chunk doesn't hold up the others.
+  std::atomic<size_t> nextChunk = 0;
+  auto runChunks = [&]() {
+    size_t chunk = 0;
+    while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+      auto begin = chunk * grain;
+      block(begin, std::min(begin + grain, count));
+    }
+  };
+  auto maxThreads = static_cast<size_t>(MaxThreadCount());
+  auto helperCount = std::min(chunkCount - 1, maxThreads);
+  std::vector<std::shared_ptr<Task>> helpers = {};
+  helpers.reserve(helperCount);
+  for (size_t i = 0; i < helperCount; i++) {
+    helpers.push_back(Run(runChunks, priority));
+  }
+  runChunks();
+  // Helpers that haven't started yet run on the current thread and return immediately.
+  for (auto& helper : helpers) {
+    helper->wait();
+  }
+}
+
+bool Task::SetThreadPoolOptions(const ThreadPoolOptions& options) {
+  return TaskGroup::GetInstance()->setOptions(options);
+}
+
+int Task::PrewarmThreadPool() {
+  return TaskGroup::GetInstance()->prewarm();
+}
+
+int Task::MaxThreadCount() {
+#if defined(TGFX_BUILD_FOR_WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return 0;
+#endif
+  return TaskGroup::GetInstance()->getMaxThreads();
+}
+
+void Task::Submit(std::shared_ptr<Task> task) {
   if (!TaskGroup::GetInstance()->pushTask(task)) {
     task->execute();
   }
@@ -60,42 +116,42 @@ void Task::wait() {
   // If wait() is called from the thread pool, all threads might block, leaving no thread to execute
   // this task. To avoid deadlock, execute the task directly on the current thread if it's queued.
   if (oldStatus == TaskStatus::Queueing) {
-    if (_status.compare_exchange_weak(oldStatus, TaskStatus::Executing, std::memory_order_acq_rel,
-                                      std::memory_order_relaxed)) {
+    if (_status.compare_exchange_strong(oldStatus, TaskStatus::Executing,
+                                        std::memory_order_acq_rel, std::memory_order_relaxed)) {
       onExecute();
-      oldStatus = TaskStatus::Executing;
-      while (!_status.compare_exchange_weak(oldStatus, TaskStatus::Finished,
-                                            std::memory_order_acq_rel, std::memory_order_relaxed)) {
-      }
+      _status.store(TaskStatus::Finished, std::memory_order_release);
+      finish();
       return;
     }
   }
   std::unique_lock<std::mutex> autoLock(locker);
-  if (_status.load(std::memory_order_acquire) == TaskStatus::Executing) {
-    condition.wait(autoLock);
-  }
+  condition.wait(autoLock, [this] {
+    return _status.load(std::memory_order_acquire) != TaskStatus::Executing;
+  });
 }
 
 void Task::cancel() {
   auto currentStatus = _status.load(std::memory_order_relaxed);
-  if (currentStatus == TaskStatus::Queueing) {
-    _status.compare_exchange_weak(currentStatus, TaskStatus::Canceled, std::memory_order_acq_rel,
-                                  std::memory_order_relaxed);
+  if (currentStatus == TaskStatus::Queueing &&
+      _status.compare_exchange_strong(currentStatus, TaskStatus::Canceled,
+                                      std::memory_order_acq_rel, std::memory_order_relaxed)) {
+    finish();
   }
 }
 
 void Task::execute() {
   auto oldStatus = _status.load(std::memory_order_relaxed);
   if (oldStatus == TaskStatus::Queueing &&
-      _status.compare_exchange_weak(oldStatus, TaskStatus::Executing, std::memory_order_acq_rel,
-                                    std::memory_order_relaxed)) {
+      _status.compare_exchange_strong(oldStatus, TaskStatus::Executing, std::memory_order_acq_rel,
+                                      std::memory_order_relaxed)) {
     onExecute();
-    oldStatus = TaskStatus::Executing;
-    while (!_status.compare_exchange_weak(oldStatus, TaskStatus::Finished,
-                                          std::memory_order_acq_rel, std::memory_order_relaxed)) {
-    }
-    std::unique_lock<std::mutex> autoLock(locker);
-    condition.notify_all();
+    _status.store(TaskStatus::Finished, std::memory_order_release);
+    finish();
   }
 }
+
+void Task::finish() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  condition.notify_all();
+}
 }  // namespace tgfx
@@ -26,10 +26,22 @@
 #include <sys/sysctl.h>
 #endif
 
+#if defined(__linux__)
+#include <sched.h>
+#include <fstream>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
 namespace tgfx {
-static constexpr auto THREAD_TIMEOUT = std::chrono::seconds(10);
-static constexpr uint32_t THREAD_POOL_SIZE = 32;
-static constexpr uint32_t TASK_QUEUE_SIZE = 1024;
+static constexpr int MAX_SPIN_COUNT = 16;
+static constexpr int DEFAULT_MAX_THREADS = 16;
+
+// The index of the worker running on the current thread, or -1 if it is not a worker thread.
+static thread_local int CurrentWorkerIndex = -1;
 
 int GetCPUCores() {
   int cpuCores = 0;
@@ -46,19 +58,75 @@ int GetCPUCores() {
   return cpuCores;
 }
 
+/**
+ * Parses a CPU list in the Linux sysfs format, e.g. "0-3,8,10-11".
+ */
+static std::vector<int> ParseCPUList(const std::string& text) {
+  std::vector<int> cpus = {};
+  size_t start = 0;
+  while (start < text.size()) {
+    auto end = text.find(',', start);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    auto range = text.substr(start, end - start);
+    auto dash = range.find('-');
+    auto first = std::atoi(range.c_str());
+    auto last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+    for (auto cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+    start = end + 1;
+  }
+  return cpus;
+}
+
+static std::vector<int> GetNUMANodeCPUs(int node) {
+  if (node < 0) {
+    return {};
+  }
+#if defined(__linux__)
+  std::ifstream stream("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  std::string cpuList = {};
+  if (!std::getline(stream, cpuList)) {
+    LOGE("TaskGroup: failed to read the CPU list of the NUMA node %d!", node);
+    return {};
+  }
+  return ParseCPUList(cpuList);
+#else
+  return {};
+#endif
+}
+
 TaskGroup* TaskGroup::GetInstance() {
   static auto& taskGroup = *new TaskGroup();
   return &taskGroup;
 }
 
-void TaskGroup::RunLoop(TaskGroup* taskGroup) {
+void TaskGroup::RunLoop(TaskGroup* taskGroup, int workerIndex) {
+  CurrentWorkerIndex = workerIndex;
+  taskGroup->applyAffinity(workerIndex);
   while (!taskGroup->exited) {
-    auto task = taskGroup->popTask();
+    auto task = taskGroup->popTask(workerIndex);
     if (task == nullptr) {
-      continue;
+      if (taskGroup->exited) {
+        break;
+      }
+      // The worker has been idle for too long. Give up the thread count first, then check once more
+      // so that a task pushed meanwhile either sees the free count and starts a new worker or gets
+      // picked up here.
+      taskGroup->activeThreads--;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      task = taskGroup->findTask(workerIndex);
+      if (task == nullptr) {
+        break;
+      }
+      taskGroup->activeThreads++;
     }
     task->execute();
   }
+  CurrentWorkerIndex = -1;
+  taskGroup->workers[workerIndex].state.store(WorkerState::Retired, std::memory_order_release);
 }
 
 static void ReleaseThread(std::thread* thread) {
@@ -68,6 +136,12 @@ static void ReleaseThread(std::thread* thread) {
   delete thread;
 }
 
+static std::shared_ptr<Task> TakeTask(std::shared_ptr<Task>* holder) {
+  auto task = std::move(*holder);
+  delete holder;
+  return task;
+}
+
 void OnAppExit() {
   // Forces all pending tasks to be finished when the app is exiting to prevent accessing wild
   // pointers.
@@ -75,24 +149,130 @@ void OnAppExit() {
 }
 
 TaskGroup::TaskGroup() {
-  threads = new LockFreeQueue<std::thread*>(THREAD_POOL_SIZE);
-  tasks = new LockFreeQueue<std::shared_ptr<Task>>(TASK_QUEUE_SIZE);
+  setOptions({});
   std::atexit(OnAppExit);
 }
 
+bool TaskGroup::setOptions(const ThreadPoolOptions& newOptions) {
+  // Checked under the same lock that spawnThread() takes to start the first worker, so a task
+  // pushed from another thread never sees the workers and queues while they are being replaced.
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (started) {
+    return false;
+  }
+  options = newOptions;
+  if (options.maxThreads <= 0) {
+    options.maxThreads = std::min(GetCPUCores(), DEFAULT_MAX_THREADS);
+  }
+  options.queueCapacity = std::max(options.queueCapacity, 2u);
+  numaCPUs = options.cpuAffinity.empty() ? GetNUMANodeCPUs(options.numaNode) : std::vector<int>{};
+  releaseQueues();
+  maxThreads = options.maxThreads;
+  workerSlots = maxThreads * 2;
+  workers = std::make_unique<Worker[]>(static_cast<size_t>(workerSlots));
+  for (auto& queue : tasks) {
+    queue = new LockFreeQueue<std::shared_ptr<Task>>(options.queueCapacity);
+  }
+  return true;
+}
+
+int TaskGroup::prewarm() {
+#if defined(TGFX_BUILD_FOR_WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return 0;
+#endif
+  while (!exited && spawnThread()) {
+  }
+  return activeThreads;
+}
+
+int TaskGroup::getMaxThreads() {
+  // Taken to read the options consistently with a concurrent setOptions() call.
+  std::lock_guard<std::mutex> autoLock(locker);
+  return maxThreads;
+}
+
 bool TaskGroup::checkThreads() {
-  static const int CPUCores = GetCPUCores();
-  static const int MaxThreads = CPUCores > 16 ? 16 : CPUCores;
-  if (waitingThreads == 0 && totalThreads < MaxThreads) {
-    auto thread = new (std::nothrow) std::thread(&TaskGroup::RunLoop, this);
-    if (thread) {
-      threads->enqueue(thread);
-      totalThreads++;
+  if (activeThreads > 0) {
+    return true;
+  }
+  // More workers are started by notifyWaitingThreads() when none of the running ones is parked.
+  spawnThread();
+  return activeThreads > 0;
+}
+
+bool TaskGroup::spawnThread() {
+  if (!started) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    started = true;
+  }
+  auto count = activeThreads.load();
+  do {
+    if (count >= maxThreads) {
+      return false;
+    }
+  } while (!activeThreads.compare_exchange_weak(count, count + 1));
+  for (int i = 0; i < workerSlots; i++) {
+    auto& worker = workers[i];
+    auto state = worker.state.load(std::memory_order_acquire);
+    if (state == WorkerState::Running ||
+        !worker.state.compare_exchange_strong(state, WorkerState::Running)) {
+      continue;
+    }
+    if (worker.thread != nullptr) {
+      // The retired thread has finished its loop, joining it returns almost immediately.
+      ReleaseThread(worker.thread);
+      worker.thread = nullptr;
+    }
+    auto thread = new (std::nothrow) std::thread(&TaskGroup::RunLoop, this, i);
+    if (thread == nullptr) {
+      worker.state = WorkerState::Empty;
+      activeThreads--;
+      return false;
+    }
+    worker.thread = thread;
+    auto slots = usedSlots.load();
+    while (slots < i + 1 && !usedSlots.compare_exchange_weak(slots, i + 1)) {
     }
-  } else {
     return true;
   }
-  return totalThreads > 0;
+  // Unreachable in practice, retiring workers never hold more than maxThreads slots.
+  activeThreads--;
+  return false;
+}
+
+void TaskGroup::applyAffinity(int workerIndex) {
+  std::vector<int> cpus = {};
+  if (!options.cpuAffinity.empty()) {
+    cpus.push_back(options.cpuAffinity[static_cast<size_t>(workerIndex) %
+                                       options.cpuAffinity.size()]);
+  } else {
+    cpus = numaCPUs;
+  }
+  if (cpus.empty()) {
+    return;
+  }
+#if defined(__linux__)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+    LOGE("TaskGroup: failed to set the CPU affinity of the worker %d!", workerIndex);
+  }
+#elif defined(_WIN32)
+  DWORD_PTR mask = 0;
+  for (auto cpu : cpus) {
+    if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+      mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+  }
+  if (mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+    LOGE("TaskGroup: failed to set the CPU affinity of the worker %d!", workerIndex);
+  }
+#endif
 }
 
 bool TaskGroup::pushTask(std::shared_ptr<Task> task) {
@@ -102,42 +282,154 @@ bool TaskGroup::pushTask(std::shared_ptr<Task> task) {
   if (exited || !checkThreads()) {
     return false;
   }
-  if (!tasks->enqueue(std::move(task))) {
-    return false;
-  }
-  if (waitingThreads > 0) {
-    condition.notify_one();
+  auto priority = static_cast<int>(task->priority());
+  if (CurrentWorkerIndex >= 0) {
+    // Tasks submitted from a worker go to its own queue, other idle workers can steal them.
+    workers[CurrentWorkerIndex].tasks[priority].push(new std::shared_ptr<Task>(std::move(task)));
+  } else if (!tasks[priority]->enqueue(task)) {
+    std::lock_guard<std::mutex> autoLock(overflowLocker);
+    overflowTasks[priority].push_back(std::move(task));
+    overflowCount++;
   }
+  notifyWaitingThreads();
   return true;
 }
 
-std::shared_ptr<Task> TaskGroup::popTask() {
-  std::unique_lock<std::mutex> autoLock(locker);
+void TaskGroup::notifyWaitingThreads() {
+  // Pairs with the fences in popTask() and RunLoop(), either the parking or retiring worker sees
+  // the new task or we see that worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waitingThreads.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (wakeSignals < waitingThreads) {
+      wakeSignals++;
+      condition.notify_one();
+      return;
+    }
+  }
+  // Nobody is parked, make sure some worker is alive to pick up the task.
+  if (activeThreads < maxThreads) {
+    spawnThread();
+  }
+}
+
+std::shared_ptr<Task> TaskGroup::popTask(int workerIndex) {
+  int spinCount = 0;
   while (!exited) {
-    auto task = tasks->dequeue();
+    auto task = findTask(workerIndex);
     if (task) {
       return task;
     }
+    if (spinCount++ < MAX_SPIN_COUNT) {
+      std::this_thread::yield();
+      continue;
+    }
     waitingThreads++;
-    auto status = condition.wait_for(autoLock, THREAD_TIMEOUT);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Check again after announcing that we are going to park, a task may have been pushed after
+    // the last check by a thread that has not seen us waiting yet.
+    task = findTask(workerIndex);
+    if (task) {
+      waitingThreads--;
+      return task;
+    }
+    std::unique_lock<std::mutex> autoLock(locker);
+    auto wakeUp = [this] { return wakeSignals > 0 || exited; };
+    auto signaled = true;
+    if (options.idleTimeout.count() > 0) {
+      signaled = condition.wait_for(autoLock, options.idleTimeout, wakeUp);
+    } else {
+      condition.wait(autoLock, wakeUp);
+    }
+    if (wakeSignals > 0) {
+      wakeSignals--;
+    }
     waitingThreads--;
-    if (exited || status == std::cv_status::timeout) {
+    if (!signaled) {
       return nullptr;
     }
+    spinCount = 0;
   }
   return nullptr;
 }
 
+std::shared_ptr<Task> TaskGroup::findTask(int workerIndex) {
+  for (int priority = 0; priority < TaskPriorityCount; priority++) {
+    auto task = findTask(workerIndex, priority);
+    if (task) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Task> TaskGroup::findTask(int workerIndex, int priority) {
+  auto& worker = workers[workerIndex];
+  auto holder = worker.tasks[priority].pop();
+  if (holder != nullptr) {
+    return TakeTask(holder);
+  }
+  auto task = tasks[priority]->dequeue();
+  if (task) {
+    return task;
+  }
+  if (overflowCount > 0) {
+    std::lock_guard<std::mutex> autoLock(overflowLocker);
+    auto& overflowQueue = overflowTasks[priority];
+    if (!overflowQueue.empty()) {
+      task = std::move(overflowQueue.front());
+      overflowQueue.pop_front();
+      overflowCount--;
+      return task;
+    }
+  }
+  auto slotCount = usedSlots.load(std::memory_order_acquire);
+  for (int i = 1; i < slotCount; i++) {
+    auto& victim = workers[(workerIndex + i) % slotCount];
+    holder = victim.tasks[priority].steal();
+    if (holder != nullptr) {
+      return TakeTask(holder);
+    }
+  }
+  return nullptr;
+}
+
+void TaskGroup::releaseQueues() {
+  for (int i = 0; i < workerSlots; i++) {
+    for (auto& queue : workers[i].tasks) {
+      std::shared_ptr<Task>* holder = nullptr;
+      while ((holder = queue.pop()) != nullptr) {
+        delete holder;
+      }
+    }
+  }
+  for (int priority = 0; priority < TaskPriorityCount; priority++) {
+    if (tasks[priority] != nullptr) {
+      while (tasks[priority]->dequeue() != nullptr) {
+      }
+      delete tasks[priority];
+      tasks[priority] = nullptr;
+    }
+    overflowTasks[priority].clear();
+  }
+}
+
 void TaskGroup::exit() {
   exited = true;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+  }
   condition.notify_all();
-  std::thread* thread = nullptr;
-  while ((thread = threads->dequeue()) != nullptr) {
-    ReleaseThread(thread);
+  for (int i = 0; i < workerSlots; i++) {
+    auto& worker = workers[i];
+    if (worker.thread != nullptr) {
+      ReleaseThread(worker.thread);
+      worker.thread = nullptr;
+    }
   }
-  delete threads;
-  delete tasks;
-  totalThreads = 0;
+  // All workers have quit, it is safe to drain their queues from the current thread.
+  releaseQueues();
+  activeThreads = 0;
   waitingThreads = 0;
 }
 }  // namespace tgfx
@@ -19,30 +19,71 @@
 #pragma once
 
 #include <condition_variable>
-#include <list>
+#include <deque>
 #include <mutex>
 #include <thread>
-#include <vector>
 #include "LockFreeQueue.h"
+#include "WorkStealingQueue.h"
 #include "tgfx/core/Task.h"
 
 namespace tgfx {
+static constexpr int TaskPriorityCount = 3;
+
+/**
+ * TaskGroup is the thread pool behind Task::Run(). Each worker thread owns a WorkStealingQueue for
+ * the tasks submitted from inside that worker, while tasks submitted from other threads go to a
+ * shared lock-free queue that spills into an unbounded overflow list once it is full. Idle workers
+ * steal from each other before parking, and submitters only take the parking lock when some worker
+ * is actually parked. Every queue is split by TaskPriority, and workers always look for a task of
+ * a higher priority everywhere before taking one of a lower priority. Workers are started on
+ * demand up to the configured maximum and exit after staying idle for the configured timeout.
+ */
 class TaskGroup {
  private:
+  enum class WorkerState { Empty, Running, Retired };
+
+  struct Worker {
+    std::atomic<WorkerState> state = WorkerState::Empty;
+    std::thread* thread = nullptr;
+    WorkStealingQueue<std::shared_ptr<Task>*> tasks[TaskPriorityCount] = {};
+  };
+
   std::mutex locker = {};
   std::condition_variable condition = {};
-  std::atomic_int totalThreads = 0;
+  std::atomic_int activeThreads = 0;
+  std::atomic_bool started = false;
   std::atomic_bool exited = false;
   std::atomic_int waitingThreads = 0;
-  LockFreeQueue<std::shared_ptr<Task>>* tasks = nullptr;
-  LockFreeQueue<std::thread*>* threads = nullptr;
+  // Guarded by locker, the number of parked workers that should wake up.
+  int wakeSignals = 0;
+  int maxThreads = 0;
+  // Retiring workers may still hold their slots for a moment after giving up their thread counts,
+  // so twice as many slots as maxThreads are allocated to always leave a free one for a new worker.
+  int workerSlots = 0;
+  std::atomic_int usedSlots = 0;
+  std::unique_ptr<Worker[]> workers = nullptr;
+  ThreadPoolOptions options = {};
+  std::vector<int> numaCPUs = {};
+  LockFreeQueue<std::shared_ptr<Task>>* tasks[TaskPriorityCount] = {};
+  std::mutex overflowLocker = {};
+  std::deque<std::shared_ptr<Task>> overflowTasks[TaskPriorityCount] = {};
+  std::atomic_int overflowCount = 0;
   static TaskGroup* GetInstance();
-  static void RunLoop(TaskGroup* taskGroup);
+  static void RunLoop(TaskGroup* taskGroup, int workerIndex);
 
   TaskGroup();
+  bool setOptions(const ThreadPoolOptions& newOptions);
+  int prewarm();
+  int getMaxThreads();
   bool checkThreads();
+  bool spawnThread();
+  void applyAffinity(int workerIndex);
   bool pushTask(std::shared_ptr<Task> task);
-  std::shared_ptr<Task> popTask();
+  std::shared_ptr<Task> popTask(int workerIndex);
+  std::shared_ptr<Task> findTask(int workerIndex);
+  std::shared_ptr<Task> findTask(int workerIndex, int priority);
+  void notifyWaitingThreads();
+  void releaseQueues();
   void exit();
 
   friend class Task;
@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tgfx {
+/**
+ * WorkStealingQueue is an unbounded lock-free deque based on the Chase-Lev algorithm. Only the
+ * thread owning the queue may call push() and pop(), which work on the bottom end like a stack.
+ * Any other thread may call steal() to take elements from the top end. The element type must be a
+ * pointer type. Replaced buffers are kept alive until the queue is destroyed, since a concurrent
+ * thief may still be reading from them.
+ */
+template <typename T>
+class WorkStealingQueue {
+ public:
+  WorkStealingQueue() : WorkStealingQueue(256) {
+  }
+
+  /**
+   * Creates a queue with the initial capacity, which is rounded up to the nearest power of 2.
+   */
+  explicit WorkStealingQueue(int64_t capacity) {
+    int64_t bufferCapacity = 1;
+    while (bufferCapacity < capacity) {
+      bufferCapacity <<= 1;
+    }
+    buffers.push_back(std::make_unique<Buffer>(bufferCapacity));
+    buffer.store(buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns true if the queue appears to be empty. The result may be stale if other threads are
+   * modifying the queue concurrently.
+   */
+  bool empty() const {
+    auto b = bottom.load(std::memory_order_relaxed);
+    auto t = top.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+  /**
+   * Pushes an element to the bottom of the queue, growing the buffer if it is full. Must only be
+   * called by the owner thread.
+   */
+  void push(T element) {
+    auto b = bottom.load(std::memory_order_relaxed);
+    auto t = top.load(std::memory_order_acquire);
+    auto currentBuffer = buffer.load(std::memory_order_relaxed);
+    if (b - t > currentBuffer->capacity - 1) {
+      currentBuffer = grow(currentBuffer, b, t);
+    }
+    currentBuffer->put(b, element);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Pops an element from the bottom of the queue. Returns nullptr if the queue is empty. Must only
+   * be called by the owner thread.
+   */
+  T pop() {
+    auto b = bottom.load(std::memory_order_relaxed) - 1;
+    auto currentBuffer = buffer.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto element = currentBuffer->get(b);
+    if (t == b) {
+      // This is the last element, race against the thieves for it.
+      if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+        element = nullptr;
+      }
+      bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return element;
+  }
+
+  /**
+   * Steals an element from the top of the queue. Returns nullptr if the queue is empty or if
+   * another thread won the race for the element. Can be called from any thread.
+   */
+  T steal() {
+    auto t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    auto currentBuffer = buffer.load(std::memory_order_acquire);
+    auto element = currentBuffer->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return element;
+  }
+
+ private:
+  struct Buffer {
+    int64_t capacity = 0;
+    std::unique_ptr<std::atomic<T>[]> slots = nullptr;
+
+    explicit Buffer(int64_t capacity) : capacity(capacity), slots(new std::atomic<T>[capacity]) {
+    }
+
+    T get(int64_t index) const {
+      return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, T element) {
+      slots[index & (capacity - 1)].store(element, std::memory_order_relaxed);
+    }
+  };
+
+  std::atomic<int64_t> top = {0};
+  std::atomic<int64_t> bottom = {0};
+  std::atomic<Buffer*> buffer = {nullptr};
+  // Only accessed by the owner thread.
+  std::vector<std::unique_ptr<Buffer>> buffers = {};
+
+  Buffer* grow(Buffer* oldBuffer, int64_t b, int64_t t) {
+    auto newBuffer = std::make_unique<Buffer>(oldBuffer->capacity * 2);
+    for (auto i = t; i < b; i++) {
+      newBuffer->put(i, oldBuffer->get(i));
+    }
+    buffers.push_back(std::move(newBuffer));
+    auto result = buffers.back().get();
+    buffer.store(result, std::memory_order_release);
+    return result;
+  }
+};
+}  // namespace tgfx
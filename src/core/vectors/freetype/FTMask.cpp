@@ -17,12 +17,30 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FTMask.h"
+#include <algorithm>
 #include "FTLibrary.h"
 #include "FTPath.h"
 #include "core/utils/USE.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Task.h"
 
 namespace tgfx {
+/**
+ * Masks with at least this many pixels covered by the path bounds are rasterized in row tiles in
+ * parallel.
+ */
+static constexpr int TILED_RASTERIZATION_MIN_PIXELS = 1024 * 1024;
+
+/**
+ * The minimum height of a row tile in pixels.
+ */
+static constexpr int MIN_TILE_HEIGHT = 64;
+
+/**
+ * The maximum number of row tiles a mask can be split into.
+ */
+static constexpr int MAX_TILE_COUNT = 16;
+
 static void Iterator(PathVerb verb, const Point points[4], void* info) {
   auto path = reinterpret_cast<FTPath*>(info);
   switch (verb) {
@@ -92,8 +110,52 @@ static void SpanFunc(int y, int count, const FT_Span* spans, void* user) {
   }
 }
 
+static const std::array<uint8_t, 256>& IdentityTable() {
+  static const std::array<uint8_t, 256> table = [] {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < 256; ++i) {
+      table[i] = static_cast<uint8_t>(i);
+    }
+    return table;
+  }();
+  return table;
+}
+
+static int GetTileCount(const Rect& bounds, int maxTileCount) {
+  auto width = static_cast<int>(bounds.width());
+  auto height = static_cast<int>(bounds.height());
+  if (width * height < TILED_RASTERIZATION_MIN_PIXELS) {
+    return 1;
+  }
+  // One tile per worker of the thread pool, more tiles would only wait in the queue.
+  auto threadCount = Task::MaxThreadCount();
+  auto tileCount = std::min({threadCount, maxTileCount, height / MIN_TILE_HEIGHT});
+  return std::max(tileCount, 1);
+}
+
+static void RenderOutlines(FT_Library ftLibrary,
+                           const std::vector<std::shared_ptr<FreetypeOutline>>& outlines,
+                           RasterTarget* target, const FT_BBox& clipBox) {
+  FT_Raster_Params params;
+  params.flags = FT_RASTER_FLAG_DIRECT | FT_RASTER_FLAG_CLIP | FT_RASTER_FLAG_AA;
+  params.gray_spans = SpanFunc;
+  params.user = target;
+  params.clip_box = clipBox;
+  for (auto& outline : outlines) {
+    FT_Outline_Render(ftLibrary, &(outline->outline), &params);
+  }
+}
+
 void FTMask::onFillPath(const Path& path, const Matrix& matrix, bool antiAlias,
                         bool needsGammaCorrection) {
+  // We ignore the antiAlias parameter because FreeType always produces 1-bit masks when antiAlias
+  // is disabled, and we haven't implemented the conversion from 1-bit to 8-bit masks.
+  USE(antiAlias);
+  rasterize(path, matrix, needsGammaCorrection, MAX_TILE_COUNT);
+}
+
+void FTMask::rasterize(const Path& path, const Matrix& matrix, bool needsGammaCorrection,
+                       int maxTileCount) {
   if (path.isEmpty()) {
     return;
   }
@@ -101,9 +163,6 @@ void FTMask::onFillPath(const Path& path, const Matrix& matrix, bool antiAlias,
   if (pixels == nullptr) {
     return;
   }
-  // We ignore the antiAlias parameter because FreeType always produces 1-bit masks when antiAlias
-  // is disabled, and we haven't implemented the conversion from 1-bit to 8-bit masks.
-  USE(antiAlias);
   const auto& info = pixelRef->info();
   auto finalPath = path;
   auto totalMatrix = matrix;
@@ -124,6 +183,42 @@ void FTMask::onFillPath(const Path& path, const Matrix& matrix, bool antiAlias,
   ftPath.setEvenOdd(fillType == PathFillType::EvenOdd || fillType == PathFillType::InverseEvenOdd);
   auto outlines = ftPath.getOutlines();
   auto ftLibrary = FTLibrary::Get();
+  auto clipBounds = Rect::MakeWH(info.width(), info.height());
+  if (!clipBounds.intersect(bounds)) {
+    pixelRef->unlockPixels();
+    return;
+  }
+  auto buffer = static_cast<unsigned char*>(pixels);
+  int rows = info.height();
+  int pitch = static_cast<int>(info.rowBytes());
+  RasterTarget target = {};
+  target.origin = buffer + (rows - 1) * pitch;
+  target.pitch = pitch;
+  auto tileCount = GetTileCount(clipBounds, maxTileCount);
+  if (tileCount > 1) {
+    // Each tile owns a range of rows in the shared pixels, so the tiles are written in place
+    // without any locking. The smooth rasterizer keeps its cell pool on the stack of each render
+    // call, and the FT_Library is only read, so the tiles can render concurrently.
+    target.gammaTable =
+        needsGammaCorrection ? PixelRefMask::GammaTable().data() : IdentityTable().data();
+    auto top = static_cast<int>(clipBounds.top);
+    auto bottom = static_cast<int>(clipBounds.bottom);
+    auto tileHeight = (bottom - top + tileCount - 1) / tileCount;
+    Task::ParallelFor(static_cast<size_t>(tileCount), 1, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; i++) {
+        FT_BBox clipBox = {};
+        clipBox.xMin = 0;
+        clipBox.yMin = top + tileHeight * static_cast<int>(i);
+        clipBox.xMax = (FT_Pos)info.width();
+        clipBox.yMax = std::min(clipBox.yMin + tileHeight, static_cast<FT_Pos>(bottom));
+        if (clipBox.yMin < clipBox.yMax) {
+          RenderOutlines(ftLibrary, outlines, &target, clipBox);
+        }
+      }
+    });
+    pixelRef->unlockPixels();
+    return;
+  }
   if (!needsGammaCorrection) {
     FT_Bitmap bitmap;
     bitmap.width = static_cast<unsigned>(info.width());
@@ -138,25 +233,13 @@ void FTMask::onFillPath(const Path& path, const Matrix& matrix, bool antiAlias,
     pixelRef->unlockPixels();
     return;
   }
-  auto buffer = static_cast<unsigned char*>(pixels);
-  int rows = info.height();
-  int pitch = static_cast<int>(info.rowBytes());
-  RasterTarget target = {};
-  target.origin = buffer + (rows - 1) * pitch;
-  target.pitch = pitch;
   target.gammaTable = PixelRefMask::GammaTable().data();
-  FT_Raster_Params params;
-  params.flags = FT_RASTER_FLAG_DIRECT | FT_RASTER_FLAG_CLIP | FT_RASTER_FLAG_AA;
-  params.gray_spans = SpanFunc;
-  params.user = &target;
-  auto& clip = params.clip_box;
-  clip.xMin = 0;
-  clip.yMin = 0;
-  clip.xMax = (FT_Pos)info.width();
-  clip.yMax = (FT_Pos)info.height();
-  for (auto& outline : outlines) {
-    FT_Outline_Render(ftLibrary, &(outline->outline), &params);
-  }
+  FT_BBox clipBox = {};
+  clipBox.xMin = 0;
+  clipBox.yMin = 0;
+  clipBox.xMax = (FT_Pos)info.width();
+  clipBox.yMax = (FT_Pos)info.height();
+  RenderOutlines(ftLibrary, outlines, &target, clipBox);
   pixelRef->unlockPixels();
 }
 }  // namespace tgfx
@@ -29,5 +29,13 @@ class FTMask : public PixelRefMask {
  protected:
   void onFillPath(const Path& path, const Matrix& matrix, bool antiAlias,
                   bool needsGammaCorrection) override;
+
+ private:
+  /**
+   * Fills the path into the pixels. If the path covers a large area, the mask is split into at
+   * most maxTileCount row tiles that are rasterized in parallel.
+   */
+  void rasterize(const Path& path, const Matrix& matrix, bool needsGammaCorrection,
+                 int maxTileCount);
 };
 }  // namespace tgfx
@@ -19,6 +19,7 @@
 #include "tgfx/gpu/Context.h"
 #include "core/utils/Log.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/ImageAtlas.h"
 #include "gpu/ProgramCache.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ResourceCache.h"
@@ -89,6 +90,30 @@ bool Context::wait(const BackendSemaphore& waitSemaphore) {
   return caps()->semaphoreSupport && _gpu->waitSemaphore(semaphore.get());
 }
 
+size_t Context::programCacheLimit() const {
+  return _programCache->cacheLimit();
+}
+
+void Context::setProgramCacheLimit(size_t bytesLimit) {
+  _programCache->setCacheLimit(bytesLimit);
+}
+
+int Context::imageAtlasLimit() const {
+  return _resourceProvider->imageAtlas()->maxImageSize();
+}
+
+void Context::setImageAtlasLimit(int maxImageSize) {
+  _resourceProvider->imageAtlas()->setMaxImageSize(maxImageSize);
+}
+
+void Context::recordPrograms(std::shared_ptr<ProgramManifest> manifest) {
+  _programCache->setManifestRecorder(std::move(manifest));
+}
+
+size_t Context::precompilePrograms(const ProgramManifest& manifest, size_t maxPrograms) {
+  return _programCache->precompilePrograms(manifest, maxPrograms);
+}
+
 size_t Context::memoryUsage() const {
   return _resourceCache->getResourceBytes();
 }
@@ -115,8 +140,9 @@ bool Context::purgeResourcesUntilMemoryTo(size_t bytesLimit, bool scratchResourc
 }
 
 void Context::releaseAll(bool releaseGPU) {
-  _resourceProvider->releaseAll();
+  _resourceProvider->releaseAll(releaseGPU);
   _programCache->releaseAll(releaseGPU);
   _resourceCache->releaseAll(releaseGPU);
+  _gpu->releaseAll(releaseGPU);
 }
 }  // namespace tgfx
\ No newline at end of file
@@ -17,6 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DrawingManager.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/ImageAtlas.h"
+#include "gpu/ResourceProvider.h"
 #include "gpu/proxies/RenderTargetProxy.h"
 #include "gpu/proxies/TextureProxy.h"
 #include "gpu/tasks/RenderTargetCopyTask.h"
@@ -127,6 +130,17 @@ void ClearAndReserveSize(std::vector<T>& list) {
   }
 }
 
+void DrawingManager::addOpsMergeStats(const OpsMergeStats& stats) {
+  mergeStats.mergedOps += stats.mergedOps;
+  mergeStats.savedProgramSwitches += stats.savedProgramSwitches;
+}
+
+void DrawingManager::addClipMaskStats(const ClipMaskStats& stats) {
+  maskStats.hits += stats.hits;
+  maskStats.misses += stats.misses;
+  maskStats.stencilWrites += stats.stencilWrites;
+}
+
 bool DrawingManager::flush() {
   while (!compositors.empty()) {
     auto compositor = compositors.back();
@@ -134,6 +148,10 @@ bool DrawingManager::flush() {
     // the makeClosed() method may add more compositors to the list.
     compositor->makeClosed();
   }
+  lastMergeStats = mergeStats;
+  mergeStats = {};
+  lastMaskStats = maskStats;
+  maskStats = {};
 
   if (resourceTasks.empty() && renderTasks.empty()) {
     return false;
@@ -143,6 +161,9 @@ bool DrawingManager::flush() {
   }
   ClearAndReserveSize(resourceTasks);
   resourceTaskMap = {};
+  // Upload the glyphs added since the last flush, the atlas textures are created by the resource
+  // tasks above.
+  context->resourceProvider()->glyphAtlas()->flush();
 
   if (renderPass == nullptr) {
     renderPass = RenderPass::Make(context);
@@ -158,10 +179,18 @@ bool DrawingManager::flush() {
     task->execute(renderPass.get());
   }
   ClearAndReserveSize(flattenTasks);
+  // Copy the images added since the last flush into the atlas pages, now that their own textures
+  // are created and flattened.
+  context->resourceProvider()->imageAtlas()->flush(renderPass.get());
   for (auto& task : renderTasks) {
     task->execute(renderPass.get());
   }
   ClearAndReserveSize(renderTasks);
+  auto resourceProvider = context->resourceProvider();
+  resourceProvider->vertexAllocator()->recycle();
+  if (context->caps()->uniformBufferSupport) {
+    resourceProvider->uniformAllocator()->recycle();
+  }
   return true;
 }
 }  // namespace tgfx
@@ -58,6 +58,30 @@ class DrawingManager {
 
   void addResourceTask(std::unique_ptr<ResourceTask> resourceTask);
 
+  /**
+   * Accumulates the merge statistics of a closed OpsCompositor into the current flush.
+   */
+  void addOpsMergeStats(const OpsMergeStats& stats);
+
+  /**
+   * Returns the merge statistics of all OpsCompositors closed by the last flush.
+   */
+  const OpsMergeStats& lastOpsMergeStats() const {
+    return lastMergeStats;
+  }
+
+  /**
+   * Accumulates the clip mask statistics of a closed OpsCompositor into the current flush.
+   */
+  void addClipMaskStats(const ClipMaskStats& stats);
+
+  /**
+   * Returns the clip mask statistics of all OpsCompositors closed by the last flush.
+   */
+  const ClipMaskStats& lastClipMaskStats() const {
+    return lastMaskStats;
+  }
+
   /**
    * Returns true if any render tasks were executed.
    */
@@ -71,5 +95,9 @@ class DrawingManager {
   std::vector<std::unique_ptr<RenderTask>> renderTasks = {};
   std::vector<std::shared_ptr<OpsCompositor>> compositors = {};
   ResourceKeyMap<size_t> resourceTaskMap = {};
+  OpsMergeStats mergeStats = {};
+  OpsMergeStats lastMergeStats = {};
+  ClipMaskStats maskStats = {};
+  ClipMaskStats lastMaskStats = {};
 };
 }  // namespace tgfx
@@ -0,0 +1,252 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include "core/GlyphRunList.h"
+#include "core/ImageStream.h"
+#include "core/utils/Log.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/ResourceCache.h"
+
+namespace tgfx {
+/**
+ * The default width and height of an atlas page. A page of ALPHA_8 pixels costs 1MB of GPU memory
+ * and another 1MB of CPU memory for the backing mask.
+ */
+static constexpr int DefaultPageSize = 1024;
+
+/**
+ * The maximum number of pages the atlas can allocate before it starts to reuse old pages.
+ */
+static constexpr size_t MaxPageCount = 4;
+
+/**
+ * The number of transparent pixels around each glyph, preventing the neighboring glyphs from
+ * bleeding into each other when sampling.
+ */
+static constexpr int GlyphPadding = 1;
+
+GlyphAtlas::GlyphAtlas(Context* context) : context(context) {
+  pageSize = std::min(DefaultPageSize, context->caps()->maxTextureSize);
+}
+
+static BytesKey MakeGlyphKey(const Font& font, GlyphID glyphID, int subpixelX, int subpixelY,
+                             bool antiAlias) {
+  BytesKey bytesKey(4);
+  bytesKey.write(font.getTypeface()->uniqueID());
+  bytesKey.write(font.getSize());
+  uint32_t flags = font.isFauxBold() ? 1 : 0;
+  flags |= font.isFauxItalic() ? 2 : 0;
+  flags |= antiAlias ? 4 : 0;
+  bytesKey.write(flags);
+  bytesKey.write(static_cast<uint32_t>(glyphID) | static_cast<uint32_t>(subpixelX) << 16 |
+                 static_cast<uint32_t>(subpixelY) << 24);
+  return bytesKey;
+}
+
+bool GlyphAtlas::findOrAddGlyph(const Font& font, GlyphID glyphID, int subpixelX, int subpixelY,
+                                bool antiAlias, AtlasGlyph* glyph) {
+  DEBUG_ASSERT(glyph != nullptr);
+  if (font.getTypeface() == nullptr || pageSize <= 0) {
+    return false;
+  }
+  DEBUG_ASSERT(subpixelX >= 0 && subpixelX < SubpixelCount);
+  DEBUG_ASSERT(subpixelY >= 0 && subpixelY < SubpixelCount);
+  auto glyphKey = MakeGlyphKey(font, glyphID, subpixelX, subpixelY, antiAlias);
+  auto result = glyphMap.find(glyphKey);
+  if (result != glyphMap.end()) {
+    auto& cachedGlyph = result->second;
+    auto page = cachedGlyph.page;
+    if (page == nullptr) {
+      *glyph = cachedGlyph.glyph;
+      return true;
+    }
+    if (lockPage(page)) {
+      page->lastUsedToken = currentToken;
+      *glyph = cachedGlyph.glyph;
+      glyph->textureProxy = page->textureProxy;
+      return true;
+    }
+    // The ResourceCache has purged the page texture, rasterize the glyph again.
+    removePage(page);
+  }
+  auto subpixelOffset = Point::Make(static_cast<float>(subpixelX) / SubpixelCount,
+                                    static_cast<float>(subpixelY) / SubpixelCount);
+  auto bounds = font.getBounds(glyphID);
+  if (bounds.isEmpty()) {
+    // Nothing to rasterize, cache an empty glyph so that we don't measure it again.
+    auto& cachedGlyph = glyphMap[glyphKey];
+    *glyph = cachedGlyph.glyph;
+    return true;
+  }
+  bounds.offset(subpixelOffset.x, subpixelOffset.y);
+  bounds.roundOut();
+  if (bounds.width() > MaxGlyphSize || bounds.height() > MaxGlyphSize) {
+    return false;
+  }
+  auto width = static_cast<int>(bounds.width()) + GlyphPadding * 2;
+  auto height = static_cast<int>(bounds.height()) + GlyphPadding * 2;
+  auto location = Point::Zero();
+  auto page = findPageWithRoom(width, height, &location);
+  if (page == nullptr) {
+    return false;
+  }
+  auto padding = static_cast<float>(GlyphPadding);
+  auto position = Point::Make(location.x + padding - bounds.left + subpixelOffset.x,
+                              location.y + padding - bounds.top + subpixelOffset.y);
+  if (!rasterizeGlyph(page, font, glyphID, position, antiAlias)) {
+    return false;
+  }
+  auto atlasRect = Rect::MakeXYWH(location.x, location.y, static_cast<float>(width),
+                                  static_cast<float>(height));
+  page->dirtyBounds.join(atlasRect);
+  page->lastUsedToken = currentToken;
+  page->glyphKeys.push_back(glyphKey);
+  auto& cachedGlyph = glyphMap[glyphKey];
+  cachedGlyph.page = page;
+  cachedGlyph.glyph.atlasRect = atlasRect;
+  cachedGlyph.glyph.offset = Point::Make(bounds.left - padding, bounds.top - padding);
+  *glyph = cachedGlyph.glyph;
+  glyph->textureProxy = page->textureProxy;
+  return true;
+}
+
+void GlyphAtlas::flush() {
+  for (auto& page : pages) {
+    if (page->textureProxy == nullptr) {
+      continue;
+    }
+    auto texture = page->textureProxy->getTexture();
+    if (texture != nullptr && !page->dirtyBounds.isEmpty()) {
+      auto stream = page->mask->getImageStream();
+      if (stream->onUpdateTexture(texture, page->dirtyBounds)) {
+        page->dirtyBounds.setEmpty();
+      }
+    }
+    // Hand the texture back to the ResourceCache. The draw ops of this flush still reference it,
+    // after that it stays in the cache under the page key until it is purged.
+    page->textureProxy = nullptr;
+  }
+  currentToken++;
+}
+
+GlyphAtlas::Page* GlyphAtlas::addPage() {
+  auto mask = Mask::Make(pageSize, pageSize, false);
+  if (mask == nullptr) {
+    return nullptr;
+  }
+  auto page = std::make_unique<Page>(pageSize);
+  page->textureProxy = context->proxyProvider()->createTextureProxy(
+      page->textureKey, pageSize, pageSize, PixelFormat::ALPHA_8);
+  if (page->textureProxy == nullptr) {
+    return nullptr;
+  }
+  page->mask = std::move(mask);
+  // The new texture has undefined content, upload the whole page at the first flush.
+  page->dirtyBounds = Rect::MakeWH(pageSize, pageSize);
+  pages.push_back(std::move(page));
+  return pages.back().get();
+}
+
+GlyphAtlas::Page* GlyphAtlas::findPageWithRoom(int width, int height, Point* location) {
+  removePurgedPages();
+  for (auto& page : pages) {
+    if (page->packer.addRect(width, height, location)) {
+      return lockPage(page.get()) ? page.get() : nullptr;
+    }
+  }
+  if (pages.size() < MaxPageCount) {
+    auto page = addPage();
+    if (page != nullptr && page->packer.addRect(width, height, location)) {
+      return page;
+    }
+  }
+  // All pages are full, reuse the least recently used page that is not referenced by any draw
+  // since the last flush.
+  Page* lruPage = nullptr;
+  for (auto& page : pages) {
+    if (page->lastUsedToken < currentToken &&
+        (lruPage == nullptr || page->lastUsedToken < lruPage->lastUsedToken)) {
+      lruPage = page.get();
+    }
+  }
+  if (lruPage == nullptr) {
+    return nullptr;
+  }
+  resetPage(lruPage);
+  if (!lruPage->packer.addRect(width, height, location) || !lockPage(lruPage)) {
+    return nullptr;
+  }
+  return lruPage;
+}
+
+void GlyphAtlas::removePurgedPages() {
+  auto resourceCache = context->resourceCache();
+  for (auto i = pages.size(); i > 0; i--) {
+    auto page = pages[i - 1].get();
+    // Checks the cache directly instead of locking the page, so that looking for room doesn't mark
+    // every page as recently used.
+    if (page->textureProxy == nullptr && !resourceCache->hasUniqueResource(page->textureKey)) {
+      removePage(page);
+    }
+  }
+}
+
+bool GlyphAtlas::lockPage(Page* page) {
+  if (page->textureProxy == nullptr) {
+    // Returns nullptr if the ResourceCache has purged the page texture since the last flush.
+    page->textureProxy = context->proxyProvider()->findOrWrapTextureProxy(page->textureKey);
+  }
+  return page->textureProxy != nullptr;
+}
+
+void GlyphAtlas::resetPage(Page* page) {
+  for (auto& glyphKey : page->glyphKeys) {
+    glyphMap.erase(glyphKey);
+  }
+  page->glyphKeys.clear();
+  page->packer.reset();
+  page->mask->clear();
+  page->dirtyBounds = Rect::MakeWH(pageSize, pageSize);
+}
+
+void GlyphAtlas::removePage(Page* page) {
+  for (auto& glyphKey : page->glyphKeys) {
+    glyphMap.erase(glyphKey);
+  }
+  auto result = std::find_if(pages.begin(), pages.end(),
+                             [page](const auto& item) { return item.get() == page; });
+  if (result != pages.end()) {
+    pages.erase(result);
+  }
+}
+
+bool GlyphAtlas::rasterizeGlyph(Page* page, const Font& font, GlyphID glyphID,
+                                const Point& position, bool antiAlias) {
+  auto glyphFace = GlyphFace::Wrap(font);
+  if (glyphFace == nullptr) {
+    return false;
+  }
+  GlyphRunList glyphRunList(GlyphRun(std::move(glyphFace), {glyphID}, {position}));
+  auto& mask = page->mask;
+  mask->setAntiAlias(antiAlias);
+  mask->setMatrix(Matrix::I());
+  return mask->fillText(&glyphRunList);
+}
+}  // namespace tgfx
@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "gpu/RectPacker.h"
+#include "gpu/ResourceKey.h"
+#include "gpu/proxies/TextureProxy.h"
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/Font.h"
+#include "tgfx/core/Mask.h"
+
+namespace tgfx {
+/**
+ * AtlasGlyph describes where a rasterized glyph lives inside a GlyphAtlas page.
+ */
+struct AtlasGlyph {
+  /**
+   * The texture proxy of the atlas page holding the glyph. It is nullptr if the glyph has no
+   * visible pixels, for example, a space character.
+   */
+  std::shared_ptr<TextureProxy> textureProxy = nullptr;
+
+  /**
+   * The location of the glyph mask inside the atlas page, in pixels.
+   */
+  Rect atlasRect = Rect::MakeEmpty();
+
+  /**
+   * The offset from the snapped glyph origin in device space to the top-left corner of the glyph
+   * mask.
+   */
+  Point offset = Point::Zero();
+};
+
+/**
+ * GlyphAtlas caches rasterized glyph masks in a small set of shared ALPHA_8 textures (pages), so
+ * that text can be drawn as batched textured quads instead of rasterizing and uploading a new mask
+ * for every text draw. Glyphs are keyed by typeface, device text size, faux styles, antialiasing,
+ * glyph ID and subpixel position. The page textures live in the ResourceCache under unique keys
+ * owned by the atlas. The atlas only references a page texture during the flush that draws from it,
+ * so unused pages are purged in LRU order together with all other resources, including by
+ * Context::setCacheLimit() and Context::purgeResourcesNotUsedSince(). A page whose texture has been
+ * purged is dropped along with its glyphs the next time it is looked up. Pages are also reused in
+ * LRU order once all of them are full.
+ */
+class GlyphAtlas {
+ public:
+  /**
+   * The number of subpixel positions each glyph can be rasterized at, on each axis.
+   */
+  static constexpr int SubpixelCount = 4;
+
+  /**
+   * The maximum width or height of a glyph mask that can be stored in the atlas. Larger glyphs
+   * should be drawn without the atlas.
+   */
+  static constexpr int MaxGlyphSize = 256;
+
+  explicit GlyphAtlas(Context* context);
+
+  /**
+   * Finds the glyph for the specified font, glyph ID and subpixel position, rasterizing and adding
+   * it to the atlas if it is not cached yet, and copies it to the glyph parameter. The font must
+   * already be scaled to its device size. Both subpixel values must be in the range of
+   * [0, SubpixelCount). Returns false if the glyph is too large for the atlas or if there is no
+   * room left in any page for the current flush.
+   */
+  bool findOrAddGlyph(const Font& font, GlyphID glyphID, int subpixelX, int subpixelY,
+                      bool antiAlias, AtlasGlyph* glyph);
+
+  /**
+   * Uploads the pixels of the newly added glyphs to the atlas textures and hands the page textures
+   * back to the ResourceCache. This method must be called after the page textures are created and
+   * before any draw op that samples them is executed.
+   */
+  void flush();
+
+ private:
+  struct Page {
+    UniqueKey textureKey = UniqueKey::Make();
+    // Only set while the page is used by the current flush.
+    std::shared_ptr<TextureProxy> textureProxy = nullptr;
+    std::shared_ptr<Mask> mask = nullptr;
+    RectPacker packer;
+    Rect dirtyBounds = Rect::MakeEmpty();
+    uint64_t lastUsedToken = 0;
+    std::vector<BytesKey> glyphKeys = {};
+
+    explicit Page(int size) : packer(size, size) {
+    }
+  };
+
+  struct CachedGlyph {
+    AtlasGlyph glyph = {};
+    Page* page = nullptr;
+  };
+
+  Context* context = nullptr;
+  int pageSize = 0;
+  uint64_t currentToken = 1;
+  std::vector<std::unique_ptr<Page>> pages = {};
+  BytesKeyMap<CachedGlyph> glyphMap = {};
+
+  Page* addPage();
+  Page* findPageWithRoom(int width, int height, Point* location);
+  bool lockPage(Page* page);
+  void removePurgedPages();
+  void resetPage(Page* page);
+  void removePage(Page* page);
+  bool rasterizeGlyph(Page* page, const Font& font, GlyphID glyphID, const Point& position,
+                      bool antiAlias);
+};
+}  // namespace tgfx
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "gpu/Semaphore.h"
 #include "gpu/TextureSampler.h"
 #include "tgfx/gpu/Context.h"
@@ -26,6 +27,7 @@
 namespace tgfx {
 class RenderTarget;
 class Texture;
+class GpuBuffer;
 
 class Gpu {
  public:
@@ -50,6 +52,42 @@ class Gpu {
 
   virtual void regenerateMipmapLevels(const TextureSampler* sampler) = 0;
 
+  /**
+   * Copies the data into the given buffer starting at the byte offset. The range must be within the
+   * size of the buffer.
+   */
+  virtual void writeBuffer(const GpuBuffer* buffer, size_t offset, const void* data,
+                           size_t size) = 0;
+
+  /**
+   * Inserts a fence after all commands issued so far and returns its handle. Returns 0 if fences
+   * are not supported.
+   */
+  virtual uint64_t insertFence() = 0;
+
+  /**
+   * Returns true if the GPU has finished all commands issued before the given fence. This call
+   * never blocks.
+   */
+  virtual bool checkFence(uint64_t fence) = 0;
+
+  /**
+   * Deletes the given fence.
+   */
+  virtual void deleteFence(uint64_t fence) = 0;
+
+  /**
+   * Compiles and links a program from the shader sources recorded in a ProgramManifest, and keeps
+   * it until the first draw that needs it. Returns false if the program fails to compile.
+   */
+  virtual bool precompileProgram(const std::string& vertex, const std::string& fragment) = 0;
+
+  /**
+   * Releases the backend objects owned by the Gpu itself. If releaseGPU is false, the objects are
+   * abandoned since the GPU context may no longer be current.
+   */
+  virtual void releaseAll(bool releaseGPU) = 0;
+
   virtual bool insertSemaphore(Semaphore* semaphore) = 0;
 
   virtual bool waitSemaphore(const Semaphore* semaphore) = 0;
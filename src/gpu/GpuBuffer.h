@@ -24,17 +24,38 @@ namespace tgfx {
 enum class BufferType {
   Index,
   Vertex,
+  Uniform,
+};
+
+/**
+ * Describes how often the contents of a GpuBuffer are expected to change, so the driver can place
+ * the storage where it suits the access pattern best.
+ */
+enum class BufferUsage {
+  /**
+   * The contents are written once and drawn many times.
+   */
+  Static,
+  /**
+   * The contents are rewritten repeatedly, e.g., by the streaming vertex ring of every flush.
+   */
+  Dynamic,
 };
 
 class GpuBuffer : public Resource {
  public:
   static std::shared_ptr<GpuBuffer> Make(Context* context, BufferType bufferType,
-                                         const void* buffer = nullptr, size_t size = 0);
+                                         const void* buffer = nullptr, size_t size = 0,
+                                         BufferUsage usage = BufferUsage::Static);
 
   BufferType bufferType() const {
     return _bufferType;
   }
 
+  BufferUsage usage() const {
+    return _usage;
+  }
+
   size_t size() const {
     return _size;
   }
@@ -46,9 +67,10 @@ class GpuBuffer : public Resource {
  protected:
   BufferType _bufferType;
   size_t _size;
+  BufferUsage _usage;
 
-  GpuBuffer(BufferType bufferType, size_t sizeInBytes)
-      : _bufferType(bufferType), _size(sizeInBytes) {
+  GpuBuffer(BufferType bufferType, size_t sizeInBytes, BufferUsage usage)
+      : _bufferType(bufferType), _size(sizeInBytes), _usage(usage) {
   }
 };
 }  // namespace tgfx
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpuBufferArena.h"
+#include <algorithm>
+#include "gpu/Gpu.h"
+
+namespace tgfx {
+GpuBufferArena::GpuBufferArena(Context* context, BufferType bufferType, size_t blockSize,
+                               size_t alignment)
+    : context(context), bufferType(bufferType), blockSize(blockSize),
+      alignment(std::max(alignment, static_cast<size_t>(1))) {
+}
+
+GpuBufferArena::~GpuBufferArena() {
+  releaseAll();
+}
+
+std::shared_ptr<GpuBufferRange> GpuBufferArena::allocate(const void* data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return nullptr;
+  }
+  auto allocatedSize = (size + alignment - 1) / alignment * alignment;
+  std::shared_ptr<Block> block = nullptr;
+  size_t offset = 0;
+  for (auto& item : blocks) {
+    if (Allocate(item.get(), allocatedSize, &offset)) {
+      block = item;
+      break;
+    }
+  }
+  if (block == nullptr) {
+    block = makeBlock(std::max(blockSize, allocatedSize));
+    if (block == nullptr || !Allocate(block.get(), allocatedSize, &offset)) {
+      return nullptr;
+    }
+  }
+  context->gpu()->writeBuffer(block->buffer.get(), offset, data, size);
+  return Resource::AddToCache(context,
+                              new GpuBufferRange(std::move(block), offset, size, allocatedSize));
+}
+
+void GpuBufferArena::releaseAll() {
+  for (auto& block : blocks) {
+    block->arena = nullptr;
+  }
+  blocks.clear();
+}
+
+std::shared_ptr<GpuBufferArena::Block> GpuBufferArena::makeBlock(size_t size) {
+  auto buffer = GpuBuffer::Make(context, bufferType, nullptr, size);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  auto block = std::make_shared<Block>();
+  block->arena = this;
+  block->buffer = std::move(buffer);
+  block->freeRanges[0] = size;
+  blocks.push_back(block);
+  return block;
+}
+
+void GpuBufferArena::removeBlock(Block* block) {
+  auto result = std::find_if(blocks.begin(), blocks.end(), [block](const auto& item) {
+    return item.get() == block;
+  });
+  if (result != blocks.end()) {
+    block->arena = nullptr;
+    blocks.erase(result);
+  }
+}
+
+bool GpuBufferArena::Allocate(Block* block, size_t size, size_t* offset) {
+  for (auto item = block->freeRanges.begin(); item != block->freeRanges.end(); ++item) {
+    if (item->second < size) {
+      continue;
+    }
+    *offset = item->first;
+    auto remaining = item->second - size;
+    block->freeRanges.erase(item);
+    if (remaining > 0) {
+      block->freeRanges[*offset + size] = remaining;
+    }
+    block->usedBytes += size;
+    return true;
+  }
+  return false;
+}
+
+void GpuBufferArena::Free(Block* block, size_t offset, size_t size) {
+  block->usedBytes -= size;
+  auto next = block->freeRanges.lower_bound(offset);
+  if (next != block->freeRanges.end() && offset + size == next->first) {
+    // Merge with the free range that follows.
+    size += next->second;
+    next = block->freeRanges.erase(next);
+  }
+  if (next != block->freeRanges.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      // Merge with the free range that precedes.
+      previous->second += size;
+      size = 0;
+    }
+  }
+  if (size > 0) {
+    block->freeRanges[offset] = size;
+  }
+  if (block->usedBytes == 0 && block->arena != nullptr) {
+    // Drop the empty block so that the ResourceCache can reclaim its buffer.
+    block->arena->removeBlock(block);
+  }
+}
+
+GpuBufferRange::GpuBufferRange(std::shared_ptr<GpuBufferArena::Block> block, size_t offset,
+                               size_t size, size_t allocatedSize)
+    : block(std::move(block)), _offset(offset), _size(size), allocatedSize(allocatedSize) {
+  auto& ranges = this->block->ranges;
+  blockPosition = ranges.insert(ranges.end(), this);
+}
+
+GpuBufferRange::~GpuBufferRange() {
+  block->ranges.erase(blockPosition);
+  GpuBufferArena::Free(block.get(), _offset, allocatedSize);
+}
+
+void GpuBufferRange::collectPurgeGroup(std::vector<Resource*>* group) const {
+  for (auto* range : block->ranges) {
+    if (range != this) {
+      group->push_back(range);
+    }
+  }
+}
+}  // namespace tgfx
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <vector>
+#include "gpu/GpuBuffer.h"
+
+namespace tgfx {
+class GpuBufferRange;
+
+/**
+ * GpuBufferArena packs long-lived buffer data, such as the triangles of cached shapes, into a few
+ * large shared GpuBuffers instead of creating a buffer object for each of them. Every block keeps
+ * a free list sorted by offset, where adjacent ranges are merged as soon as they are returned, so
+ * the space freed by evicted shapes can be reused by larger ones. The blocks are regular resources
+ * in the ResourceCache and are counted against its budget as a whole, while the ranges carry the
+ * unique keys of the data. A block is dropped once its last range is released.
+ *
+ * Since the bytes of a block are only returned once every range in it is gone, the ResourceCache
+ * purges blocks as a whole: evicting the least recently used range also evicts the other purgeable
+ * ranges of its block, so a block is never kept alive by a few stale ranges while the cache is over
+ * its budget. Only the ranges still used by pending draws can keep a block alive.
+ */
+class GpuBufferArena {
+ public:
+  /**
+   * The default size of each block, in bytes. Data larger than that gets a block of its own.
+   */
+  static constexpr size_t DefaultBlockSize = 1 << 20;
+
+  /**
+   * The default alignment of each range, which satisfies all vertex attribute types.
+   */
+  static constexpr size_t DefaultAlignment = 16;
+
+  GpuBufferArena(Context* context, BufferType bufferType, size_t blockSize = DefaultBlockSize,
+                 size_t alignment = DefaultAlignment);
+
+  ~GpuBufferArena();
+
+  /**
+   * Copies the data into a free range of the shared blocks and returns the range, which is added
+   * to the ResourceCache. Returns nullptr if the data is empty or the buffer could not be created.
+   */
+  std::shared_ptr<GpuBufferRange> allocate(const void* data, size_t size);
+
+  /**
+   * Returns the number of blocks currently held by the arena.
+   */
+  size_t blockCount() const {
+    return blocks.size();
+  }
+
+  /**
+   * Detaches all blocks from the arena. The ranges still alive keep their blocks until they are
+   * released by the ResourceCache.
+   */
+  void releaseAll();
+
+ private:
+  struct Block {
+    GpuBufferArena* arena = nullptr;
+    std::shared_ptr<GpuBuffer> buffer = nullptr;
+    // Maps the offset of each free range to its size.
+    std::map<size_t, size_t> freeRanges = {};
+    size_t usedBytes = 0;
+    std::list<GpuBufferRange*> ranges = {};
+  };
+
+  Context* context = nullptr;
+  BufferType bufferType = BufferType::Vertex;
+  size_t blockSize = DefaultBlockSize;
+  size_t alignment = DefaultAlignment;
+  std::vector<std::shared_ptr<Block>> blocks = {};
+
+  std::shared_ptr<Block> makeBlock(size_t size);
+
+  void removeBlock(Block* block);
+
+  static bool Allocate(Block* block, size_t size, size_t* offset);
+
+  static void Free(Block* block, size_t offset, size_t size);
+
+  friend class GpuBufferRange;
+};
+
+/**
+ * GpuBufferRange references the bytes of a GpuBufferArena block holding one piece of data. It
+ * reports no memory usage of its own since the block is already counted by the ResourceCache, and
+ * returns its bytes to the block when destroyed. The ranges of a block form one purge group in the
+ * ResourceCache, and releasing the last of them releases the block, which is when the memory
+ * actually gets freed.
+ */
+class GpuBufferRange : public Resource {
+ public:
+  ~GpuBufferRange() override;
+
+  /**
+   * Returns the shared GpuBuffer holding the data.
+   */
+  const std::shared_ptr<GpuBuffer>& buffer() const {
+    return block->buffer;
+  }
+
+  /**
+   * Returns the byte offset of the data in the buffer.
+   */
+  size_t offset() const {
+    return _offset;
+  }
+
+  /**
+   * Returns the size of the data in bytes.
+   */
+  size_t size() const {
+    return _size;
+  }
+
+  size_t memoryUsage() const override {
+    return 0;
+  }
+
+ protected:
+  void onReleaseGPU() override {
+  }
+
+ private:
+  std::shared_ptr<GpuBufferArena::Block> block = nullptr;
+  size_t _offset = 0;
+  size_t _size = 0;
+  size_t allocatedSize = 0;
+  std::list<GpuBufferRange*>::iterator blockPosition;
+
+  GpuBufferRange(std::shared_ptr<GpuBufferArena::Block> block, size_t offset, size_t size,
+                 size_t allocatedSize);
+
+  void collectPurgeGroup(std::vector<Resource*>* group) const override;
+
+  friend class GpuBufferArena;
+};
+}  // namespace tgfx
@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ImageAtlas.h"
+#include <algorithm>
+#include "core/images/ResourceImage.h"
+#include "core/utils/Log.h"
+#include "gpu/Pipeline.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/Quad.h"
+#include "gpu/processors/DefaultGeometryProcessor.h"
+#include "gpu/processors/TextureEffect.h"
+#include "tgfx/core/RenderFlags.h"
+
+namespace tgfx {
+/**
+ * The default width and height of an atlas page. A page of RGBA_8888 pixels costs 4MB of GPU
+ * memory.
+ */
+static constexpr int DefaultPageSize = 1024;
+
+/**
+ * The maximum number of pages of each pixel format the atlas can allocate before it starts to
+ * reuse old pages.
+ */
+static constexpr size_t MaxPageCount = 4;
+
+/**
+ * The number of pixels around each image filled with its edge pixels. The antialiasing outset of a
+ * draw is half a device pixel, which spans one image pixel at ImageAtlas::MinAntiAliasScale, and
+ * the linear sampling reads another half pixel beyond that.
+ */
+static constexpr int ImagePadding = 2;
+
+ImageAtlas::ImageAtlas(Context* context) : context(context) {
+  pageSize = std::min(DefaultPageSize, context->caps()->maxTextureSize);
+}
+
+void ImageAtlas::setMaxImageSize(int size) {
+  _maxImageSize = std::max(size, 0);
+}
+
+bool ImageAtlas::IsStaticResourceImage(const Image* image) {
+  switch (image->type()) {
+    case Image::Type::Buffer:
+    case Image::Type::Codec:
+    case Image::Type::Decoded:
+    case Image::Type::Generator:
+    case Image::Type::Rasterized:
+      return true;
+    default:
+      // Texture images may wrap textures whose content changes, and mipmap images need their own
+      // mipmap levels.
+      return false;
+  }
+}
+
+bool ImageAtlas::findOrAddImage(const Image* image, uint32_t renderFlags, AtlasImage* atlasImage) {
+  DEBUG_ASSERT(image != nullptr);
+  DEBUG_ASSERT(atlasImage != nullptr);
+  if (pageSize <= 0 || renderFlags & RenderFlags::DisableCache ||
+      !IsStaticResourceImage(image) || image->hasMipmaps()) {
+    return false;
+  }
+  auto width = image->width();
+  auto height = image->height();
+  if (width > _maxImageSize || height > _maxImageSize) {
+    return false;
+  }
+  auto imageKey = static_cast<const ResourceImage*>(image)->uniqueKey.domainID();
+  auto result = imageMap.find(imageKey);
+  if (result != imageMap.end()) {
+    auto& cachedImage = result->second;
+    auto page = cachedImage.page;
+    if (lockPage(page)) {
+      page->lastUsedToken = currentToken;
+      *atlasImage = cachedImage.image;
+      atlasImage->textureProxy = page->textureProxy;
+      return true;
+    }
+    // The ResourceCache has purged the page texture, copy the image again.
+    removePage(page);
+  }
+  auto format = image->isAlphaOnly() ? PixelFormat::ALPHA_8 : PixelFormat::RGBA_8888;
+  if (!context->caps()->isFormatRenderable(format)) {
+    return false;
+  }
+  auto source = image->lockTextureProxy(TPArgs(context, renderFlags, false));
+  if (source == nullptr) {
+    return false;
+  }
+  auto location = Point::Zero();
+  auto page =
+      findPageWithRoom(format, width + ImagePadding * 2, height + ImagePadding * 2, &location);
+  if (page == nullptr) {
+    return false;
+  }
+  auto padding = static_cast<float>(ImagePadding);
+  auto bounds = Rect::MakeXYWH(location.x + padding, location.y + padding,
+                               static_cast<float>(width), static_cast<float>(height));
+  page->pendingCopies.push_back({imageKey, std::move(source), bounds});
+  page->lastUsedToken = currentToken;
+  page->imageKeys.push_back(imageKey);
+  auto& cachedImage = imageMap[imageKey];
+  cachedImage.page = page;
+  cachedImage.image.location = Point::Make(bounds.left, bounds.top);
+  *atlasImage = cachedImage.image;
+  atlasImage->textureProxy = page->textureProxy;
+  return true;
+}
+
+void ImageAtlas::flush(RenderPass* renderPass) {
+  for (auto& page : pages) {
+    if (page->textureProxy == nullptr) {
+      continue;
+    }
+    if (!page->pendingCopies.empty()) {
+      copyPendingImages(renderPass, page.get());
+    }
+    // Hand the texture back to the ResourceCache. The draw ops of this flush still reference it,
+    // after that it stays in the cache under the page key until it is purged.
+    page->textureProxy = nullptr;
+  }
+  currentToken++;
+}
+
+ImageAtlas::Page* ImageAtlas::addPage(PixelFormat format) {
+  auto page = std::make_unique<Page>(format, pageSize);
+  page->textureProxy = context->proxyProvider()->createTextureProxy(page->textureKey, pageSize,
+                                                                    pageSize, format);
+  if (page->textureProxy == nullptr) {
+    return nullptr;
+  }
+  pages.push_back(std::move(page));
+  return pages.back().get();
+}
+
+ImageAtlas::Page* ImageAtlas::findPageWithRoom(PixelFormat format, int width, int height,
+                                               Point* location) {
+  removePurgedPages();
+  size_t pageCount = 0;
+  for (auto& page : pages) {
+    if (page->format != format) {
+      continue;
+    }
+    pageCount++;
+    if (page->packer.addRect(width, height, location)) {
+      return lockPage(page.get()) ? page.get() : nullptr;
+    }
+  }
+  if (pageCount < MaxPageCount) {
+    auto page = addPage(format);
+    if (page != nullptr && page->packer.addRect(width, height, location)) {
+      return page;
+    }
+  }
+  // All pages are full, reuse the least recently used page that is not referenced by any draw
+  // since the last flush.
+  Page* lruPage = nullptr;
+  for (auto& page : pages) {
+    if (page->format == format && page->lastUsedToken < currentToken &&
+        (lruPage == nullptr || page->lastUsedToken < lruPage->lastUsedToken)) {
+      lruPage = page.get();
+    }
+  }
+  if (lruPage == nullptr) {
+    return nullptr;
+  }
+  resetPage(lruPage);
+  if (!lruPage->packer.addRect(width, height, location) || !lockPage(lruPage)) {
+    return nullptr;
+  }
+  return lruPage;
+}
+
+void ImageAtlas::removePurgedPages() {
+  auto resourceCache = context->resourceCache();
+  for (auto i = pages.size(); i > 0; i--) {
+    auto page = pages[i - 1].get();
+    // Checks the cache directly instead of locking the page, so that looking for room doesn't mark
+    // every page as recently used.
+    if (page->textureProxy == nullptr && !resourceCache->hasUniqueResource(page->textureKey)) {
+      removePage(page);
+    }
+  }
+}
+
+bool ImageAtlas::lockPage(Page* page) {
+  if (page->textureProxy == nullptr) {
+    // Returns nullptr if the ResourceCache has purged the page texture since the last flush.
+    page->textureProxy = context->proxyProvider()->findOrWrapTextureProxy(page->textureKey);
+  }
+  return page->textureProxy != nullptr;
+}
+
+void ImageAtlas::resetPage(Page* page) {
+  for (auto& imageKey : page->imageKeys) {
+    imageMap.erase(imageKey);
+  }
+  page->imageKeys.clear();
+  page->pendingCopies.clear();
+  page->packer.reset();
+}
+
+void ImageAtlas::removePage(Page* page) {
+  for (auto& imageKey : page->imageKeys) {
+    imageMap.erase(imageKey);
+  }
+  auto result = std::find_if(pages.begin(), pages.end(),
+                             [page](const auto& item) { return item.get() == page; });
+  if (result != pages.end()) {
+    pages.erase(result);
+  }
+}
+
+void ImageAtlas::copyPendingImages(RenderPass* renderPass, Page* page) {
+  auto pendingCopies = std::move(page->pendingCopies);
+  page->pendingCopies = {};
+  auto texture = page->textureProxy->getTexture();
+  // The render target is only created for the flushes that copy new images, keeping nothing but
+  // the page texture in the ResourceCache between flushes.
+  auto renderTarget = texture != nullptr ? RenderTarget::MakeFrom(texture.get()) : nullptr;
+  if (renderTarget == nullptr || !renderPass->begin(renderTarget, texture)) {
+    LOGE("ImageAtlas::copyPendingImages() Failed to initialize the render pass!");
+    for (auto& copy : pendingCopies) {
+      imageMap.erase(copy.imageKey);
+    }
+    return;
+  }
+  auto width = renderTarget->width();
+  auto height = renderTarget->height();
+  const auto& swizzle = context->caps()->getWriteSwizzle(page->format);
+  auto padding = static_cast<float>(ImagePadding);
+  for (auto& copy : pendingCopies) {
+    auto drawBounds = copy.bounds;
+    drawBounds.outset(padding, padding);
+    if (copy.source->getTexture() == nullptr) {
+      // The image failed to decode or upload, leave a transparent hole and drop the entry so that
+      // the image can be added again later.
+      renderPass->clear(drawBounds, Color::Transparent());
+      imageMap.erase(copy.imageKey);
+      continue;
+    }
+    std::vector<std::unique_ptr<FragmentProcessor>> fragmentProcessors = {};
+    fragmentProcessors.push_back(TextureEffect::Make(std::move(copy.source)));
+    // The padding area maps outside the image, where the clamped sampling repeats the edge pixels.
+    auto uvMatrix = Matrix::MakeTrans(-copy.bounds.left, -copy.bounds.top);
+    auto geometryProcessor = DefaultGeometryProcessor::Make(Color::White(), width, height,
+                                                            AAType::None, Matrix::I(), uvMatrix);
+    auto pipeline =
+        std::make_unique<Pipeline>(std::move(geometryProcessor), std::move(fragmentProcessors), 1,
+                                   nullptr, BlendMode::Src, &swizzle);
+    auto quad = Quad::MakeFrom(drawBounds);
+    renderPass->bindProgramAndScissorClip(pipeline.get(), Rect::MakeEmpty());
+    renderPass->bindBuffers(nullptr, quad.toTriangleStrips());
+    renderPass->draw(PrimitiveType::TriangleStrip, 0, 4);
+  }
+  renderPass->end();
+}
+}  // namespace tgfx
@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "gpu/RectPacker.h"
+#include "gpu/RenderPass.h"
+#include "gpu/proxies/TextureProxy.h"
+#include "tgfx/core/Image.h"
+
+namespace tgfx {
+/**
+ * AtlasImage describes where an image lives inside an ImageAtlas page.
+ */
+struct AtlasImage {
+  /**
+   * The texture proxy of the atlas page holding the image.
+   */
+  std::shared_ptr<TextureProxy> textureProxy = nullptr;
+
+  /**
+   * The location of the top-left corner of the image inside the atlas page, in pixels.
+   */
+  Point location = Point::Zero();
+};
+
+/**
+ * ImageAtlas copies small images into a few shared textures (pages), so that consecutive draws of
+ * different images can sample the same texture and be merged into a single draw call. The images
+ * are keyed by the UniqueKey of their textures, and copied into the pages on the GPU at the next
+ * flush, after their own textures are ready. Each image is surrounded by a copy of its edge pixels,
+ * so sampling near the edges gives the same result as the clamped sampling of a standalone
+ * texture. Alpha-only images go into ALPHA_8 pages and all others into RGBA_8888 pages. The page
+ * textures live in the ResourceCache under unique keys owned by the atlas, which only references a
+ * page texture during the flush that draws from it, so unused pages are purged in LRU order
+ * together with all other resources. A page whose texture has been purged is dropped along with
+ * its images the next time it is looked up. Pages are also reused in LRU order once all of them are
+ * full.
+ */
+class ImageAtlas {
+ public:
+  /**
+   * The default maximum width or height of an image that can be stored in the atlas.
+   */
+  static constexpr int DefaultMaxImageSize = 128;
+
+  /**
+   * The minimum scale of an antialiased draw from the atlas. The edge padding of the images only
+   * covers the antialiasing outset of the draws at or above this scale.
+   */
+  static constexpr float MinAntiAliasScale = 0.5f;
+
+  explicit ImageAtlas(Context* context);
+
+  /**
+   * Returns the maximum width or height of an image that can be stored in the atlas.
+   */
+  int maxImageSize() const {
+    return _maxImageSize;
+  }
+
+  /**
+   * Sets the maximum width or height of an image that can be stored in the atlas. Images already
+   * in the atlas are kept. Setting it to 0 disables the atlas.
+   */
+  void setMaxImageSize(int size);
+
+  /**
+   * Finds the atlas entry for the image, adding it to the atlas if it is not cached yet, and copies
+   * it to the atlasImage parameter. Returns false if the image can not be stored in the atlas, for
+   * example, if it is too large, has mipmaps or its content may change, or if there is no room left
+   * in any page for the current flush.
+   */
+  bool findOrAddImage(const Image* image, uint32_t renderFlags, AtlasImage* atlasImage);
+
+  /**
+   * Copies the images added since the last flush into the atlas pages and hands the page textures
+   * back to the ResourceCache. This method must be called after the textures of the images are
+   * created and before any draw op that samples the pages is executed.
+   */
+  void flush(RenderPass* renderPass);
+
+ private:
+  struct PendingCopy {
+    uint32_t imageKey = 0;
+    std::shared_ptr<TextureProxy> source = nullptr;
+    Rect bounds = Rect::MakeEmpty();
+  };
+
+  struct Page {
+    PixelFormat format = PixelFormat::RGBA_8888;
+    UniqueKey textureKey = UniqueKey::Make();
+    // Only set while the page is used by the current flush.
+    std::shared_ptr<TextureProxy> textureProxy = nullptr;
+    RectPacker packer;
+    uint64_t lastUsedToken = 0;
+    std::vector<uint32_t> imageKeys = {};
+    std::vector<PendingCopy> pendingCopies = {};
+
+    Page(PixelFormat format, int size) : format(format), packer(size, size) {
+    }
+  };
+
+  struct CachedImage {
+    AtlasImage image = {};
+    Page* page = nullptr;
+  };
+
+  Context* context = nullptr;
+  int pageSize = 0;
+  int _maxImageSize = DefaultMaxImageSize;
+  uint64_t currentToken = 1;
+  std::vector<std::unique_ptr<Page>> pages = {};
+  std::unordered_map<uint32_t, CachedImage> imageMap = {};
+
+  static bool IsStaticResourceImage(const Image* image);
+
+  Page* addPage(PixelFormat format);
+  Page* findPageWithRoom(PixelFormat format, int width, int height, Point* location);
+  bool lockPage(Page* page);
+  void removePurgedPages();
+  void resetPage(Page* page);
+  void removePage(Page* page);
+  void copyPendingImages(RenderPass* renderPass, Page* page);
+};
+}  // namespace tgfx
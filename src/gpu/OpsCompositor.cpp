@@ -27,8 +27,11 @@
 #include "gpu/ops/DstTextureCopyOp.h"
 #include "gpu/ops/ResolveOp.h"
 #include "gpu/ops/ShapeDrawOp.h"
+#include "gpu/ops/StencilClipOp.h"
+#include "gpu/processors/AARRectEffect.h"
 #include "gpu/processors/AARectEffect.h"
 #include "gpu/processors/DeviceSpaceTextureEffect.h"
+#include "gpu/processors/TextureEffect.h"
 #include "processors/PorterDuffXferProcessor.h"
 
 namespace tgfx {
@@ -40,6 +43,22 @@ namespace tgfx {
  */
 static constexpr float BOUNDS_TOLERANCE = 1e-3f;
 
+/**
+ * The maximum number of pending batches a new draw can look back over to find a compatible batch.
+ * When the window is full, the oldest batch is turned into a DrawOp.
+ */
+static constexpr size_t MAX_PENDING_BATCHES = 8;
+
+/**
+ * Returns true if the given rect counts as aligned with pixel boundaries.
+ */
+static bool IsPixelAligned(const Rect& rect) {
+  return fabsf(roundf(rect.left) - rect.left) <= BOUNDS_TOLERANCE &&
+         fabsf(roundf(rect.top) - rect.top) <= BOUNDS_TOLERANCE &&
+         fabsf(roundf(rect.right) - rect.right) <= BOUNDS_TOLERANCE &&
+         fabsf(roundf(rect.bottom) - rect.bottom) <= BOUNDS_TOLERANCE;
+}
+
 OpsCompositor::OpsCompositor(DrawingManager* drawingManager,
                              std::shared_ptr<RenderTargetProxy> proxy, uint32_t renderFlags)
     : drawingManager(drawingManager), renderTarget(std::move(proxy)), renderFlags(renderFlags) {
@@ -52,30 +71,45 @@ void OpsCompositor::fillImage(std::shared_ptr<Image> image, const Rect& rect,
                               const Fill& fill) {
   DEBUG_ASSERT(image != nullptr);
   DEBUG_ASSERT(!rect.isEmpty());
-  if (!canAppend(PendingOpType::Image, state.clip, fill) || pendingImage != image ||
-      pendingSampling != sampling) {
-    flushPendingOps(PendingOpType::Image, state.clip, fill);
-    pendingImage = std::move(image);
-    pendingSampling = sampling;
-  }
-  pendingRects.emplace_back(rect, state.matrix, fill.color.premultiply());
+  auto bounds = state.matrix.mapRect(rect);
+  auto batch =
+      getPendingBatch(PendingOpType::Image, state.clip, fill, bounds, image.get(), sampling);
+  if (batch->image == nullptr) {
+    batch->image = std::move(image);
+    batch->sampling = sampling;
+  }
+  batch->rects.emplace_back(rect, state.matrix, fill.color.premultiply());
+}
+
+void OpsCompositor::fillTexture(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
+                                const SamplingOptions& sampling, const MCState& state,
+                                const Fill& fill) {
+  DEBUG_ASSERT(textureProxy != nullptr);
+  DEBUG_ASSERT(!rect.isEmpty());
+  auto bounds = state.matrix.mapRect(rect);
+  auto batch = getPendingBatch(PendingOpType::Texture, state.clip, fill, bounds,
+                               textureProxy.get(), sampling);
+  if (batch->texture == nullptr) {
+    batch->texture = std::move(textureProxy);
+    batch->sampling = sampling;
+  }
+  batch->pixelAligned = batch->pixelAligned && state.matrix.isTranslate() && IsPixelAligned(bounds);
+  batch->rects.emplace_back(rect, state.matrix, fill.color.premultiply());
 }
 
 void OpsCompositor::fillRect(const Rect& rect, const MCState& state, const Fill& fill) {
   DEBUG_ASSERT(!rect.isEmpty());
-  if (!canAppend(PendingOpType::Rect, state.clip, fill)) {
-    flushPendingOps(PendingOpType::Rect, state.clip, fill);
-  }
-  pendingRects.emplace_back(rect, state.matrix, fill.color.premultiply());
+  auto bounds = state.matrix.mapRect(rect);
+  auto batch = getPendingBatch(PendingOpType::Rect, state.clip, fill, bounds);
+  batch->rects.emplace_back(rect, state.matrix, fill.color.premultiply());
 }
 
 void OpsCompositor::fillRRect(const RRect& rRect, const MCState& state, const Fill& fill) {
   DEBUG_ASSERT(!rRect.rect.isEmpty());
   auto rectFill = fill.makeWithMatrix(state.matrix);
-  if (!canAppend(PendingOpType::RRect, state.clip, rectFill)) {
-    flushPendingOps(PendingOpType::RRect, state.clip, rectFill);
-  }
-  pendingRRects.emplace_back(rRect, state.matrix, rectFill.color.premultiply());
+  auto bounds = state.matrix.mapRect(rRect.rect);
+  auto batch = getPendingBatch(PendingOpType::RRect, state.clip, rectFill, bounds);
+  batch->rRects.emplace_back(rRect, state.matrix, rectFill.color.premultiply());
 }
 
 static Rect ToLocalBounds(const Rect& bounds, const Matrix& viewMatrix) {
@@ -104,7 +138,11 @@ void OpsCompositor::fillShape(std::shared_ptr<Shape> shape, const MCState& state
   if (maxScale <= 0.0f) {
     return;
   }
-  flushPendingOps();
+  auto& clip = state.clip;
+  auto batchable = canBatchShape(clip, fill);
+  if (!batchable) {
+    flushPendingOps();
+  }
   auto uvMatrix = Matrix::I();
   if (!state.matrix.invert(&uvMatrix)) {
     return;
@@ -112,7 +150,6 @@ void OpsCompositor::fillShape(std::shared_ptr<Shape> shape, const MCState& state
   auto localBounds = Rect::MakeEmpty();
   auto deviceBounds = Rect::MakeEmpty();
   auto [needLocalBounds, needDeviceBounds] = needComputeBounds(fill);
-  auto& clip = state.clip;
   auto clipBounds = getClipBounds(clip);
   if (needLocalBounds) {
     if (shape->isInverseFillType()) {
@@ -129,6 +166,14 @@ void OpsCompositor::fillShape(std::shared_ptr<Shape> shape, const MCState& state
   auto aaType = getAAType(fill);
   auto proxyProvider = renderTarget->getContext()->proxyProvider();
   auto shapeProxy = proxyProvider->createGpuShapeProxy(shape, aaType, clipBounds, renderFlags);
+  if (batchable) {
+    if (shapeProxy != nullptr) {
+      auto bounds = shape->isInverseFillType() ? clipBounds : shape->getBounds();
+      auto batch = getPendingBatch(PendingOpType::Shape, clip, fill, bounds);
+      batch->shapes.emplace_back(std::move(shapeProxy), fill.color.premultiply(), uvMatrix);
+    }
+    return;
+  }
   auto drawOp =
       ShapeDrawOp::Make(std::move(shapeProxy), fill.color.premultiply(), uvMatrix, aaType);
   addDrawOp(std::move(drawOp), clip, fill, localBounds, deviceBounds);
@@ -136,15 +181,8 @@ void OpsCompositor::fillShape(std::shared_ptr<Shape> shape, const MCState& state
 
 void OpsCompositor::discardAll() {
   ops.clear();
-  if (pendingType != PendingOpType::Unknown) {
-    pendingType = PendingOpType::Unknown;
-    pendingClip = {};
-    pendingFill = {};
-    pendingImage = nullptr;
-    pendingSampling = {};
-    pendingRects.clear();
-    pendingRRects.clear();
-  }
+  pendingBatches.clear();
+  stencilClipKey = {};
 }
 
 static bool CompareFill(const Fill& a, const Fill& b) {
@@ -172,40 +210,91 @@ static bool CompareFill(const Fill& a, const Fill& b) {
   return true;
 }
 
-bool OpsCompositor::canAppend(PendingOpType type, const Path& clip, const Fill& fill) const {
-  if (pendingType != type || !pendingClip.isSame(clip) || !CompareFill(pendingFill, fill)) {
+bool OpsCompositor::canAppend(const PendingBatch& batch, PendingOpType type, const ClipStack& clip,
+                              const Fill& fill) const {
+  if (batch.type != type || !batch.clip.isSame(clip) || !CompareFill(batch.fill, fill)) {
     return false;
   }
-  switch (pendingType) {
+  auto instanced = renderTarget->getContext()->caps()->instancedDrawSupport;
+  switch (batch.type) {
     case PendingOpType::Rect:
+    case PendingOpType::Image:
+    case PendingOpType::Texture:
+      if (instanced) {
+        return batch.rects.size() < RectDrawOp::MaxNumInstancedRects;
+      }
       if (fill.antiAlias) {
-        return pendingRects.size() < RectDrawOp::MaxNumAARects;
+        return batch.rects.size() < RectDrawOp::MaxNumAARects;
       }
-      return pendingRects.size() < RectDrawOp::MaxNumNonAARects;
+      return batch.rects.size() < RectDrawOp::MaxNumNonAARects;
     case PendingOpType::RRect:
-      return pendingRRects.size() < RRectDrawOp::MaxNumRRects;
+      if (instanced) {
+        return batch.rRects.size() < RRectDrawOp::MaxNumInstancedRRects;
+      }
+      return batch.rRects.size() < RRectDrawOp::MaxNumRRects;
     default:
       break;
   }
   return true;
 }
 
-void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
-  if (pendingType == PendingOpType::Unknown) {
-    if (type != PendingOpType::Unknown) {
-      pendingType = type;
-      pendingClip = clip;
-      pendingFill = fill;
+PendingBatch* OpsCompositor::getPendingBatch(PendingOpType type, const ClipStack& clip,
+                                             const Fill& fill, const Rect& bounds,
+                                             const void* source, const SamplingOptions& sampling) {
+  // Outset the bounds to cover the antialiasing ramps and rounding errors.
+  auto deviceBounds = bounds;
+  deviceBounds.outset(1.0f, 1.0f);
+  // Look back for a compatible batch. The draw can join an earlier batch only if none of the
+  // batches recorded after that one overlap it, since it will be drawn before them.
+  for (auto i = pendingBatches.size(); i-- > 0;) {
+    auto& batch = pendingBatches[i];
+    auto batchSource = batch.image ? static_cast<const void*>(batch.image.get())
+                                   : static_cast<const void*>(batch.texture.get());
+    if (batchSource == source && batch.sampling == sampling &&
+        canAppend(batch, type, clip, fill)) {
+      if (i + 1 < pendingBatches.size()) {
+        mergeStats.mergedOps++;
+        if (pendingBatches.back().type != type) {
+          mergeStats.savedProgramSwitches++;
+        }
+      }
+      batch.bounds.join(deviceBounds);
+      return &batch;
+    }
+    if (batch.bounds.intersects(deviceBounds)) {
+      break;
     }
-    return;
   }
-  std::swap(pendingType, type);
-  std::swap(pendingClip, clip);
-  std::swap(pendingFill, fill);
+  if (pendingBatches.size() >= MAX_PENDING_BATCHES) {
+    auto batch = std::move(pendingBatches.front());
+    pendingBatches.pop_front();
+    flushPendingBatch(batch);
+  }
+  auto& batch = pendingBatches.emplace_back();
+  batch.type = type;
+  batch.clip = clip;
+  batch.fill = fill;
+  batch.bounds = deviceBounds;
+  return &batch;
+}
+
+void OpsCompositor::flushPendingOps() {
+  while (!pendingBatches.empty()) {
+    auto batch = std::move(pendingBatches.front());
+    pendingBatches.pop_front();
+    flushPendingBatch(batch);
+  }
+}
+
+void OpsCompositor::flushPendingBatch(PendingBatch& batch) {
+  auto type = batch.type;
+  auto& clip = batch.clip;
+  auto& fill = batch.fill;
   std::unique_ptr<DrawOp> drawOp = nullptr;
   auto localBounds = Rect::MakeEmpty();
   auto deviceBounds = Rect::MakeEmpty();
-  auto [needLocalBounds, needDeviceBounds] = needComputeBounds(fill, type == PendingOpType::Image);
+  auto hasTextureFill = type == PendingOpType::Image || type == PendingOpType::Texture;
+  auto [needLocalBounds, needDeviceBounds] = needComputeBounds(fill, hasTextureFill);
   auto context = renderTarget->getContext();
   auto aaType = getAAType(fill);
   auto clipBounds = Rect::MakeEmpty();
@@ -214,33 +303,39 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
   }
   switch (type) {
     case PendingOpType::Rect:
-      if (pendingRects.size() == 1) {
-        auto& paint = pendingRects.front();
+      if (batch.rects.size() == 1) {
+        auto& paint = batch.rects.front();
         if (drawAsClear(paint.rect, {paint.viewMatrix, clip}, fill)) {
-          pendingRects.clear();
           return;
         }
       }
     // fallthrough
     case PendingOpType::Image:
-      drawOp = RectDrawOp::Make(context, pendingRects, needLocalBounds, aaType, renderFlags);
+    case PendingOpType::Texture: {
+      // Pixel-aligned quads have no partially covered edges, skip the coverage antialiasing for
+      // them. The clip still uses the antialiasing of the fill.
+      auto rectAAType = aaType;
+      if (batch.pixelAligned && aaType == AAType::Coverage) {
+        rectAAType = AAType::None;
+      }
+      drawOp = RectDrawOp::Make(context, batch.rects, needLocalBounds, rectAAType, renderFlags);
       if (needLocalBounds) {
-        for (auto& rect : pendingRects) {
+        for (auto& rect : batch.rects) {
           localBounds.join(ClipLocalBounds(rect.rect, rect.viewMatrix, clipBounds));
         }
       }
       if (needDeviceBounds) {
-        for (auto& rectPaint : pendingRects) {
+        for (auto& rectPaint : batch.rects) {
           auto rect = rectPaint.viewMatrix.mapRect(rectPaint.rect);
           deviceBounds.join(rect);
         }
       }
-      pendingRects.clear();
       break;
+    }
     case PendingOpType::RRect:
-      drawOp = RRectDrawOp::Make(context, pendingRRects, aaType, renderFlags);
+      drawOp = RRectDrawOp::Make(context, batch.rRects, aaType, renderFlags);
       if (needLocalBounds || needDeviceBounds) {
-        for (auto& rRectPaint : pendingRRects) {
+        for (auto& rRectPaint : batch.rRects) {
           auto rect = rRectPaint.viewMatrix.mapRect(rRectPaint.rRect.rect);
           deviceBounds.join(rect);
         }
@@ -249,7 +344,10 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
           localBounds = Rect::MakeEmpty();
         }
       }
-      pendingRRects.clear();
+      break;
+    case PendingOpType::Shape:
+      // Batched shapes have a plain color fill, so neither local nor device bounds are needed.
+      drawOp = ShapeDrawOp::Make(context, std::move(batch.shapes), aaType, renderFlags);
       break;
     default:
       break;
@@ -257,7 +355,13 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
 
   if (type == PendingOpType::Image) {
     FPArgs args = {renderTarget->getContext(), renderFlags, localBounds};
-    auto processor = FragmentProcessor::Make(std::move(pendingImage), args, pendingSampling);
+    auto processor = FragmentProcessor::Make(std::move(batch.image), args, batch.sampling);
+    if (processor == nullptr) {
+      return;
+    }
+    drawOp->addColorFP(std::move(processor));
+  } else if (type == PendingOpType::Texture) {
+    auto processor = TextureEffect::Make(std::move(batch.texture), batch.sampling);
     if (processor == nullptr) {
       return;
     }
@@ -266,16 +370,6 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
   addDrawOp(std::move(drawOp), clip, fill, localBounds, deviceBounds);
 }
 
-/**
- * Returns true if the given rect counts as aligned with pixel boundaries.
- */
-static bool IsPixelAligned(const Rect& rect) {
-  return fabsf(roundf(rect.left) - rect.left) <= BOUNDS_TOLERANCE &&
-         fabsf(roundf(rect.top) - rect.top) <= BOUNDS_TOLERANCE &&
-         fabsf(roundf(rect.right) - rect.right) <= BOUNDS_TOLERANCE &&
-         fabsf(roundf(rect.bottom) - rect.bottom) <= BOUNDS_TOLERANCE;
-}
-
 static void FlipYIfNeeded(Rect* rect, std::shared_ptr<RenderTargetProxy> renderTarget) {
   if (renderTarget->origin() == ImageOrigin::BottomLeft) {
     auto height = rect->height();
@@ -288,6 +382,20 @@ static bool HasColorOnly(const Fill& fill) {
   return !fill.shader && !fill.maskFilter && !fill.colorFilter;
 }
 
+bool OpsCompositor::canBatchShape(const ClipStack& clip, const Fill& fill) {
+  // Shapes in a batch share one pipeline, so only a plain color fill and a clip that requires no
+  // fragment processor are allowed.
+  if (!renderTarget->getContext()->caps()->instancedDrawSupport || !HasColorOnly(fill) ||
+      !BlendModeAsCoeff(fill.blendMode)) {
+    return false;
+  }
+  if (clip.isWideOpen()) {
+    return true;
+  }
+  auto [rect, useScissor] = getClipRect(clip);
+  return rect.has_value() && (useScissor || rect->isEmpty());
+}
+
 bool OpsCompositor::drawAsClear(const Rect& rect, const MCState& state, const Fill& fill) {
   if (!HasColorOnly(fill) || !fill.isOpaque() || !state.matrix.rectStaysRect()) {
     return false;
@@ -295,12 +403,8 @@ bool OpsCompositor::drawAsClear(const Rect& rect, const MCState& state, const Fi
   auto deviceBounds = renderTarget->bounds();
   auto& clip = state.clip;
   auto clipRect = Rect::MakeEmpty();
-  if (clip.isInverseFillType()) {
-    if (clip.isEmpty()) {
-      clipRect = deviceBounds;
-    } else {
-      return false;
-    }
+  if (clip.isWideOpen()) {
+    clipRect = deviceBounds;
   } else if (!clip.isRect(&clipRect)) {
     return false;
   }
@@ -314,6 +418,8 @@ bool OpsCompositor::drawAsClear(const Rect& rect, const MCState& state, const Fi
   if (bounds == deviceBounds) {
     // discard all previous ops if the clear rect covers the entire render target.
     ops.clear();
+    // The stencil clip written by a discarded op is gone, it must be written again when reused.
+    stencilClipKey = {};
   }
   auto format = renderTarget->format();
   auto caps = renderTarget->getContext()->caps();
@@ -332,6 +438,8 @@ void OpsCompositor::makeClosed() {
   }
   DEBUG_ASSERT(renderTarget != nullptr);
   flushPendingOps();
+  drawingManager->addOpsMergeStats(mergeStats);
+  drawingManager->addClipMaskStats(clipMaskStats);
   drawingManager->addOpsRenderTask(std::move(renderTarget), std::move(ops));
   drawingManager = nullptr;
 }
@@ -360,16 +468,16 @@ std::pair<bool, bool> OpsCompositor::needComputeBounds(const Fill& fill, bool ha
   return {needLocalBounds, needDeviceBounds};
 }
 
-Rect OpsCompositor::getClipBounds(const Path& clip) {
-  if (clip.isInverseFillType()) {
-    return renderTarget->bounds();
+Rect OpsCompositor::getClipBounds(const ClipStack& clip) {
+  if (clip.isEmpty()) {
+    return Rect::MakeEmpty();
   }
-  return clip.isEmpty() ? Rect::MakeEmpty() : clip.getBounds();
+  return clip.isUnbounded() ? renderTarget->bounds() : clip.getBounds();
 }
 
-std::pair<std::optional<Rect>, bool> OpsCompositor::getClipRect(const Path& clip) {
+std::pair<std::optional<Rect>, bool> OpsCompositor::getClipRect(const ClipStack& clip) {
   auto rect = Rect::MakeEmpty();
-  if (clip.isInverseFillType() || !clip.isRect(&rect)) {
+  if (!clip.isRect(&rect)) {
     return {std::nullopt, false};
   }
   FlipYIfNeeded(&rect, renderTarget);
@@ -383,53 +491,130 @@ std::pair<std::optional<Rect>, bool> OpsCompositor::getClipRect(const Path& clip
   return {rect, false};
 }
 
-std::shared_ptr<TextureProxy> OpsCompositor::getClipTexture(const Path& clip, AAType aaType) {
-  auto uniqueKey = PathRef::GetUniqueKey(clip);
-  if (aaType != AAType::None) {
+static bool IsAnalyticClip(const ClipStack& clip) {
+  if (clip.isUnbounded()) {
+    return false;
+  }
+  for (auto& element : clip.elements()) {
+    if (element.type() == ClipElement::Type::Path) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Keys a clip by the content of its path, so clips rebuilt from the same geometry, such as the
+ * clips of a canvas replayed every frame, find the mask rendered for an earlier one. The content
+ * key is verified against the full path, so different clips never share a mask. The bounds are
+ * part of the key, since inverse-filled clips are bounded by the render target.
+ */
+static UniqueKey MakeClipKey(const Path& clip, const Rect& bounds, bool antiAlias) {
+  auto uniqueKey = UniqueKey::Append(PathRef::GetContentKey(clip),
+                                     reinterpret_cast<const uint32_t*>(&bounds), 4);
+  if (antiAlias) {
     static const auto AntialiasFlag = UniqueID::Next();
     uniqueKey = UniqueKey::Append(uniqueKey, &AntialiasFlag, 1);
   }
+  return uniqueKey;
+}
+
+std::shared_ptr<TextureProxy> OpsCompositor::getClipTexture(const ClipStack& clipStack,
+                                                            AAType aaType) {
+  auto& clip = clipStack.getPath();
+  auto bounds = getClipBounds(clipStack);
+  if (bounds.isEmpty()) {
+    return nullptr;
+  }
+  auto uniqueKey = MakeClipKey(clip, bounds, aaType != AAType::None);
   if (uniqueKey == clipKey) {
+    clipMaskStats.hits++;
     return clipTexture;
   }
-  auto bounds = getClipBounds(clip);
-  if (bounds.isEmpty()) {
-    return nullptr;
+  // The masks are kept in the resource cache under their keys, which purges them in LRU order like
+  // any other texture. Switching back to a recent clip, even in a later frame, finds its mask.
+  auto proxyProvider = renderTarget->getContext()->proxyProvider();
+  auto textureProxy = proxyProvider->findOrWrapTextureProxy(uniqueKey);
+  if (textureProxy != nullptr) {
+    clipMaskStats.hits++;
+  } else {
+    clipMaskStats.misses++;
+    textureProxy = makeClipTexture(clip, bounds, uniqueKey, aaType);
+    if (textureProxy == nullptr) {
+      return nullptr;
+    }
   }
+  clipKey = uniqueKey;
+  clipTexture = std::move(textureProxy);
+  return clipTexture;
+}
+
+std::shared_ptr<TextureProxy> OpsCompositor::makeClipTexture(const Path& clip, const Rect& bounds,
+                                                             const UniqueKey& uniqueKey,
+                                                             AAType aaType) {
   auto context = renderTarget->getContext();
+  auto proxyProvider = context->proxyProvider();
   auto width = static_cast<int>(ceilf(bounds.width()));
   auto height = static_cast<int>(ceilf(bounds.height()));
   auto rasterizeMatrix = Matrix::MakeTrans(-bounds.left, -bounds.top);
-  if (PathTriangulator::ShouldTriangulatePath(clip)) {
-    auto clipBounds = Rect::MakeWH(width, height);
-    auto shape = Shape::MakeFrom(clip);
-    shape = Shape::ApplyMatrix(std::move(shape), rasterizeMatrix);
-    auto proxyProvider = renderTarget->getContext()->proxyProvider();
-    auto shapeProxy = proxyProvider->createGpuShapeProxy(shape, aaType, clipBounds, renderFlags);
-    auto uvMatrix = Matrix::MakeTrans(bounds.left, bounds.top);
-    auto drawOp = ShapeDrawOp::Make(std::move(shapeProxy), Color::White(), uvMatrix, aaType);
-    auto clipRenderTarget = RenderTargetProxy::MakeFallback(context, width, height, true);
-    if (clipRenderTarget == nullptr) {
-      return nullptr;
-    }
-    clipTexture = clipRenderTarget->getTextureProxy();
-    std::vector<std::unique_ptr<Op> > ops = {};
-    auto clearOp = ClearOp::Make(Color::Transparent(), clipRenderTarget->bounds());
-    ops.push_back(std::move(clearOp));
-    ops.push_back(std::move(drawOp));
-    drawingManager->addOpsRenderTask(std::move(clipRenderTarget), std::move(ops));
-  } else {
+  if (!PathTriangulator::ShouldTriangulatePath(clip)) {
     auto rasterizer =
         Rasterizer::MakeFrom(width, height, clip, aaType != AAType::None, rasterizeMatrix);
-    clipTexture = context->proxyProvider()->createTextureProxy({}, rasterizer, false, renderFlags);
+    return proxyProvider->createTextureProxy(uniqueKey, rasterizer, false, renderFlags);
   }
-  clipKey = uniqueKey;
-  return clipTexture;
+  auto clipBounds = Rect::MakeWH(width, height);
+  auto shape = Shape::MakeFrom(clip);
+  shape = Shape::ApplyMatrix(std::move(shape), rasterizeMatrix);
+  auto shapeProxy = proxyProvider->createGpuShapeProxy(shape, aaType, clipBounds, renderFlags);
+  auto uvMatrix = Matrix::MakeTrans(bounds.left, bounds.top);
+  auto drawOp = ShapeDrawOp::Make(std::move(shapeProxy), Color::White(), uvMatrix, aaType);
+  auto alphaRenderable = context->caps()->isFormatRenderable(PixelFormat::ALPHA_8);
+  auto format = alphaRenderable ? PixelFormat::ALPHA_8 : PixelFormat::RGBA_8888;
+  auto textureProxy = proxyProvider->createTextureProxy(uniqueKey, width, height, format, false,
+                                                        ImageOrigin::TopLeft, renderFlags);
+  if (textureProxy == nullptr) {
+    return nullptr;
+  }
+  auto clipRenderTarget = proxyProvider->createRenderTargetProxy(textureProxy, format);
+  if (clipRenderTarget == nullptr) {
+    return nullptr;
+  }
+  std::vector<std::unique_ptr<Op>> ops = {};
+  auto clearOp = ClearOp::Make(Color::Transparent(), clipRenderTarget->bounds());
+  ops.push_back(std::move(clearOp));
+  ops.push_back(std::move(drawOp));
+  drawingManager->addOpsRenderTask(std::move(clipRenderTarget), std::move(ops));
+  return textureProxy;
+}
+
+bool OpsCompositor::canUseStencilClip(AAType aaType) const {
+  // The stencil buffer has no partial coverage, so it only replaces the mask if the draw is aliased
+  // or the render target is multisampled. Render targets wrapping external frame buffers can't get
+  // a stencil attachment of their own.
+  return aaType != AAType::Coverage && renderTarget->isTextureBacked();
+}
+
+void OpsCompositor::writeStencilClip(const ClipStack& clipStack, const Rect& scissorRect) {
+  auto& clip = clipStack.getPath();
+  auto bounds = getClipBounds(clipStack);
+  auto uniqueKey = MakeClipKey(clip, bounds, false);
+  if (uniqueKey == stencilClipKey) {
+    clipMaskStats.hits++;
+    return;
+  }
+  auto stencilClipOp = StencilClipOp::Make(clip, bounds, scissorRect, renderFlags);
+  if (stencilClipOp == nullptr) {
+    return;
+  }
+  clipMaskStats.stencilWrites++;
+  ops.push_back(std::move(stencilClipOp));
+  stencilClipKey = uniqueKey;
 }
 
-std::unique_ptr<FragmentProcessor> OpsCompositor::getClipMaskFP(const Path& clip, AAType aaType,
-                                                                Rect* scissorRect) {
-  if (clip.isEmpty() && clip.isInverseFillType()) {
+std::unique_ptr<FragmentProcessor> OpsCompositor::getClipMaskFP(const ClipStack& clip,
+                                                                AAType aaType, Rect* scissorRect,
+                                                                StencilMode* stencilMode) {
+  if (clip.isWideOpen()) {
     return nullptr;
   }
   auto [rect, useScissor] = getClipRect(clip);
@@ -447,6 +632,14 @@ std::unique_ptr<FragmentProcessor> OpsCompositor::getClipMaskFP(const Path& clip
   *scissorRect = clipBounds;
   FlipYIfNeeded(scissorRect, renderTarget);
   scissorRect->roundOut();
+  if (IsAnalyticClip(clip)) {
+    return getAnalyticClipFP(clip);
+  }
+  if (canUseStencilClip(aaType)) {
+    writeStencilClip(clip, *scissorRect);
+    *stencilMode = StencilMode::TestClip;
+    return nullptr;
+  }
   auto textureProxy = getClipTexture(clip, aaType);
   auto uvMatrix = Matrix::MakeTrans(-clipBounds.left, -clipBounds.top);
   if (renderTarget->origin() == ImageOrigin::BottomLeft) {
@@ -458,6 +651,33 @@ std::unique_ptr<FragmentProcessor> OpsCompositor::getClipMaskFP(const Path& clip
       DeviceSpaceTextureEffect::Make(std::move(textureProxy), uvMatrix));
 }
 
+std::unique_ptr<FragmentProcessor> OpsCompositor::getAnalyticClipFP(const ClipStack& clip) {
+  // The scissor already covers the intersection of the element bounds, so only the rects that are
+  // not pixel aligned and the round rects need a coverage processor.
+  std::unique_ptr<FragmentProcessor> result = nullptr;
+  for (auto& element : clip.elements()) {
+    std::unique_ptr<FragmentProcessor> processor = nullptr;
+    if (element.type() == ClipElement::Type::Rect) {
+      auto rect = element.rect();
+      FlipYIfNeeded(&rect, renderTarget);
+      if (IsPixelAligned(rect)) {
+        continue;
+      }
+      processor = AARectEffect::Make(rect);
+    } else {
+      auto rRect = element.rRect();
+      FlipYIfNeeded(&rRect.rect, renderTarget);
+      processor = AARRectEffect::Make(rRect);
+    }
+    if (result == nullptr) {
+      result = std::move(processor);
+    } else {
+      result = FragmentProcessor::Compose(std::move(processor), std::move(result));
+    }
+  }
+  return result;
+}
+
 DstTextureInfo OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds, AAType aaType) {
   auto caps = renderTarget->getContext()->caps();
   if (caps->frameBufferFetchSupport) {
@@ -503,9 +723,9 @@ DstTextureInfo OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds, AATyp
   return dstTextureInfo;
 }
 
-void OpsCompositor::addDrawOp(std::unique_ptr<DrawOp> op, const Path& clip, const Fill& fill,
+void OpsCompositor::addDrawOp(std::unique_ptr<DrawOp> op, const ClipStack& clip, const Fill& fill,
                               const Rect& localBounds, const Rect& deviceBounds) {
-  if (op == nullptr || fill.nothingToDraw()) {
+  if (op == nullptr || fill.nothingToDraw() || clip.isEmpty()) {
     return;
   }
   DEBUG_ASSERT(renderTarget != nullptr);
@@ -533,12 +753,14 @@ void OpsCompositor::addDrawOp(std::unique_ptr<DrawOp> op, const Path& clip, cons
     }
   }
   Rect scissorRect = Rect::MakeEmpty();
+  auto stencilMode = StencilMode::Disabled;
   auto aaType = getAAType(fill);
-  auto clipMask = getClipMaskFP(clip, aaType, &scissorRect);
+  auto clipMask = getClipMaskFP(clip, aaType, &scissorRect, &stencilMode);
   if (clipMask) {
     op->addCoverageFP(std::move(clipMask));
   }
   op->setScissorRect(scissorRect);
+  op->setStencilMode(stencilMode);
   op->setBlendMode(fill.blendMode);
   if (!BlendModeAsCoeff(fill.blendMode)) {
     auto dstTextureInfo = makeDstTextureInfo(deviceBounds, aaType);
@@ -18,9 +18,11 @@
 
 #pragma once
 
+#include <deque>
 #include "core/MCState.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
+#include "gpu/ops/ShapeDrawOp.h"
 #include "tgfx/core/Fill.h"
 #include "tgfx/core/Shape.h"
 
@@ -28,11 +30,75 @@ namespace tgfx {
 enum class PendingOpType {
   Unknown,
   Image,
+  Texture,
   Rect,
   RRect,
   Shape,
 };
 
+/**
+ * PendingBatch holds a list of compatible draws that have not been turned into a DrawOp yet.
+ */
+struct PendingBatch {
+  PendingOpType type = PendingOpType::Unknown;
+  ClipStack clip = {};
+  Fill fill = {};
+  std::shared_ptr<Image> image = nullptr;
+  std::shared_ptr<TextureProxy> texture = nullptr;
+  SamplingOptions sampling = {};
+  std::vector<RectPaint> rects = {};
+  std::vector<RRectPaint> rRects = {};
+  std::vector<ShapePaint> shapes = {};
+  /**
+   * The union of the device bounds of all draws in the batch.
+   */
+  Rect bounds = Rect::MakeEmpty();
+  /**
+   * True if all quads of a Texture batch are translated onto whole pixels.
+   */
+  bool pixelAligned = true;
+};
+
+/**
+ * OpsMergeStats records how many DrawOps were saved by merging draws into earlier compatible
+ * batches instead of starting new ones.
+ */
+struct OpsMergeStats {
+  /**
+   * The number of draws merged into an earlier batch, each of which would otherwise have started a
+   * new DrawOp.
+   */
+  size_t mergedOps = 0;
+
+  /**
+   * The number of merged draws whose op type differs from the latest batch, each of which would
+   * otherwise have required at least one extra program switch.
+   */
+  size_t savedProgramSwitches = 0;
+};
+
+/**
+ * ClipMaskStats records how often the clip masks were reused instead of being rendered again.
+ */
+struct ClipMaskStats {
+  /**
+   * The number of draws whose clip mask was reused, either from the previous draw or from the
+   * masks cached in the resource cache.
+   */
+  size_t hits = 0;
+
+  /**
+   * The number of clip masks rasterized or triangulated from scratch.
+   */
+  size_t misses = 0;
+
+  /**
+   * The number of clip paths written into the stencil buffer of the render target instead of
+   * being rendered as masks. Draws reusing the clip already in the stencil buffer count as hits.
+   */
+  size_t stencilWrites = 0;
+};
+
 /**
  * OpsCompositor is a helper class for composing a series of draw operations into a single render
  * task.
@@ -51,6 +117,14 @@ class OpsCompositor {
   void fillImage(std::shared_ptr<Image> image, const Rect& rect, const SamplingOptions& sampling,
                  const MCState& state, const Fill& fill);
 
+  /**
+   * Fills the given rect with the texture proxy, sampling options, state and fill. The rect is in
+   * the pixel space of the texture, which allows consecutive draws sampling different areas of the
+   * same texture (e.g., glyphs in an atlas) to be merged into a single draw call.
+   */
+  void fillTexture(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
+                   const SamplingOptions& sampling, const MCState& state, const Fill& fill);
+
   /**
    * Fills the given rect with the given state and fill.
    */
@@ -91,26 +165,34 @@ class OpsCompositor {
   std::vector<std::unique_ptr<Op>> ops = {};
   UniqueKey clipKey = {};
   std::shared_ptr<TextureProxy> clipTexture = nullptr;
-  PendingOpType pendingType = PendingOpType::Unknown;
-  Path pendingClip = {};
-  Fill pendingFill = {};
-  std::shared_ptr<Image> pendingImage = nullptr;
-  SamplingOptions pendingSampling = {};
-  std::vector<RectPaint> pendingRects = {};
-  std::vector<RRectPaint> pendingRRects = {};
+  UniqueKey stencilClipKey = {};
+  std::deque<PendingBatch> pendingBatches = {};
+  OpsMergeStats mergeStats = {};
+  ClipMaskStats clipMaskStats = {};
 
   bool drawAsClear(const Rect& rect, const MCState& state, const Fill& fill);
-  bool canAppend(PendingOpType type, const Path& clip, const Fill& fill) const;
-  void flushPendingOps(PendingOpType type = PendingOpType::Unknown, Path clip = {}, Fill fill = {});
+  bool canAppend(const PendingBatch& batch, PendingOpType type, const ClipStack& clip,
+                 const Fill& fill) const;
+  bool canBatchShape(const ClipStack& clip, const Fill& fill);
+  PendingBatch* getPendingBatch(PendingOpType type, const ClipStack& clip, const Fill& fill,
+                                const Rect& bounds, const void* source = nullptr,
+                                const SamplingOptions& sampling = {});
+  void flushPendingOps();
+  void flushPendingBatch(PendingBatch& batch);
   AAType getAAType(const Fill& fill) const;
   std::pair<bool, bool> needComputeBounds(const Fill& fill, bool hasImageFill = false);
-  Rect getClipBounds(const Path& clip);
-  std::shared_ptr<TextureProxy> getClipTexture(const Path& clip, AAType aaType);
-  std::pair<std::optional<Rect>, bool> getClipRect(const Path& clip);
-  std::unique_ptr<FragmentProcessor> getClipMaskFP(const Path& clip, AAType aaType,
-                                                   Rect* scissorRect);
+  Rect getClipBounds(const ClipStack& clip);
+  std::shared_ptr<TextureProxy> getClipTexture(const ClipStack& clip, AAType aaType);
+  std::shared_ptr<TextureProxy> makeClipTexture(const Path& clip, const Rect& bounds,
+                                                const UniqueKey& uniqueKey, AAType aaType);
+  std::pair<std::optional<Rect>, bool> getClipRect(const ClipStack& clip);
+  bool canUseStencilClip(AAType aaType) const;
+  void writeStencilClip(const ClipStack& clip, const Rect& scissorRect);
+  std::unique_ptr<FragmentProcessor> getClipMaskFP(const ClipStack& clip, AAType aaType,
+                                                   Rect* scissorRect, StencilMode* stencilMode);
+  std::unique_ptr<FragmentProcessor> getAnalyticClipFP(const ClipStack& clip);
   DstTextureInfo makeDstTextureInfo(const Rect& deviceBounds, AAType aaType);
-  void addDrawOp(std::unique_ptr<DrawOp> op, const Path& clip, const Fill& fill,
+  void addDrawOp(std::unique_ptr<DrawOp> op, const ClipStack& clip, const Fill& fill,
                  const Rect& localBounds, const Rect& deviceBounds);
 };
 }  // namespace tgfx
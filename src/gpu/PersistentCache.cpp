@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/gpu/PersistentCache.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "tgfx/core/WriteStream.h"
+
+namespace tgfx {
+static constexpr uint32_t FileCacheMagic = 0x43504754;  // "TGPC"
+
+static uint64_t HashBytes(const uint8_t* bytes, size_t size) {
+  // 64-bit FNV-1a, only used to name the files. Collisions are caught by comparing the keys.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/**
+ * FilePersistentCache stores each entry in a file named after the hash of its key. A file starts
+ * with a magic number and the full key, which is compared on load to reject hash collisions and
+ * truncated files.
+ */
+class FilePersistentCache : public PersistentCache {
+ public:
+  explicit FilePersistentCache(std::string directory) : directory(std::move(directory)) {
+    if (this->directory.back() != '/' && this->directory.back() != '\\') {
+      this->directory += '/';
+    }
+  }
+
+  std::shared_ptr<Data> load(const Data& key) override {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto fileData = Data::MakeFromFile(getFilePath(key));
+    auto headerSize = sizeof(uint32_t) * 2 + key.size();
+    if (fileData == nullptr || fileData->size() <= headerSize) {
+      return nullptr;
+    }
+    auto bytes = fileData->bytes();
+    uint32_t header[2] = {};
+    memcpy(header, bytes, sizeof(header));
+    if (header[0] != FileCacheMagic || header[1] != key.size() ||
+        memcmp(bytes + sizeof(header), key.data(), key.size()) != 0) {
+      return nullptr;
+    }
+    return Data::MakeWithCopy(bytes + headerSize, fileData->size() - headerSize);
+  }
+
+  void store(const Data& key, const Data& data) override {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto filePath = getFilePath(key);
+    // Write to a temporary file first, so a crash in the middle never leaves a truncated entry.
+    auto tempPath = filePath + ".tmp";
+    auto stream = WriteStream::MakeFromFile(tempPath);
+    if (stream == nullptr) {
+      return;
+    }
+    uint32_t header[2] = {FileCacheMagic, static_cast<uint32_t>(key.size())};
+    auto success = stream->write(header, sizeof(header)) && stream->write(key.data(), key.size()) &&
+                   stream->write(data.data(), data.size());
+    stream = nullptr;
+    if (!success) {
+      remove(tempPath.c_str());
+      return;
+    }
+    remove(filePath.c_str());
+    if (rename(tempPath.c_str(), filePath.c_str()) != 0) {
+      remove(tempPath.c_str());
+    }
+  }
+
+ private:
+  std::mutex locker = {};
+  std::string directory;
+
+  std::string getFilePath(const Data& key) const {
+    char name[24];
+    auto hash = static_cast<unsigned long long>(HashBytes(key.bytes(), key.size()));
+    snprintf(name, sizeof(name), "%016llx.bin", hash);
+    return directory + name;
+  }
+};
+
+std::shared_ptr<PersistentCache> PersistentCache::MakeFromDirectory(const std::string& directory) {
+  if (directory.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<FilePersistentCache>(directory);
+}
+}  // namespace tgfx
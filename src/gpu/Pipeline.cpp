@@ -55,22 +55,23 @@ const XferProcessor* Pipeline::getXferProcessor() const {
 }
 
 void Pipeline::getUniforms(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->nameSuffix = getMangledSuffix(geometryProcessor.get());
+  // Walks the processors in the same order as updateProcessorIndices().
+  int index = 0;
+  uniformBuffer->processorIndex = index++;
   FragmentProcessor::CoordTransformIter coordTransformIter(this);
   geometryProcessor->setData(uniformBuffer, &coordTransformIter);
   for (auto& fragmentProcessor : fragmentProcessors) {
     FragmentProcessor::Iter iter(fragmentProcessor.get());
     const FragmentProcessor* fp = iter.next();
     while (fp) {
-      uniformBuffer->nameSuffix = getMangledSuffix(fp);
+      uniformBuffer->processorIndex = index++;
       fp->setData(uniformBuffer);
       fp = iter.next();
     }
   }
-  auto processor = getXferProcessor();
-  uniformBuffer->nameSuffix = getMangledSuffix(processor);
-  processor->setData(uniformBuffer);
-  uniformBuffer->nameSuffix = "";
+  uniformBuffer->processorIndex = index++;
+  getXferProcessor()->setData(uniformBuffer);
+  uniformBuffer->processorIndex = -1;
 }
 
 std::vector<SamplerInfo> Pipeline::getSamplers() const {
@@ -68,6 +68,14 @@ class Pipeline : public ProgramInfo {
     return xferProcessor == nullptr ? &_blendInfo : nullptr;
   }
 
+  StencilMode stencilMode() const override {
+    return _stencilMode;
+  }
+
+  void setStencilMode(StencilMode mode) {
+    _stencilMode = mode;
+  }
+
   void getUniforms(UniformBuffer* uniformBuffer) const override;
 
   std::vector<SamplerInfo> getSamplers() const override;
@@ -93,6 +101,7 @@ class Pipeline : public ProgramInfo {
   std::unique_ptr<XferProcessor> xferProcessor = nullptr;
   BlendInfo _blendInfo = {};
   const Swizzle* _outputSwizzle = nullptr;
+  StencilMode _stencilMode = StencilMode::Disabled;
 
   void updateProcessorIndices();
 };
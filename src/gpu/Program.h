@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <list>
 #include "tgfx/core/BytesKey.h"
 #include "tgfx/gpu/Context.h"
 
@@ -41,6 +42,11 @@ class Program {
     return context;
   }
 
+  /**
+   * Returns the estimated number of bytes the driver holds for this program.
+   */
+  virtual size_t memoryUsage() const = 0;
+
  protected:
   Context* context = nullptr;
 
@@ -51,6 +57,7 @@ class Program {
 
  private:
   BytesKey programKey = {};
+  std::list<Program*>::iterator cachedPosition;
 
   friend class ProgramCache;
 };
@@ -177,6 +177,13 @@ std::string ProgramBuilder::nameVariable(const std::string& name) const {
   return name + pipeline->getMangledSuffix(processor);
 }
 
+int ProgramBuilder::currentProcessorIndex() const {
+  if (currentProcessors.empty()) {
+    return -1;
+  }
+  return pipeline->getProcessorIndex(currentProcessors.back());
+}
+
 void ProgramBuilder::nameExpression(std::string* output, const std::string& baseName) {
   // Create var to hold the stage result. If we already have a valid output name, just use that
   // otherwise create a new mangled one. This name is only valid if we are reordering stages
@@ -64,6 +64,12 @@ class ProgramBuilder {
    */
   std::string nameVariable(const std::string& name) const;
 
+  /**
+   * Returns the index of the processor currently emitting its code in the pipeline, or -1 if no
+   * processor is emitting.
+   */
+  int currentProcessorIndex() const;
+
   virtual UniformHandler* uniformHandler() = 0;
 
   virtual const UniformHandler* uniformHandler() const = 0;
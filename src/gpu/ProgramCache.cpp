@@ -17,43 +17,113 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ProgramCache.h"
+#include "gpu/Gpu.h"
 
 namespace tgfx {
-#define MAX_PROGRAM_COUNT 128
-
 ProgramCache::ProgramCache(Context* context) : context(context) {
 }
 
+uint64_t ProgramCache::SourceHash(const std::string& vertex, const std::string& fragment) {
+  // 64-bit FNV-1a over both sources, with the vertex length mixed in to separate them.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix = [&hash](const std::string& text) {
+    for (auto c : text) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 0x100000001b3ULL;
+    }
+  };
+  mix(vertex);
+  mix(std::to_string(vertex.size()));
+  mix(fragment);
+  return hash;
+}
+
 bool ProgramCache::empty() const {
   return programMap.empty();
 }
 
 Program* ProgramCache::getProgram(const ProgramInfo* programInfo) {
+  if (lastProgram != nullptr && lastProgramInfoID == programInfo->uniqueID()) {
+    // The same ProgramInfo is bound again, so its key can't have changed.
+    return lastProgram;
+  }
   BytesKey programKey = {};
   programInfo->computeProgramKey(context, &programKey);
+  lastProgramInfoID = programInfo->uniqueID();
+  if (lastProgram != nullptr && lastProgram->programKey == programKey) {
+    // Consecutive draws usually share a program, which is already at the front of the LRU list.
+    return lastProgram;
+  }
   auto result = programMap.find(programKey);
   if (result != programMap.end()) {
-    programLRU.remove(result->second);
-    programLRU.push_front(result->second);
-    return result->second;
+    auto program = result->second;
+    programLRU.splice(programLRU.begin(), programLRU, program->cachedPosition);
+    lastProgram = program;
+    return program;
   }
   auto program = programInfo->createProgram(context).release();
   if (program == nullptr) {
+    lastProgram = nullptr;
     return nullptr;
   }
   program->programKey = programKey;
   programLRU.push_front(program);
+  program->cachedPosition = programLRU.begin();
   programMap[programKey] = program;
-  while (programLRU.size() > MAX_PROGRAM_COUNT) {
+  totalBytes += program->memoryUsage();
+  lastProgram = program;
+  purgeToCacheLimit();
+  return program;
+}
+
+void ProgramCache::recordProgram(const std::string& vertex, const std::string& fragment) {
+  auto hash = SourceHash(vertex, fragment);
+  builtPrograms.insert(hash);
+  if (manifestRecorder != nullptr) {
+    manifestRecorder->addProgram(vertex, fragment, hash);
+  }
+}
+
+size_t ProgramCache::precompilePrograms(const ProgramManifest& manifest, size_t maxPrograms) {
+  std::lock_guard<std::mutex> autoLock(manifest.locker);
+  size_t compiledCount = 0;
+  size_t remainingCount = 0;
+  for (auto& program : manifest.programs) {
+    auto hash = SourceHash(program.vertex, program.fragment);
+    if (builtPrograms.count(hash) > 0) {
+      continue;
+    }
+    if (compiledCount >= maxPrograms) {
+      remainingCount++;
+      continue;
+    }
+    // Failed programs are marked as built too, so they are not compiled again on every call.
+    context->gpu()->precompileProgram(program.vertex, program.fragment);
+    builtPrograms.insert(hash);
+    compiledCount++;
+  }
+  return remainingCount;
+}
+
+void ProgramCache::setCacheLimit(size_t bytesLimit) {
+  _cacheLimit = bytesLimit;
+  purgeToCacheLimit();
+}
+
+void ProgramCache::purgeToCacheLimit() {
+  while (totalBytes > _cacheLimit && programLRU.size() > 1) {
     removeOldestProgram();
   }
-  return program;
 }
 
 void ProgramCache::removeOldestProgram(bool releaseGPU) {
   auto program = programLRU.back();
   programLRU.pop_back();
   programMap.erase(program->programKey);
+  totalBytes -= program->memoryUsage();
+  if (program == lastProgram) {
+    lastProgram = nullptr;
+  }
   if (releaseGPU) {
     program->onReleaseGPU();
   }
@@ -64,5 +134,6 @@ void ProgramCache::releaseAll(bool releaseGPU) {
   while (!programLRU.empty()) {
     removeOldestProgram(releaseGPU);
   }
+  builtPrograms.clear();
 }
 }  // namespace tgfx
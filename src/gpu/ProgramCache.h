@@ -20,8 +20,10 @@
 
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include "Program.h"
 #include "ProgramInfo.h"
+#include "tgfx/gpu/ProgramManifest.h"
 
 namespace tgfx {
 /**
@@ -29,6 +31,17 @@ namespace tgfx {
  */
 class ProgramCache {
  public:
+  /**
+   * The default byte budget of the cached programs.
+   */
+  static constexpr size_t DefaultCacheLimit = 8 * 1024 * 1024;
+
+  /**
+   * Returns a hash that identifies a program by its shader sources. Unlike the program key, it is
+   * stable across launches.
+   */
+  static uint64_t SourceHash(const std::string& vertex, const std::string& fragment);
+
   explicit ProgramCache(Context* context);
 
   /**
@@ -43,12 +56,90 @@ class ProgramCache {
    */
   Program* getProgram(const ProgramInfo* programInfo);
 
+  /**
+   * Returns the estimated number of bytes held by all cached programs.
+   */
+  size_t memoryUsage() const {
+    return totalBytes;
+  }
+
+  /**
+   * Returns the byte budget of the cached programs.
+   */
+  size_t cacheLimit() const {
+    return _cacheLimit;
+  }
+
+  /**
+   * Sets the byte budget of the cached programs. The least recently used programs are released
+   * until the cache fits in the budget, except for the most recently used one.
+   */
+  void setCacheLimit(size_t bytesLimit);
+
+  /**
+   * Returns the number of programs restored from Context::persistentCache() instead of being
+   * compiled from source.
+   */
+  size_t persistentCacheHits() const {
+    return _persistentCacheHits;
+  }
+
+  /**
+   * Returns the number of programs that were looked up in Context::persistentCache() but had to be
+   * compiled from source, either because there was no entry or the stored binary was rejected.
+   */
+  size_t persistentCacheMisses() const {
+    return _persistentCacheMisses;
+  }
+
+  /**
+   * Sets the manifest that every program built from now on is added to. Pass nullptr to stop
+   * recording.
+   */
+  void setManifestRecorder(std::shared_ptr<ProgramManifest> manifest) {
+    manifestRecorder = std::move(manifest);
+  }
+
+  /**
+   * Called by the backend each time a program is built from the given shader sources.
+   */
+  void recordProgram(const std::string& vertex, const std::string& fragment);
+
+  /**
+   * Precompiles at most maxPrograms programs of the manifest that have not been built yet. Returns
+   * the number of programs still left to precompile.
+   */
+  size_t precompilePrograms(const ProgramManifest& manifest, size_t maxPrograms);
+
+  /**
+   * Records the result of a program lookup in Context::persistentCache().
+   */
+  void notifyPersistentCacheLookup(bool hit) {
+    if (hit) {
+      _persistentCacheHits++;
+    } else {
+      _persistentCacheMisses++;
+    }
+  }
+
  private:
   Context* context = nullptr;
   std::list<Program*> programLRU = {};
   BytesKeyMap<Program*> programMap = {};
+  size_t totalBytes = 0;
+  size_t _cacheLimit = DefaultCacheLimit;
+  // The program returned by the last call to getProgram() and the ProgramInfo it was returned for,
+  // which lets consecutive lookups of the same program skip the key hashing and the LRU update.
+  Program* lastProgram = nullptr;
+  uint32_t lastProgramInfoID = 0;
+  std::shared_ptr<ProgramManifest> manifestRecorder = nullptr;
+  // The source hashes of all programs built or precompiled so far.
+  std::unordered_set<uint64_t> builtPrograms = {};
+  size_t _persistentCacheHits = 0;
+  size_t _persistentCacheMisses = 0;
 
   void removeOldestProgram(bool releaseGPU = true);
+  void purgeToCacheLimit();
   void releaseAll(bool releaseGPU);
 
   friend class Context;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/utils/UniqueID.h"
 #include "gpu/Blend.h"
 #include "gpu/Program.h"
 #include "gpu/SamplerState.h"
@@ -29,6 +30,26 @@ struct SamplerInfo {
   const TextureSampler* sampler;
   SamplerState state;
 };
+
+/**
+ * Describes how a draw uses the stencil buffer of the render target, which holds the clip written
+ * by the latest StencilClipOp.
+ */
+enum class StencilMode {
+  /**
+   * The stencil buffer is neither tested nor written.
+   */
+  Disabled,
+  /**
+   * Color writes are turned off, and the covered pixels are marked in the stencil buffer.
+   */
+  WriteClip,
+  /**
+   * Only the pixels marked in the stencil buffer are drawn.
+   */
+  TestClip
+};
+
 /**
  * This immutable object contains information needed to build a shader program and set API state for
  * a draw.
@@ -37,6 +58,14 @@ class ProgramInfo {
  public:
   virtual ~ProgramInfo() = default;
 
+  /**
+   * Returns a global unique ID for this ProgramInfo. The ID is never reused, so it identifies the
+   * same program key as long as the ProgramInfo stays immutable.
+   */
+  uint32_t uniqueID() const {
+    return _uniqueID;
+  }
+
   /**
    * Returns the blend info for the draw. A nullptr is returned if the draw does not require
    * blending.
@@ -48,6 +77,11 @@ class ProgramInfo {
    */
   virtual bool requiresBarrier() const = 0;
 
+  /**
+   * Returns how the draw uses the stencil buffer of the render target.
+   */
+  virtual StencilMode stencilMode() const = 0;
+
   /**
    * Collects uniform data for the draw.
    */
@@ -67,5 +101,8 @@ class ProgramInfo {
    * Creates a new program.
    */
   virtual std::unique_ptr<Program> createProgram(Context* context) const = 0;
+
+ private:
+  uint32_t _uniqueID = UniqueID::Next();
 };
 }  // namespace tgfx
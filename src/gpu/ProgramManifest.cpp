@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/gpu/ProgramManifest.h"
+#include "gpu/ProgramCache.h"
+#include "tgfx/core/DataView.h"
+#include "tgfx/core/WriteStream.h"
+
+namespace tgfx {
+static constexpr uint32_t ManifestMagic = 0x4D504754;  // "TGPM"
+static constexpr uint32_t ManifestVersion = 1;
+
+std::shared_ptr<ProgramManifest> ProgramManifest::Make() {
+  return std::shared_ptr<ProgramManifest>(new ProgramManifest());
+}
+
+static bool ReadString(const DataView& reader, size_t* offset, std::string* result) {
+  if (*offset + sizeof(uint32_t) > reader.size()) {
+    return false;
+  }
+  auto length = static_cast<size_t>(reader.getUint32(*offset));
+  *offset += sizeof(uint32_t);
+  if (length > reader.size() - *offset) {
+    return false;
+  }
+  result->assign(reinterpret_cast<const char*>(reader.bytes()) + *offset, length);
+  *offset += length;
+  return true;
+}
+
+std::shared_ptr<ProgramManifest> ProgramManifest::MakeFrom(std::shared_ptr<Data> data) {
+  if (data == nullptr || data->size() < sizeof(uint32_t) * 3) {
+    return nullptr;
+  }
+  DataView reader(data->bytes(), data->size());
+  if (reader.getUint32(0) != ManifestMagic || reader.getUint32(4) != ManifestVersion) {
+    return nullptr;
+  }
+  auto count = reader.getUint32(8);
+  size_t offset = sizeof(uint32_t) * 3;
+  auto manifest = Make();
+  for (uint32_t i = 0; i < count; i++) {
+    std::string vertex;
+    std::string fragment;
+    if (!ReadString(reader, &offset, &vertex) || !ReadString(reader, &offset, &fragment)) {
+      return nullptr;
+    }
+    manifest->addProgram(vertex, fragment, ProgramCache::SourceHash(vertex, fragment));
+  }
+  return manifest;
+}
+
+size_t ProgramManifest::size() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return programs.size();
+}
+
+static void WriteUint32(WriteStream* stream, uint32_t value) {
+  uint8_t bytes[4] = {};
+  DataView writer(bytes, sizeof(bytes));
+  writer.setUint32(0, value);
+  stream->write(bytes, sizeof(bytes));
+}
+
+static void WriteString(WriteStream* stream, const std::string& text) {
+  WriteUint32(stream, static_cast<uint32_t>(text.size()));
+  stream->writeText(text);
+}
+
+std::shared_ptr<Data> ProgramManifest::serialize() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto stream = MemoryWriteStream::Make();
+  WriteUint32(stream.get(), ManifestMagic);
+  WriteUint32(stream.get(), ManifestVersion);
+  WriteUint32(stream.get(), static_cast<uint32_t>(programs.size()));
+  for (auto& program : programs) {
+    WriteString(stream.get(), program.vertex);
+    WriteString(stream.get(), program.fragment);
+  }
+  return stream->readData();
+}
+
+void ProgramManifest::addProgram(const std::string& vertex, const std::string& fragment,
+                                 uint64_t hash) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (programHashes.insert(hash).second) {
+    programs.push_back({vertex, fragment});
+  }
+}
+}  // namespace tgfx
@@ -124,7 +124,7 @@ std::shared_ptr<GpuShapeProxy> ProxyProvider::createGpuShapeProxy(std::shared_pt
   // The triangle and texture proxies might be created by previous tasks that are still in progress.
   // One of them might not have the corresponding resources in the cache yet, so we need to wrap
   // both of them into the GpuShapeProxy.
-  auto triangleProxy = findOrWrapGpuBufferProxy(triangleKey);
+  auto triangleProxy = findOrWrapGpuBufferRangeProxy(triangleKey);
   auto textureKey = UniqueKey::Append(uniqueKey, &TextureShapeType, 1);
   auto textureProxy = findOrWrapTextureProxy(textureKey);
   if (triangleProxy != nullptr || textureProxy != nullptr) {
@@ -137,7 +137,7 @@ std::shared_ptr<GpuShapeProxy> ProxyProvider::createGpuShapeProxy(std::shared_pt
   auto rasterizer = std::make_unique<ShapeRasterizer>(width, height, std::move(shape), aaType);
   std::unique_ptr<DataSource<ShapeBuffer>> dataSource = nullptr;
   if (!(renderFlags & RenderFlags::DisableAsyncTask) && rasterizer->asyncSupport()) {
-    dataSource = DataSource<ShapeBuffer>::Async(std::move(rasterizer));
+    dataSource = DataSource<ShapeBuffer>::Async(std::move(rasterizer), TaskPriority::High);
   } else {
     dataSource = std::move(rasterizer);
   }
@@ -182,7 +182,9 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   auto height = generator->height();
   auto alphaOnly = generator->isAlphaOnly();
   auto asyncDecoding = !(renderFlags & RenderFlags::DisableAsyncTask);
-  auto source = ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  // The texture is requested by a draw call, so the current frame is waiting for the decoding.
+  auto source =
+      ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding, TaskPriority::High);
   return createTextureProxy(uniqueKey, std::move(source), width, height, alphaOnly, mipmapped,
                             renderFlags);
 }
@@ -337,6 +339,22 @@ std::shared_ptr<GpuBufferProxy> ProxyProvider::findOrWrapGpuBufferProxy(
   return proxy;
 }
 
+std::shared_ptr<GpuBufferProxy> ProxyProvider::findOrWrapGpuBufferRangeProxy(
+    const UniqueKey& uniqueKey) {
+  auto proxy = std::static_pointer_cast<GpuBufferProxy>(findProxy(uniqueKey));
+  if (proxy != nullptr) {
+    return proxy;
+  }
+  auto bufferRange = Resource::Find<GpuBufferRange>(context, uniqueKey);
+  if (bufferRange == nullptr) {
+    return nullptr;
+  }
+  auto bufferType = bufferRange->buffer()->bufferType();
+  proxy = std::shared_ptr<GpuBufferProxy>(new GpuBufferProxy(uniqueKey, bufferType));
+  addResourceProxy(proxy, uniqueKey);
+  return proxy;
+}
+
 std::shared_ptr<TextureProxy> ProxyProvider::findOrWrapTextureProxy(const UniqueKey& uniqueKey) {
   auto proxy = std::static_pointer_cast<TextureProxy>(findProxy(uniqueKey));
   if (proxy != nullptr) {
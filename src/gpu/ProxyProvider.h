@@ -145,6 +145,8 @@ class ProxyProvider {
 
   std::shared_ptr<GpuBufferProxy> findOrWrapGpuBufferProxy(const UniqueKey& uniqueKey);
 
+  std::shared_ptr<GpuBufferProxy> findOrWrapGpuBufferRangeProxy(const UniqueKey& uniqueKey);
+
   void addResourceProxy(std::shared_ptr<ResourceProxy> proxy, const UniqueKey& uniqueKey);
 };
 }  // namespace tgfx
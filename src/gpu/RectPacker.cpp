@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RectPacker.h"
+
+namespace tgfx {
+/**
+ * Rounds shelf heights up to a multiple of this value, so that rectangles with slightly different
+ * heights can share the same shelf.
+ */
+static constexpr int ShelfHeightAlignment = 4;
+
+RectPacker::RectPacker(int width, int height) : _width(width), _height(height) {
+}
+
+float RectPacker::usage() const {
+  if (_width <= 0 || _height <= 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(nextShelfY) / static_cast<float>(_height);
+}
+
+bool RectPacker::addRect(int width, int height, Point* location) {
+  if (width <= 0 || height <= 0 || width > _width || height > _height) {
+    return false;
+  }
+  Shelf* bestShelf = nullptr;
+  for (auto& shelf : shelves) {
+    if (shelf.height < height || shelf.usedWidth + width > _width) {
+      continue;
+    }
+    // Prefer the shelf that wastes the least vertical space.
+    if (bestShelf == nullptr || shelf.height < bestShelf->height) {
+      bestShelf = &shelf;
+    }
+  }
+  if (bestShelf == nullptr || bestShelf->height > height * 2) {
+    auto shelfHeight = (height + ShelfHeightAlignment - 1) / ShelfHeightAlignment *
+                       ShelfHeightAlignment;
+    if (shelfHeight > _height) {
+      shelfHeight = height;
+    }
+    if (nextShelfY + shelfHeight <= _height) {
+      shelves.push_back({nextShelfY, shelfHeight, 0});
+      nextShelfY += shelfHeight;
+      bestShelf = &shelves.back();
+    } else if (bestShelf == nullptr) {
+      return false;
+    }
+  }
+  location->set(static_cast<float>(bestShelf->usedWidth), static_cast<float>(bestShelf->y));
+  bestShelf->usedWidth += width;
+  return true;
+}
+
+void RectPacker::reset() {
+  nextShelfY = 0;
+  shelves.clear();
+}
+}  // namespace tgfx
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Point.h"
+
+namespace tgfx {
+/**
+ * RectPacker allocates rectangles from a fixed-size 2D area using a shelf strategy. The area is
+ * divided into horizontal shelves, each shelf gets the height of the first rectangle placed in it,
+ * and rectangles are placed from left to right until the shelf is full. It is fast and works well
+ * for items of similar heights, such as glyphs or small icons.
+ */
+class RectPacker {
+ public:
+  RectPacker(int width, int height);
+
+  /**
+   * Returns the width of the packing area.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the packing area.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Returns the percentage of the packing area that is currently occupied by shelves.
+   */
+  float usage() const;
+
+  /**
+   * Allocates a rectangle of the specified size. Returns false if there is not enough space left.
+   * Otherwise, sets the location to the top-left corner of the allocated rectangle and returns true.
+   */
+  bool addRect(int width, int height, Point* location);
+
+  /**
+   * Discards all allocated rectangles.
+   */
+  void reset();
+
+ private:
+  struct Shelf {
+    int y = 0;
+    int height = 0;
+    int usedWidth = 0;
+  };
+
+  int _width = 0;
+  int _height = 0;
+  int nextShelfY = 0;
+  std::vector<Shelf> shelves = {};
+};
+}  // namespace tgfx
@@ -23,7 +23,10 @@
 #include "core/Rasterizer.h"
 #include "core/utils/Caster.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/ImageAtlas.h"
 #include "gpu/ProxyProvider.h"
+#include "gpu/ResourceProvider.h"
 
 namespace tgfx {
 RenderContext::RenderContext(std::shared_ptr<RenderTargetProxy> proxy, uint32_t renderFlags,
@@ -37,21 +40,29 @@ RenderContext::RenderContext(std::shared_ptr<RenderTargetProxy> proxy, uint32_t
   }
 }
 
-Rect RenderContext::getClipBounds(const Path& clip) {
-  if (clip.isInverseFillType()) {
-    return renderTarget->bounds();
+Rect RenderContext::getClipBounds(const ClipStack& clip) {
+  if (clip.isEmpty()) {
+    return Rect::MakeEmpty();
   }
-  return clip.isEmpty() ? Rect::MakeEmpty() : clip.getBounds();
+  return clip.isUnbounded() ? renderTarget->bounds() : clip.getBounds();
 }
 
 void RenderContext::drawFill(const MCState& state, const Fill& fill) {
   auto& clip = state.clip;
-  if (clip.isEmpty() && clip.isInverseFillType()) {
+  if (clip.isEmpty()) {
+    return;
+  }
+  auto clipRect = Rect::MakeEmpty();
+  if (clip.isWideOpen()) {
     if (auto compositor = getOpsCompositor(fill.isOpaque())) {
       compositor->fillRect(renderTarget->bounds(), {}, fill.makeWithMatrix(state.matrix));
     }
+  } else if (clip.isRect(&clipRect)) {
+    if (auto compositor = getOpsCompositor()) {
+      compositor->fillRect(clipRect, {}, fill.makeWithMatrix(state.matrix));
+    }
   } else {
-    auto shape = Shape::MakeFrom(clip);
+    auto shape = Shape::MakeFrom(clip.getPath());
     drawShape(std::move(shape), {}, fill.makeWithMatrix(state.matrix));
   }
 }
@@ -108,7 +119,9 @@ void RenderContext::drawImageRect(std::shared_ptr<Image> image, const Rect& rect
   }
   auto subsetImage = Caster::AsSubsetImage(image.get());
   if (subsetImage == nullptr) {
-    compositor->fillImage(std::move(image), rect, samplingOptions, state, fill);
+    if (!drawImageFromAtlas(image.get(), rect, samplingOptions, state, fill)) {
+      compositor->fillImage(std::move(image), rect, samplingOptions, state, fill);
+    }
   } else {
     // Unwrap the subset image to maximize the merging of draw calls.
     auto imageRect = rect;
@@ -117,11 +130,48 @@ void RenderContext::drawImageRect(std::shared_ptr<Image> image, const Rect& rect
     imageRect.offset(subset.left, subset.top);
     imageState.matrix.preTranslate(-subset.left, -subset.top);
     auto offsetMatrix = Matrix::MakeTrans(subset.left, subset.top);
-    compositor->fillImage(subsetImage->source, imageRect, samplingOptions, imageState,
-                          fill.makeWithMatrix(offsetMatrix));
+    auto imageFill = fill.makeWithMatrix(offsetMatrix);
+    if (!drawImageFromAtlas(subsetImage->source.get(), imageRect, samplingOptions, imageState,
+                            imageFill)) {
+      compositor->fillImage(subsetImage->source, imageRect, samplingOptions, imageState,
+                            imageFill);
+    }
   }
 }
 
+bool RenderContext::drawImageFromAtlas(const Image* image, const Rect& rect,
+                                       const SamplingOptions& sampling, const MCState& state,
+                                       const Fill& fill) {
+  if (sampling.mipmapMode != MipmapMode::None ||
+      !Rect::MakeWH(image->width(), image->height()).contains(rect)) {
+    return false;
+  }
+  // The antialiasing outset of a small draw would reach the neighboring images in the page.
+  if (fill.antiAlias && state.matrix.getMinScale() < ImageAtlas::MinAntiAliasScale) {
+    return false;
+  }
+  auto imageAtlas = getContext()->resourceProvider()->imageAtlas();
+  AtlasImage atlasImage = {};
+  if (!imageAtlas->findOrAddImage(image, renderFlags, &atlasImage)) {
+    return false;
+  }
+  auto compositor = getOpsCompositor();
+  if (compositor == nullptr) {
+    return true;
+  }
+  // Draw the image area of the atlas page, so that the draws of all images in the same page share
+  // one texture and can be merged.
+  auto& location = atlasImage.location;
+  auto atlasRect = rect;
+  atlasRect.offset(location.x, location.y);
+  auto atlasState = state;
+  atlasState.matrix.preTranslate(-location.x, -location.y);
+  auto offsetMatrix = Matrix::MakeTrans(location.x, location.y);
+  compositor->fillTexture(std::move(atlasImage.textureProxy), atlasRect, sampling, atlasState,
+                          fill.makeWithMatrix(offsetMatrix));
+  return true;
+}
+
 void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
                                      const MCState& state, const Fill& fill, const Stroke* stroke) {
   DEBUG_ASSERT(glyphRunList != nullptr);
@@ -129,6 +179,9 @@ void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
     drawColorGlyphs(std::move(glyphRunList), state, fill);
     return;
   }
+  if (stroke == nullptr && drawGlyphsFromAtlas(glyphRunList.get(), state, fill)) {
+    return;
+  }
   auto maxScale = state.matrix.getMaxScale();
   if (maxScale <= 0.0f) {
     return;
@@ -159,7 +212,9 @@ void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
 
 void RenderContext::drawPicture(std::shared_ptr<Picture> picture, const MCState& state) {
   DEBUG_ASSERT(picture != nullptr);
-  picture->playback(this, state);
+  // Nothing outside the render target can be seen, even if the clip is unbounded.
+  auto cullRect = renderTarget->bounds();
+  picture->playback(this, state, &cullRect);
 }
 
 void RenderContext::drawLayer(std::shared_ptr<Picture> picture, std::shared_ptr<ImageFilter> filter,
@@ -251,6 +306,95 @@ bool RenderContext::flush() {
   return false;
 }
 
+/**
+ * Returns true if the matrix only contains a positive uniform scale and a translation, which keeps
+ * glyphs rasterized in the atlas pixel-aligned with the device space.
+ */
+static bool IsAtlasCompatibleMatrix(const Matrix& matrix) {
+  if (matrix.getSkewX() != 0.0f || matrix.getSkewY() != 0.0f) {
+    return false;
+  }
+  auto scale = matrix.getScaleX();
+  return scale > 0.0f && scale == matrix.getScaleY();
+}
+
+struct AtlasGlyphDraw {
+  AtlasGlyph glyph = {};
+  Point position = Point::Zero();
+};
+
+/**
+ * Splits a device coordinate into a whole pixel and one of the GlyphAtlas subpixel positions.
+ */
+static float SnapToSubpixel(float value, int* subpixel) {
+  auto pixel = floorf(value);
+  *subpixel = static_cast<int>(roundf((value - pixel) * GlyphAtlas::SubpixelCount));
+  if (*subpixel == GlyphAtlas::SubpixelCount) {
+    *subpixel = 0;
+    pixel += 1.0f;
+  }
+  return pixel;
+}
+
+bool RenderContext::drawGlyphsFromAtlas(const GlyphRunList* glyphRunList, const MCState& state,
+                                        const Fill& fill) {
+  if (!glyphRunList->hasOutlines() || fill.shader != nullptr || fill.maskFilter != nullptr ||
+      !IsAtlasCompatibleMatrix(state.matrix)) {
+    return false;
+  }
+  auto scale = state.matrix.getScaleX();
+  auto glyphAtlas = getContext()->resourceProvider()->glyphAtlas();
+  std::vector<AtlasGlyphDraw> glyphDraws = {};
+  // Resolve all glyphs before drawing, so that we can still fall back to the rasterizing path if
+  // any of them doesn't fit in the atlas.
+  for (auto& glyphRun : glyphRunList->glyphRuns()) {
+    Font font = {};
+    if (!glyphRun.glyphFace->asFont(&font)) {
+      return false;
+    }
+    auto deviceSize = font.getSize() * scale;
+    if (deviceSize > static_cast<float>(GlyphAtlas::MaxGlyphSize)) {
+      return false;
+    }
+    font = font.makeWithSize(deviceSize);
+    auto& glyphIDs = glyphRun.glyphs;
+    auto& positions = glyphRun.positions;
+    for (size_t i = 0; i < glyphIDs.size(); ++i) {
+      auto position = state.matrix.mapXY(positions[i].x, positions[i].y);
+      // Snap the glyph origin to a quarter pixel on both axes.
+      int subpixelX = 0;
+      int subpixelY = 0;
+      auto x = SnapToSubpixel(position.x, &subpixelX);
+      auto y = SnapToSubpixel(position.y, &subpixelY);
+      AtlasGlyphDraw glyphDraw = {};
+      if (!glyphAtlas->findOrAddGlyph(font, glyphIDs[i], subpixelX, subpixelY, fill.antiAlias,
+                                      &glyphDraw.glyph)) {
+        return false;
+      }
+      if (glyphDraw.glyph.textureProxy != nullptr) {
+        glyphDraw.position = Point::Make(x, y);
+        glyphDraws.push_back(std::move(glyphDraw));
+      }
+    }
+  }
+  auto compositor = getOpsCompositor();
+  if (compositor == nullptr) {
+    return true;
+  }
+  // The glyph quads are pixel-aligned, so the compositor draws them without antialiasing while the
+  // clip still follows fill.antiAlias.
+  SamplingOptions sampling(FilterMode::Nearest);
+  auto glyphState = state;
+  for (auto& glyphDraw : glyphDraws) {
+    auto& glyph = glyphDraw.glyph;
+    auto& atlasRect = glyph.atlasRect;
+    glyphState.matrix = Matrix::MakeTrans(glyphDraw.position.x + glyph.offset.x - atlasRect.left,
+                                          glyphDraw.position.y + glyph.offset.y - atlasRect.top);
+    compositor->fillTexture(glyph.textureProxy, atlasRect, sampling, glyphState, fill);
+  }
+  return true;
+}
+
 OpsCompositor* RenderContext::getOpsCompositor(bool discardContent) {
   if (surface && !surface->aboutToDraw(discardContent)) {
     return nullptr;
@@ -68,9 +68,13 @@ class RenderContext : public DrawContext {
   Surface* surface = nullptr;
   std::shared_ptr<OpsCompositor> opsCompositor = nullptr;
 
-  Rect getClipBounds(const Path& clip);
+  Rect getClipBounds(const ClipStack& clip);
   void drawColorGlyphs(std::shared_ptr<GlyphRunList> glyphRunList, const MCState& state,
                        const Fill& fill);
+  bool drawGlyphsFromAtlas(const GlyphRunList* glyphRunList, const MCState& state,
+                           const Fill& fill);
+  bool drawImageFromAtlas(const Image* image, const Rect& rect, const SamplingOptions& sampling,
+                          const MCState& state, const Fill& fill);
   OpsCompositor* getOpsCompositor(bool discardContent = false);
   void replaceRenderTarget(std::shared_ptr<RenderTargetProxy> newRenderTarget,
                            std::shared_ptr<Image> oldContent);
@@ -18,6 +18,7 @@
 
 #include "RenderPass.h"
 #include "gpu/Gpu.h"
+#include "gpu/ResourceProvider.h"
 
 namespace tgfx {
 bool RenderPass::begin(std::shared_ptr<RenderTarget> renderTarget,
@@ -28,6 +29,7 @@ bool RenderPass::begin(std::shared_ptr<RenderTarget> renderTarget,
   _renderTarget = std::move(renderTarget);
   _renderTargetTexture = std::move(renderTexture);
   drawPipelineStatus = DrawPipelineStatus::NotConfigured;
+  stencilReady = false;
   onBindRenderTarget();
   return true;
 }
@@ -41,6 +43,10 @@ void RenderPass::end() {
 
 void RenderPass::bindProgramAndScissorClip(const ProgramInfo* programInfo,
                                            const Rect& scissorRect) {
+  if (programInfo->stencilMode() != StencilMode::Disabled && !stencilReady) {
+    drawPipelineStatus = DrawPipelineStatus::FailedToBind;
+    return;
+  }
   if (!onBindProgramAndScissorClip(programInfo, scissorRect)) {
     drawPipelineStatus = DrawPipelineStatus::FailedToBind;
     return;
@@ -49,11 +55,11 @@ void RenderPass::bindProgramAndScissorClip(const ProgramInfo* programInfo,
 }
 
 void RenderPass::bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
-                             std::shared_ptr<GpuBuffer> vertexBuffer) {
+                             std::shared_ptr<GpuBuffer> vertexBuffer, size_t vertexOffset) {
   if (drawPipelineStatus != DrawPipelineStatus::Ok) {
     return;
   }
-  if (!onBindBuffers(std::move(indexBuffer), std::move(vertexBuffer), nullptr)) {
+  if (!onBindBuffers(std::move(indexBuffer), std::move(vertexBuffer), vertexOffset, nullptr, 0)) {
     drawPipelineStatus = DrawPipelineStatus::FailedToBind;
   }
 }
@@ -63,7 +69,46 @@ void RenderPass::bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
   if (drawPipelineStatus != DrawPipelineStatus::Ok) {
     return;
   }
-  if (!onBindBuffers(std::move(indexBuffer), nullptr, std::move(vertexData))) {
+  if (vertexData == nullptr) {
+    drawPipelineStatus = DrawPipelineStatus::FailedToBind;
+    return;
+  }
+  auto allocator = context->resourceProvider()->vertexAllocator();
+  auto slice = allocator->write(vertexData->data(), vertexData->size());
+  if (slice.buffer == nullptr ||
+      !onBindBuffers(std::move(indexBuffer), std::move(slice.buffer), slice.offset, nullptr, 0)) {
+    drawPipelineStatus = DrawPipelineStatus::FailedToBind;
+  }
+}
+
+void RenderPass::bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
+                             std::shared_ptr<GpuBuffer> vertexBuffer,
+                             std::shared_ptr<GpuBuffer> instanceBuffer, size_t instanceOffset,
+                             size_t vertexOffset) {
+  if (drawPipelineStatus != DrawPipelineStatus::Ok) {
+    return;
+  }
+  if (!onBindBuffers(std::move(indexBuffer), std::move(vertexBuffer), vertexOffset,
+                     std::move(instanceBuffer), instanceOffset)) {
+    drawPipelineStatus = DrawPipelineStatus::FailedToBind;
+  }
+}
+
+void RenderPass::bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
+                             std::shared_ptr<GpuBuffer> vertexBuffer,
+                             std::shared_ptr<Data> instanceData) {
+  if (drawPipelineStatus != DrawPipelineStatus::Ok) {
+    return;
+  }
+  if (instanceData == nullptr) {
+    drawPipelineStatus = DrawPipelineStatus::FailedToBind;
+    return;
+  }
+  auto allocator = context->resourceProvider()->vertexAllocator();
+  auto slice = allocator->write(instanceData->data(), instanceData->size());
+  if (slice.buffer == nullptr ||
+      !onBindBuffers(std::move(indexBuffer), std::move(vertexBuffer), 0, std::move(slice.buffer),
+                     slice.offset)) {
     drawPipelineStatus = DrawPipelineStatus::FailedToBind;
   }
 }
@@ -73,7 +118,6 @@ void RenderPass::draw(PrimitiveType primitiveType, size_t baseVertex, size_t ver
     return;
   }
   onDraw(primitiveType, baseVertex, vertexCount, false);
-  drawPipelineStatus = DrawPipelineStatus::NotConfigured;
 }
 
 void RenderPass::drawIndexed(PrimitiveType primitiveType, size_t baseIndex, size_t indexCount) {
@@ -81,7 +125,22 @@ void RenderPass::drawIndexed(PrimitiveType primitiveType, size_t baseIndex, size
     return;
   }
   onDraw(primitiveType, baseIndex, indexCount, true);
-  drawPipelineStatus = DrawPipelineStatus::NotConfigured;
+}
+
+void RenderPass::drawInstanced(PrimitiveType primitiveType, size_t baseVertex, size_t vertexCount,
+                               size_t instanceCount) {
+  if (drawPipelineStatus != DrawPipelineStatus::Ok) {
+    return;
+  }
+  onDrawInstanced(primitiveType, baseVertex, vertexCount, instanceCount, false);
+}
+
+void RenderPass::drawIndexedInstanced(PrimitiveType primitiveType, size_t baseIndex,
+                                      size_t indexCount, size_t instanceCount) {
+  if (drawPipelineStatus != DrawPipelineStatus::Ok) {
+    return;
+  }
+  onDrawInstanced(primitiveType, baseIndex, indexCount, instanceCount, true);
 }
 
 void RenderPass::clear(const Rect& scissor, Color color) {
@@ -89,6 +148,11 @@ void RenderPass::clear(const Rect& scissor, Color color) {
   onClear(scissor, color);
 }
 
+void RenderPass::clearStencil(const Rect& scissor) {
+  drawPipelineStatus = DrawPipelineStatus::NotConfigured;
+  stencilReady = onClearStencil(scissor);
+}
+
 void RenderPass::resolve(const Rect& bounds) {
   auto gpu = context->gpu();
   gpu->resolveRenderTarget(_renderTarget.get(), bounds);
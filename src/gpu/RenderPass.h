@@ -58,11 +58,47 @@ class RenderPass {
   bool begin(std::shared_ptr<RenderTarget> renderTarget, std::shared_ptr<Texture> renderTexture);
   void end();
   void bindProgramAndScissorClip(const ProgramInfo* programInfo, const Rect& scissorRect);
-  void bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer, std::shared_ptr<GpuBuffer> vertexBuffer);
+  /**
+   * Binds the buffers for a draw, with the vertex data starting at vertexOffset bytes.
+   */
+  void bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer, std::shared_ptr<GpuBuffer> vertexBuffer,
+                   size_t vertexOffset = 0);
+  /**
+   * Streams the vertex data into the shared vertex buffers of the current flush and binds it.
+   */
   void bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer, std::shared_ptr<Data> vertexData);
+  /**
+   * Binds the buffers for an instanced draw. The vertex buffer provides the per-vertex attributes
+   * shared by all instances, and the instance buffer provides the per-instance attributes starting
+   * at instanceOffset bytes, while the vertex data starts at vertexOffset bytes. Only available if
+   * Caps::instancedDrawSupport is true.
+   */
+  void bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer, std::shared_ptr<GpuBuffer> vertexBuffer,
+                   std::shared_ptr<GpuBuffer> instanceBuffer, size_t instanceOffset = 0,
+                   size_t vertexOffset = 0);
+  /**
+   * Streams the per-instance data into the shared vertex buffers of the current flush and binds it
+   * for an instanced draw.
+   */
+  void bindBuffers(std::shared_ptr<GpuBuffer> indexBuffer, std::shared_ptr<GpuBuffer> vertexBuffer,
+                   std::shared_ptr<Data> instanceData);
+  /**
+   * Issues a draw call with the bound program and buffers. The program stays bound after drawing,
+   * so an op can rebind only the buffers and issue more draw calls with the same program.
+   */
   void draw(PrimitiveType primitiveType, size_t baseVertex, size_t vertexCount);
   void drawIndexed(PrimitiveType primitiveType, size_t baseIndex, size_t indexCount);
+  void drawInstanced(PrimitiveType primitiveType, size_t baseVertex, size_t vertexCount,
+                     size_t instanceCount);
+  void drawIndexedInstanced(PrimitiveType primitiveType, size_t baseIndex, size_t indexCount,
+                            size_t instanceCount);
   void clear(const Rect& scissor, Color color);
+  /**
+   * Clears the stencil buffer within the scissor, attaching one to the render target first if
+   * needed. Until the next successful call, draws that test or write the stencil buffer are
+   * skipped if the render target can't have a stencil buffer.
+   */
+  void clearStencil(const Rect& scissor);
   void resolve(const Rect& bounds);
   void copyToTexture(Texture* texture, int srcX, int srcY);
 
@@ -75,11 +111,15 @@ class RenderPass {
   virtual bool onBindProgramAndScissorClip(const ProgramInfo* programInfo,
                                            const Rect& drawBounds) = 0;
   virtual bool onBindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
-                             std::shared_ptr<GpuBuffer> vertexBuffer,
-                             std::shared_ptr<Data> vertexData) = 0;
+                             std::shared_ptr<GpuBuffer> vertexBuffer, size_t vertexOffset,
+                             std::shared_ptr<GpuBuffer> instanceBuffer,
+                             size_t instanceOffset) = 0;
   virtual void onDraw(PrimitiveType primitiveType, size_t offset, size_t count,
                       bool drawIndexed) = 0;
+  virtual void onDrawInstanced(PrimitiveType primitiveType, size_t offset, size_t count,
+                               size_t instanceCount, bool drawIndexed) = 0;
   virtual void onClear(const Rect& scissor, Color color) = 0;
+  virtual bool onClearStencil(const Rect& scissor) = 0;
   virtual void onCopyToTexture(Texture* texture, int srcX, int srcY) = 0;
 
   Context* context = nullptr;
@@ -91,5 +131,6 @@ class RenderPass {
   enum class DrawPipelineStatus { Ok = 0, NotConfigured, FailedToBind };
 
   DrawPipelineStatus drawPipelineStatus = DrawPipelineStatus::NotConfigured;
+  bool stencilReady = false;
 };
 }  // namespace tgfx
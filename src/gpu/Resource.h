@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
 #include "gpu/ResourceCache.h"
 #include "gpu/ResourceKey.h"
 
@@ -92,14 +94,33 @@ class Resource {
 
  private:
   std::shared_ptr<Resource> reference;
+  // The shared pointer handed out to the users of the resource. It has its own control block, so
+  // the ResourceCache gets notified through the return queue when the last user drops it.
+  std::weak_ptr<Resource> userReference;
   ScratchKey scratchKey = {};
   UniqueKey uniqueKey = {};
   std::list<Resource*>* cachedList = nullptr;
   std::list<Resource*>::iterator cachedPosition;
+  std::list<Resource*>::iterator scratchPosition;
+  std::list<Resource*>::iterator pendingPosition;
+  bool inScratchList = false;
+  bool inPendingList = false;
   std::chrono::steady_clock::time_point lastUsedTime = {};
+  // The fields below are written by the thread that drops the last user reference and read by
+  // the ResourceCache after taking the resource out of the return queue.
+  std::atomic_bool inReturnQueue = {false};
+  Resource* nextInReturnQueue = nullptr;
+  std::shared_ptr<Resource> returnQueueReference = nullptr;
 
   virtual bool isPurgeable() const {
-    return reference.use_count() <= 1 && uniqueKey.strongCount() == 0;
+    return userReference.expired() && uniqueKey.strongCount() == 0;
+  }
+
+  /**
+   * Collects the other resources that share their memory with this one, which are purged together
+   * with it by the ResourceCache since the memory is only freed once all of them are gone.
+   */
+  virtual void collectPurgeGroup(std::vector<Resource*>*) const {
   }
 
   bool hasExternalReferences() const {
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "gpu/ResourceCache.h"
+#include <atomic>
 #include <unordered_map>
 #include "gpu/Resource.h"
 
@@ -24,7 +25,49 @@ namespace tgfx {
 // Default maximum limit for the amount of GPU memory allocated to resources.
 static const size_t DefaultMaxBytes = 96 * (1 << 20);  // 96MB
 
-ResourceCache::ResourceCache(Context* context) : context(context), maxBytes(DefaultMaxBytes) {
+/**
+ * A lock-free intrusive stack of the resources whose last user reference has been dropped. Any
+ * thread can push to it, while only the ResourceCache takes the resources out, all at once.
+ */
+class ResourceCache::ReturnQueue {
+ public:
+  void push(std::shared_ptr<Resource> resource) {
+    if (closed.load(std::memory_order_acquire)) {
+      return;
+    }
+    auto item = resource.get();
+    if (item->inReturnQueue.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    // Keep the resource alive until the cache takes it out of the queue.
+    item->returnQueueReference = std::move(resource);
+    auto head = top.load(std::memory_order_relaxed);
+    do {
+      item->nextInReturnQueue = head;
+    } while (!top.compare_exchange_weak(head, item, std::memory_order_release,
+                                        std::memory_order_relaxed));
+  }
+
+  Resource* takeAll() {
+    return top.exchange(nullptr, std::memory_order_acquire);
+  }
+
+  void close() {
+    closed.store(true, std::memory_order_release);
+  }
+
+ private:
+  std::atomic<Resource*> top = {nullptr};
+  std::atomic_bool closed = {false};
+};
+
+ResourceCache::ResourceCache(Context* context)
+    : context(context), maxBytes(DefaultMaxBytes), returnQueue(std::make_shared<ReturnQueue>()) {
+}
+
+ResourceCache::~ResourceCache() {
+  returnQueue->close();
+  dropReturnedResources();
 }
 
 bool ResourceCache::empty() const {
@@ -32,6 +75,11 @@ bool ResourceCache::empty() const {
 }
 
 void ResourceCache::releaseAll(bool releaseGPU) {
+  // The resources still referenced by users are released below, so there is no need to return them
+  // to the cache anymore.
+  returnQueue->close();
+  dropReturnedResources();
+  returnQueue = std::make_shared<ReturnQueue>();
   for (auto& resource : nonpurgeableResources) {
     resource->release(releaseGPU);
   }
@@ -40,6 +88,10 @@ void ResourceCache::releaseAll(bool releaseGPU) {
     resource->release(releaseGPU);
   }
   purgeableResources.clear();
+  for (auto& resource : pendingResources) {
+    resource->inPendingList = false;
+  }
+  pendingResources.clear();
   scratchKeyMap.clear();
   uniqueKeyMap.clear();
   purgeableBytes = 0;
@@ -59,21 +111,12 @@ std::shared_ptr<Resource> ResourceCache::findScratchResource(const ScratchKey& s
   if (result == scratchKeyMap.end()) {
     return nullptr;
   }
-  auto& list = result->second;
-  size_t index = 0;
-  bool found = false;
-  for (auto& resource : list) {
+  for (auto resource : result->second) {
     if (resource->isPurgeable() && !resource->hasExternalReferences()) {
-      found = true;
-      break;
+      return refResource(resource);
     }
-    index++;
-  }
-  if (!found) {
-    return nullptr;
   }
-  auto resource = list[index];
-  return refResource(resource);
+  return nullptr;
 }
 
 std::shared_ptr<Resource> ResourceCache::findUniqueResource(const UniqueKey& uniqueKey) {
@@ -141,41 +184,38 @@ std::shared_ptr<Resource> ResourceCache::addResource(Resource* resource,
                                                      const ScratchKey& scratchKey) {
   resource->context = context;
   resource->scratchKey = scratchKey;
-  if (!resource->scratchKey.empty()) {
-    scratchKeyMap[resource->scratchKey].push_back(resource);
-  }
   totalBytes += resource->memoryUsage();
-  auto result = std::shared_ptr<Resource>(resource);
   // Add a strong reference to the resource itself, preventing it from being deleted by external
   // references.
-  result->reference = result;
+  resource->reference = std::shared_ptr<Resource>(resource);
   AddToList(nonpurgeableResources, resource);
-  return result;
+  return refResource(resource);
 }
 
 std::shared_ptr<Resource> ResourceCache::refResource(Resource* resource) {
   if (InList(purgeableResources, resource)) {
     RemoveFromList(purgeableResources, resource);
     purgeableBytes -= resource->memoryUsage();
+    removeFromScratchList(resource);
     AddToList(nonpurgeableResources, resource);
   }
-  return resource->reference;
+  auto userReference = resource->userReference.lock();
+  if (userReference == nullptr) {
+    // The deleter hands the resource back to the cache instead of deleting it.
+    userReference = std::shared_ptr<Resource>(
+        resource, [queue = returnQueue, reference = resource->reference](Resource*) mutable {
+          queue->push(std::move(reference));
+        });
+    resource->userReference = userReference;
+  }
+  return userReference;
 }
 
 void ResourceCache::removeResource(Resource* resource) {
   if (!resource->uniqueKey.empty()) {
     removeUniqueKey(resource);
   }
-  if (!resource->scratchKey.empty()) {
-    auto result = scratchKeyMap.find(resource->scratchKey);
-    if (result != scratchKeyMap.end()) {
-      auto& list = result->second;
-      list.erase(std::remove(list.begin(), list.end(), resource), list.end());
-      if (list.empty()) {
-        scratchKeyMap.erase(resource->scratchKey);
-      }
-    }
-  }
+  removeFromScratchList(resource);
   totalBytes -= resource->memoryUsage();
   resource->release(true);
 }
@@ -201,6 +241,9 @@ bool ResourceCache::purgeToCacheLimit(std::chrono::steady_clock::time_point notU
 void ResourceCache::purgeResourcesByLRU(bool scratchResourceOnly,
                                         const std::function<bool(Resource*)>& satisfied) {
   processUnreferencedResources();
+  auto currentTime = std::chrono::steady_clock::now();
+  auto removedAny = false;
+  std::vector<Resource*> purgeGroup = {};
   auto item = purgeableResources.begin();
   while (item != purgeableResources.end()) {
     auto* resource = *item;
@@ -210,33 +253,144 @@ void ResourceCache::purgeResourcesByLRU(bool scratchResourceOnly,
     if (!scratchResourceOnly || !resource->hasExternalReferences()) {
       item = purgeableResources.erase(item);
       purgeableBytes -= resource->memoryUsage();
+      purgeGroup.clear();
+      resource->collectPurgeGroup(&purgeGroup);
       removeResource(resource);
+      // The memory shared by a group, such as a block of GpuBufferArena, is only freed once all of
+      // its resources are gone, so the purgeable ones are removed together.
+      for (auto* member : purgeGroup) {
+        if (!InList(purgeableResources, member) ||
+            (scratchResourceOnly && member->hasExternalReferences())) {
+          continue;
+        }
+        if (item != purgeableResources.end() && *item == member) {
+          item++;
+        }
+        RemoveFromList(purgeableResources, member);
+        purgeableBytes -= member->memoryUsage();
+        removeResource(member);
+      }
+      removedAny = true;
+      // Resources that report no memory of their own, such as the ranges of a GpuBufferArena,
+      // free their bytes by dropping the last reference to another resource. Reclaim it before
+      // checking the limit again, otherwise far more resources than needed would be purged.
+      while (processReturnedResources(currentTime)) {
+      }
     } else {
       item++;
     }
   }
+  if (removedAny) {
+    // The removed resources might hold the last references to others, which can be reclaimed
+    // right away.
+    processUnreferencedResources();
+  }
 }
 
 void ResourceCache::processUnreferencedResources() {
-  std::vector<Resource*> needToPurge = {};
-  for (auto& resource : nonpurgeableResources) {
-    if (resource->isPurgeable()) {
-      needToPurge.push_back(resource);
+  auto currentTime = std::chrono::steady_clock::now();
+  processPendingResources(currentTime);
+  // Removing a resource might drop the last reference to another one, such as a shared block of
+  // GpuBufferArena, which is then pushed to the return queue right away.
+  while (processReturnedResources(currentTime)) {
+  }
+}
+
+bool ResourceCache::processReturnedResources(std::chrono::steady_clock::time_point currentTime) {
+  auto removedAny = false;
+  auto resource = returnQueue->takeAll();
+  while (resource != nullptr) {
+    auto next = resource->nextInReturnQueue;
+    auto reference = std::move(resource->returnQueueReference);
+    resource->inReturnQueue.store(false, std::memory_order_release);
+    // The resource might have been handed out again after it was returned.
+    if (InList(nonpurgeableResources, resource) && resource->userReference.expired()) {
+      removedAny |= processUnreferencedResource(resource, currentTime);
     }
+    resource = next;
   }
-  if (needToPurge.empty()) {
+  return removedAny;
+}
+
+void ResourceCache::processPendingResources(std::chrono::steady_clock::time_point currentTime) {
+  auto item = pendingResources.begin();
+  while (item != pendingResources.end()) {
+    auto resource = *item++;
+    if (!resource->userReference.expired()) {
+      // The return queue brings it back once the last user drops it again.
+      removeFromPendingList(resource);
+    } else if (resource->isPurgeable()) {
+      processUnreferencedResource(resource, currentTime);
+    }
+  }
+}
+
+bool ResourceCache::processUnreferencedResource(Resource* resource,
+                                                std::chrono::steady_clock::time_point currentTime) {
+  if (!resource->isPurgeable()) {
+    addToPendingList(resource);
+    return false;
+  }
+  removeFromPendingList(resource);
+  RemoveFromList(nonpurgeableResources, resource);
+  if (!resource->scratchKey.empty() || resource->hasExternalReferences()) {
+    AddToList(purgeableResources, resource);
+    purgeableBytes += resource->memoryUsage();
+    resource->lastUsedTime = currentTime;
+    addToScratchList(resource);
+    return false;
+  }
+  removeResource(resource);
+  return true;
+}
+
+void ResourceCache::dropReturnedResources() {
+  auto resource = returnQueue->takeAll();
+  while (resource != nullptr) {
+    auto next = resource->nextInReturnQueue;
+    auto reference = std::move(resource->returnQueueReference);
+    resource->inReturnQueue.store(false, std::memory_order_release);
+    resource = next;
+  }
+}
+
+void ResourceCache::addToPendingList(Resource* resource) {
+  if (resource->inPendingList) {
     return;
   }
-  auto currentTime = std::chrono::steady_clock::now();
-  for (auto& resource : needToPurge) {
-    RemoveFromList(nonpurgeableResources, resource);
-    if (!resource->scratchKey.empty() || resource->hasExternalReferences()) {
-      AddToList(purgeableResources, resource);
-      purgeableBytes += resource->memoryUsage();
-      resource->lastUsedTime = currentTime;
-    } else {
-      removeResource(resource);
-    }
+  pendingResources.push_back(resource);
+  resource->pendingPosition = --pendingResources.end();
+  resource->inPendingList = true;
+}
+
+void ResourceCache::removeFromPendingList(Resource* resource) {
+  if (!resource->inPendingList) {
+    return;
+  }
+  pendingResources.erase(resource->pendingPosition);
+  resource->inPendingList = false;
+}
+
+void ResourceCache::addToScratchList(Resource* resource) {
+  if (resource->scratchKey.empty()) {
+    return;
+  }
+  auto& list = scratchKeyMap[resource->scratchKey];
+  list.push_back(resource);
+  resource->scratchPosition = --list.end();
+  resource->inScratchList = true;
+}
+
+void ResourceCache::removeFromScratchList(Resource* resource) {
+  if (!resource->inScratchList) {
+    return;
+  }
+  auto result = scratchKeyMap.find(resource->scratchKey);
+  auto& list = result->second;
+  list.erase(resource->scratchPosition);
+  if (list.empty()) {
+    scratchKeyMap.erase(result);
   }
+  resource->inScratchList = false;
 }
 }  // namespace tgfx
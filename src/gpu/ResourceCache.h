@@ -28,12 +28,17 @@ namespace tgfx {
 class Resource;
 
 /**
- * Manages the lifetime of all Resource instances.
+ * Manages the lifetime of all Resource instances. The resources handed out by the cache notify it
+ * through a lock-free return queue once their last user reference is dropped, which may happen on
+ * any thread. The cache only looks at the returned resources when purging, instead of scanning all
+ * resources in use.
  */
 class ResourceCache {
  public:
   explicit ResourceCache(Context* context);
 
+  ~ResourceCache();
+
   /**
    * Returns true if there is no cache at all.
    */
@@ -112,8 +117,14 @@ class ResourceCache {
   size_t purgeableBytes = 0;
   std::list<Resource*> nonpurgeableResources = {};
   std::list<Resource*> purgeableResources = {};
-  ResourceKeyMap<std::vector<Resource*>> scratchKeyMap = {};
+  // Resources that have no user references but are not purgeable yet, for example, the ones still
+  // referenced by the strong UniqueKeys of proxies. They are checked again at each purge.
+  std::list<Resource*> pendingResources = {};
+  // The purgeable resources of each ScratchKey, which can be reused by findScratchResource().
+  ResourceKeyMap<std::list<Resource*>> scratchKeyMap = {};
   ResourceKeyMap<Resource*> uniqueKeyMap = {};
+  class ReturnQueue;
+  std::shared_ptr<ReturnQueue> returnQueue = nullptr;
 
   static void AddToList(std::list<Resource*>& list, Resource* resource);
   static void RemoveFromList(std::list<Resource*>& list, Resource* resource);
@@ -121,6 +132,15 @@ class ResourceCache {
 
   void releaseAll(bool releaseGPU);
   void processUnreferencedResources();
+  void dropReturnedResources();
+  bool processReturnedResources(std::chrono::steady_clock::time_point currentTime);
+  void processPendingResources(std::chrono::steady_clock::time_point currentTime);
+  bool processUnreferencedResource(Resource* resource,
+                                   std::chrono::steady_clock::time_point currentTime);
+  void addToPendingList(Resource* resource);
+  void removeFromPendingList(Resource* resource);
+  void addToScratchList(Resource* resource);
+  void removeFromScratchList(Resource* resource);
   std::shared_ptr<Resource> addResource(Resource* resource, const ScratchKey& scratchKey);
   std::shared_ptr<Resource> refResource(Resource* resource);
   void removeResource(Resource* resource);
@@ -17,7 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ResourceProvider.h"
+#include "GlyphAtlas.h"
 #include "GradientCache.h"
+#include "ImageAtlas.h"
 #include "core/DataSource.h"
 #include "core/utils/Log.h"
 #include "ops/RRectDrawOp.h"
@@ -26,6 +28,8 @@
 #include "tgfx/core/Data.h"
 
 namespace tgfx {
+static constexpr size_t UniformBlockSize = 1 << 16;
+
 class PatternedIndexBufferProvider : public DataSource<Data> {
  public:
   PatternedIndexBufferProvider(const uint16_t* pattern, uint16_t patternSize, uint16_t reps,
@@ -64,6 +68,11 @@ ResourceProvider::~ResourceProvider() {
   DEBUG_ASSERT(_aaQuadIndexBuffer == nullptr);
   DEBUG_ASSERT(_nonAAQuadIndexBuffer == nullptr);
   delete _gradientCache;
+  delete _glyphAtlas;
+  delete _imageAtlas;
+  delete _vertexAllocator;
+  delete _uniformAllocator;
+  delete _shapeBufferArena;
 }
 
 std::shared_ptr<Texture> ResourceProvider::getGradient(const Color* colors, const float* positions,
@@ -74,6 +83,43 @@ std::shared_ptr<Texture> ResourceProvider::getGradient(const Color* colors, cons
   return _gradientCache->getGradient(context, colors, positions, count);
 }
 
+GlyphAtlas* ResourceProvider::glyphAtlas() {
+  if (_glyphAtlas == nullptr) {
+    _glyphAtlas = new GlyphAtlas(context);
+  }
+  return _glyphAtlas;
+}
+
+ImageAtlas* ResourceProvider::imageAtlas() {
+  if (_imageAtlas == nullptr) {
+    _imageAtlas = new ImageAtlas(context);
+  }
+  return _imageAtlas;
+}
+
+StreamingBufferAllocator* ResourceProvider::vertexAllocator() {
+  if (_vertexAllocator == nullptr) {
+    _vertexAllocator = new StreamingBufferAllocator(context, BufferType::Vertex);
+  }
+  return _vertexAllocator;
+}
+
+StreamingBufferAllocator* ResourceProvider::uniformAllocator() {
+  if (_uniformAllocator == nullptr) {
+    auto alignment = static_cast<size_t>(context->caps()->uniformBufferOffsetAlignment);
+    _uniformAllocator = new StreamingBufferAllocator(context, BufferType::Uniform,
+                                                     UniformBlockSize, alignment);
+  }
+  return _uniformAllocator;
+}
+
+GpuBufferArena* ResourceProvider::shapeBufferArena() {
+  if (_shapeBufferArena == nullptr) {
+    _shapeBufferArena = new GpuBufferArena(context, BufferType::Vertex);
+  }
+  return _shapeBufferArena;
+}
+
 static constexpr uint16_t kVerticesPerNonAAQuad = 4;
 static constexpr uint16_t kIndicesPerNonAAQuad = 6;
 
@@ -205,11 +251,92 @@ uint16_t ResourceProvider::NumIndicesPerRRect() {
   return kIndicesPerRRect;
 }
 
-void ResourceProvider::releaseAll() {
+// clang-format off
+static constexpr float kNonAAQuadUnitVertices[] = {
+  1, 1,
+  1, 0,
+  0, 1,
+  0, 0,
+};
+
+static constexpr float kAAQuadUnitVertices[] = {
+  // inset quad with full coverage
+  0, 0, 1,
+  0, 1, 1,
+  1, 0, 1,
+  1, 1, 1,
+  // outset quad with zero coverage
+  0, 0, 0,
+  0, 1, 0,
+  1, 0, 0,
+  1, 1, 0,
+};
+// clang-format on
+
+static std::shared_ptr<GpuBufferProxy> MakeUnitBuffer(Context* context, const float* vertices,
+                                                      size_t count) {
+  auto data = Data::MakeWithCopy(vertices, count * sizeof(float));
+  return GpuBufferProxy::MakeFrom(context, std::move(data), BufferType::Vertex, 0);
+}
+
+std::shared_ptr<GpuBufferProxy> ResourceProvider::nonAAQuadUnitBuffer() {
+  if (_nonAAQuadUnitBuffer == nullptr) {
+    _nonAAQuadUnitBuffer = MakeUnitBuffer(context, kNonAAQuadUnitVertices,
+                                          sizeof(kNonAAQuadUnitVertices) / sizeof(float));
+  }
+  return _nonAAQuadUnitBuffer;
+}
+
+std::shared_ptr<GpuBufferProxy> ResourceProvider::aaQuadUnitBuffer() {
+  if (_aaQuadUnitBuffer == nullptr) {
+    _aaQuadUnitBuffer = MakeUnitBuffer(context, kAAQuadUnitVertices,
+                                       sizeof(kAAQuadUnitVertices) / sizeof(float));
+  }
+  return _aaQuadUnitBuffer;
+}
+
+std::shared_ptr<GpuBufferProxy> ResourceProvider::rRectUnitBuffer() {
+  if (_rRectUnitBuffer == nullptr) {
+    // Each row or column selects the left/top (0) or right/bottom (1) edge of the bounds, and moves
+    // inwards (+1), outwards (-1) or not at all (0) by the outer radius.
+    static constexpr float EdgeSelectors[4] = {0, 0, 1, 1};
+    static constexpr float RadiusOffsets[4] = {0, 1, -1, 0};
+    float vertices[16 * 4] = {};
+    int index = 0;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        vertices[index++] = EdgeSelectors[j];
+        vertices[index++] = EdgeSelectors[i];
+        vertices[index++] = RadiusOffsets[j];
+        vertices[index++] = RadiusOffsets[i];
+      }
+    }
+    _rRectUnitBuffer = MakeUnitBuffer(context, vertices, 16 * 4);
+  }
+  return _rRectUnitBuffer;
+}
+
+void ResourceProvider::releaseAll(bool releaseGPU) {
   if (_gradientCache) {
     _gradientCache->releaseAll();
   }
+  delete _glyphAtlas;
+  _glyphAtlas = nullptr;
+  delete _imageAtlas;
+  _imageAtlas = nullptr;
+  if (_vertexAllocator) {
+    _vertexAllocator->releaseAll(releaseGPU);
+  }
+  if (_uniformAllocator) {
+    _uniformAllocator->releaseAll(releaseGPU);
+  }
+  if (_shapeBufferArena) {
+    _shapeBufferArena->releaseAll();
+  }
   _aaQuadIndexBuffer = nullptr;
   _nonAAQuadIndexBuffer = nullptr;
+  _nonAAQuadUnitBuffer = nullptr;
+  _aaQuadUnitBuffer = nullptr;
+  _rRectUnitBuffer = nullptr;
 }
 }  // namespace tgfx
@@ -18,12 +18,16 @@
 
 #pragma once
 
+#include "gpu/GpuBufferArena.h"
+#include "gpu/StreamingBufferAllocator.h"
 #include "gpu/Texture.h"
 #include "gpu/proxies/GpuBufferProxy.h"
 #include "tgfx/gpu/Context.h"
 
 namespace tgfx {
 class GradientCache;
+class GlyphAtlas;
+class ImageAtlas;
 
 class ResourceProvider {
  public:
@@ -34,6 +38,33 @@ class ResourceProvider {
 
   std::shared_ptr<Texture> getGradient(const Color* colors, const float* positions, int count);
 
+  /**
+   * Returns the glyph atlas shared by all text draws in the context.
+   */
+  GlyphAtlas* glyphAtlas();
+
+  /**
+   * Returns the image atlas shared by all small image draws in the context.
+   */
+  ImageAtlas* imageAtlas();
+
+  /**
+   * Returns the allocator that streams the transient vertex data of each flush into a ring of
+   * shared vertex buffers.
+   */
+  StreamingBufferAllocator* vertexAllocator();
+
+  /**
+   * Returns the allocator that streams the uniform blocks of each draw into a ring of shared
+   * uniform buffers. Only used if Caps::uniformBufferSupport is true.
+   */
+  StreamingBufferAllocator* uniformAllocator();
+
+  /**
+   * Returns the arena that packs the triangles of cached shapes into shared vertex buffers.
+   */
+  GpuBufferArena* shapeBufferArena();
+
   std::shared_ptr<GpuBufferProxy> nonAAQuadIndexBuffer();
 
   static uint16_t NumIndicesPerNonAAQuad();
@@ -46,13 +77,40 @@ class ResourceProvider {
 
   static uint16_t NumIndicesPerRRect();
 
-  void releaseAll();
+  /**
+   * Returns the vertex buffer of a single non-AA unit quad used by instanced rect draws. Each
+   * vertex holds the corner in the unit square, ordered as a triangle strip.
+   */
+  std::shared_ptr<GpuBufferProxy> nonAAQuadUnitBuffer();
+
+  /**
+   * Returns the vertex buffer of a single AA unit quad used by instanced rect draws. Each vertex
+   * holds the corner in the unit square and the coverage, matching the layout of
+   * aaQuadIndexBuffer().
+   */
+  std::shared_ptr<GpuBufferProxy> aaQuadUnitBuffer();
+
+  /**
+   * Returns the vertex buffer of a single round rect 9-patch used by instanced round rect draws,
+   * matching the layout of rRectIndexBuffer().
+   */
+  std::shared_ptr<GpuBufferProxy> rRectUnitBuffer();
+
+  void releaseAll(bool releaseGPU);
 
  private:
   Context* context = nullptr;
   GradientCache* _gradientCache = nullptr;
+  GlyphAtlas* _glyphAtlas = nullptr;
+  ImageAtlas* _imageAtlas = nullptr;
+  StreamingBufferAllocator* _vertexAllocator = nullptr;
+  StreamingBufferAllocator* _uniformAllocator = nullptr;
+  GpuBufferArena* _shapeBufferArena = nullptr;
   std::shared_ptr<GpuBufferProxy> _aaQuadIndexBuffer = nullptr;
   std::shared_ptr<GpuBufferProxy> _nonAAQuadIndexBuffer = nullptr;
   std::shared_ptr<GpuBufferProxy> _rRectIndexBuffer = nullptr;
+  std::shared_ptr<GpuBufferProxy> _nonAAQuadUnitBuffer = nullptr;
+  std::shared_ptr<GpuBufferProxy> _aaQuadUnitBuffer = nullptr;
+  std::shared_ptr<GpuBufferProxy> _rRectUnitBuffer = nullptr;
 };
 }  // namespace tgfx
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingBufferAllocator.h"
+#include <algorithm>
+#include "gpu/Gpu.h"
+
+namespace tgfx {
+/**
+ * The maximum number of blocks waiting for their fences. Beyond that, the oldest block is reused
+ * before its fence signals, and the driver synchronizes the writes implicitly.
+ */
+static constexpr size_t MAX_INFLIGHT_BLOCKS = 8;
+
+StreamingBufferAllocator::StreamingBufferAllocator(Context* context, BufferType bufferType,
+                                                   size_t blockSize, size_t alignment)
+    : context(context), bufferType(bufferType), blockSize(blockSize),
+      alignment(std::max(alignment, static_cast<size_t>(1))) {
+}
+
+BufferSlice StreamingBufferAllocator::write(const void* data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return {};
+  }
+  auto offset = (currentOffset + alignment - 1) / alignment * alignment;
+  if (usedBlocks.empty() || offset + size > usedBlocks.back().buffer->size()) {
+    if (!nextBlock(size)) {
+      return {};
+    }
+    offset = 0;
+  }
+  auto& buffer = usedBlocks.back().buffer;
+  context->gpu()->writeBuffer(buffer.get(), offset, data, size);
+  currentOffset = offset + size;
+  _usedBytes += size;
+  return {buffer, offset};
+}
+
+bool StreamingBufferAllocator::nextBlock(size_t minSize) {
+  auto gpu = context->gpu();
+  while (!inflightBlocks.empty() && gpu->checkFence(inflightBlocks.front().fence)) {
+    auto& block = inflightBlocks.front();
+    gpu->deleteFence(block.fence);
+    block.fence = 0;
+    freeBlocks.push_back(std::move(block));
+    inflightBlocks.pop_front();
+  }
+  currentOffset = 0;
+  for (auto block = freeBlocks.begin(); block != freeBlocks.end(); ++block) {
+    if (block->buffer->size() >= minSize) {
+      usedBlocks.push_back(std::move(*block));
+      freeBlocks.erase(block);
+      return true;
+    }
+  }
+  if (inflightBlocks.size() >= MAX_INFLIGHT_BLOCKS &&
+      inflightBlocks.front().buffer->size() >= minSize) {
+    auto block = std::move(inflightBlocks.front());
+    inflightBlocks.pop_front();
+    gpu->deleteFence(block.fence);
+    block.fence = 0;
+    usedBlocks.push_back(std::move(block));
+    return true;
+  }
+  // The blocks are rewritten every few flushes, which is what dynamic storage is meant for.
+  auto buffer = GpuBuffer::Make(context, bufferType, nullptr, std::max(blockSize, minSize),
+                                BufferUsage::Dynamic);
+  if (buffer == nullptr) {
+    return false;
+  }
+  usedBlocks.push_back({std::move(buffer), 0});
+  return true;
+}
+
+void StreamingBufferAllocator::recycle() {
+  auto gpu = context->gpu();
+  for (auto& block : usedBlocks) {
+    if (block.buffer->size() > blockSize) {
+      // Release the oversized blocks to keep the memory usage of the ring bounded.
+      continue;
+    }
+    block.fence = gpu->insertFence();
+    if (block.fence == 0) {
+      // Without fences, rely on the implicit synchronization of the driver.
+      freeBlocks.push_back(std::move(block));
+    } else {
+      inflightBlocks.push_back(std::move(block));
+    }
+  }
+  usedBlocks.clear();
+  currentOffset = 0;
+  _usedBytes = 0;
+  _generation++;
+}
+
+void StreamingBufferAllocator::releaseAll(bool releaseGPU) {
+  if (releaseGPU) {
+    auto gpu = context->gpu();
+    for (auto& block : inflightBlocks) {
+      gpu->deleteFence(block.fence);
+    }
+  }
+  inflightBlocks.clear();
+  freeBlocks.clear();
+  usedBlocks.clear();
+  currentOffset = 0;
+  _usedBytes = 0;
+  _generation++;
+}
+}  // namespace tgfx
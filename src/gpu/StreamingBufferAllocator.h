@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include "gpu/GpuBuffer.h"
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * BufferSlice references a range of bytes inside a GpuBuffer.
+ */
+struct BufferSlice {
+  std::shared_ptr<GpuBuffer> buffer = nullptr;
+  size_t offset = 0;
+};
+
+/**
+ * StreamingBufferAllocator suballocates the transient vertex data of a flush from a ring of large
+ * GpuBuffers, so that draws don't need a buffer object of their own or a glBufferData() call that
+ * forces the driver to orphan the storage. The data is written in place with the offset advancing
+ * through the current block. Blocks written during a flush are fenced when recycle() is called and
+ * are only reused once the GPU has finished reading them, which keeps the writes from stalling on
+ * draws still in flight.
+ */
+class StreamingBufferAllocator {
+ public:
+  /**
+   * The default size of each block in the ring, in bytes.
+   */
+  static constexpr size_t DefaultBlockSize = 1 << 20;
+
+  /**
+   * The default alignment of each allocation, which satisfies all vertex attribute types.
+   */
+  static constexpr size_t DefaultAlignment = 16;
+
+  StreamingBufferAllocator(Context* context, BufferType bufferType,
+                           size_t blockSize = DefaultBlockSize,
+                           size_t alignment = DefaultAlignment);
+
+  /**
+   * Copies the data into the ring and returns the buffer and the byte offset it was written at.
+   * Returns an empty slice if the data is empty or the buffer could not be created.
+   */
+  BufferSlice write(const void* data, size_t size);
+
+  /**
+   * Returns the number of bytes written since the last call to recycle().
+   */
+  size_t usedBytes() const {
+    return _usedBytes;
+  }
+
+  /**
+   * Returns a number that changes every time recycle() or releaseAll() is called. Slices returned
+   * by write() stay valid as long as the generation is unchanged.
+   */
+  uint64_t generation() const {
+    return _generation;
+  }
+
+  /**
+   * Fences the blocks written since the last call and moves the blocks the GPU has finished
+   * reading back to the free list. Must be called once at the end of each flush.
+   */
+  void recycle();
+
+  /**
+   * Releases all blocks and fences. If releaseGPU is false, the fences are abandoned since the GPU
+   * context may no longer be current.
+   */
+  void releaseAll(bool releaseGPU);
+
+ private:
+  struct Block {
+    std::shared_ptr<GpuBuffer> buffer = nullptr;
+    uint64_t fence = 0;
+  };
+
+  Context* context = nullptr;
+  BufferType bufferType = BufferType::Vertex;
+  size_t blockSize = DefaultBlockSize;
+  size_t alignment = DefaultAlignment;
+  size_t _usedBytes = 0;
+  uint64_t _generation = 0;
+  std::vector<Block> freeBlocks = {};
+  std::vector<Block> usedBlocks = {};
+  std::deque<Block> inflightBlocks = {};
+  size_t currentOffset = 0;
+
+  bool nextBlock(size_t minSize);
+};
+}  // namespace tgfx
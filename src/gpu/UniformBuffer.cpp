@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "UniformBuffer.h"
+#include <algorithm>
 #include "core/utils/Log.h"
 
 namespace tgfx {
@@ -47,27 +48,46 @@ UniformBuffer::UniformBuffer(std::vector<Uniform> uniformList) : uniforms(std::m
   size_t index = 0;
   size_t offset = 0;
   for (auto& uniform : uniforms) {
-    uniformMap[uniform.name] = index++;
+    auto slot = static_cast<size_t>(uniform.processorIndex + 1);
+    if (slot >= slots.size()) {
+      slots.resize(slot + 1);
+    }
+    auto& entries = slots[slot];
+    DEBUG_ASSERT(std::none_of(entries.begin(), entries.end(), [&](const HandleEntry& entry) {
+      return entry.handle == uniform.handle;
+    }));
+    entries.push_back({uniform.handle, index++});
     offsets.push_back(offset);
     offset += uniform.size();
   }
 }
 
-void UniformBuffer::setData(const std::string& name, const Matrix& matrix) {
+void UniformBuffer::setData(UniformHandle handle, const Matrix& matrix) {
   float values[6];
   matrix.get6(values);
   float data[] = {values[0], values[3], 0, values[1], values[4], 0, values[2], values[5], 1};
-  onSetData(name, data, sizeof(data));
+  onSetData(handle, data, sizeof(data));
 }
 
-void UniformBuffer::onSetData(const std::string& name, const void* data, size_t size) {
-  auto key = name + nameSuffix;
-  auto result = uniformMap.find(key);
-  if (result == uniformMap.end()) {
-    LOGE("UniformBuffer::onSetData() uniform '%s' not found!", name.c_str());
+size_t UniformBuffer::findUniform(UniformHandle handle) const {
+  auto slot = static_cast<size_t>(processorIndex + 1);
+  if (slot < slots.size()) {
+    // A processor declares only a few uniforms, a linear scan beats any map here.
+    for (auto& entry : slots[slot]) {
+      if (entry.handle == handle) {
+        return entry.index;
+      }
+    }
+  }
+  return uniforms.size();
+}
+
+void UniformBuffer::onSetData(UniformHandle handle, const void* data, size_t size) {
+  auto index = findUniform(handle);
+  if (index >= uniforms.size()) {
+    LOGE("UniformBuffer::onSetData() uniform not found for processor %d!", processorIndex);
     return;
   }
-  auto index = result->second;
   auto uniformSize = uniforms[index].size();
   if (uniformSize != size) {
     LOGE("UniformBuffer::onSetData() data size mismatch!");
@@ -76,4 +96,4 @@ void UniformBuffer::onSetData(const std::string& name, const void* data, size_t
   onCopyData(index, offsets[index], size, data);
 }
 
-}  // namespace tgfx
\ No newline at end of file
+}  // namespace tgfx
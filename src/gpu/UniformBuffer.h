@@ -18,12 +18,68 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 #include "tgfx/core/Matrix.h"
 
 namespace tgfx {
+/**
+ * UniformHandle identifies a uniform by the unmangled name that its processor declared it with
+ * through UniformHandler::addUniform(). It is a 32-bit hash of the name, computed at compile time
+ * for constant names, so processors can address their uniforms on the draw path without building
+ * or comparing strings.
+ */
+class UniformHandle {
+ public:
+  /**
+   * Creates a handle for the uniform named with the given prefix followed by the decimal index,
+   * which equals UniformHandle(prefix + std::to_string(index)) without building the string.
+   */
+  static constexpr UniformHandle MakeIndexed(std::string_view prefix, int index) {
+    UniformHandle handle(prefix);
+    char digits[12] = {};
+    size_t count = 0;
+    auto value = static_cast<unsigned>(index < 0 ? -index : index);
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value > 0);
+    if (index < 0) {
+      digits[count++] = '-';
+    }
+    while (count > 0) {
+      handle.append(digits[--count]);
+    }
+    return handle;
+  }
+
+  constexpr UniformHandle() = default;
+
+  constexpr explicit UniformHandle(std::string_view name) {
+    for (auto c : name) {
+      append(c);
+    }
+  }
+
+  constexpr bool operator==(const UniformHandle& that) const {
+    return value == that.value;
+  }
+
+  constexpr bool operator!=(const UniformHandle& that) const {
+    return value != that.value;
+  }
+
+ private:
+  // The FNV-1a hash of the name.
+  uint32_t value = 2166136261u;
+
+  constexpr void append(char c) {
+    value = (value ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+};
+
 /**
  * Reflected description of a uniform variable in the GPU program.
  */
@@ -47,6 +103,15 @@ struct Uniform {
 
   std::string name;
   Type type;
+  /**
+   * The handle of the unmangled name the uniform was declared with.
+   */
+  UniformHandle handle = {};
+  /**
+   * The index of the processor that declared the uniform in the pipeline, or -1 if it was declared
+   * outside any processor.
+   */
+  int processorIndex = -1;
 
   /**
    * Returns the size of the uniform in bytes.
@@ -60,26 +125,28 @@ struct Uniform {
 class UniformBuffer {
  public:
   /**
-   * Constructs a uniform buffer with the specified uniforms.
+   * Constructs a uniform buffer with the specified uniforms, and resolves the uniform handles of
+   * each processor to their indices in the buffer.
    */
   explicit UniformBuffer(std::vector<Uniform> uniforms);
 
   virtual ~UniformBuffer() = default;
 
   /**
-   * Copies value into the uniform buffer. The data must have the same size as the uniform specified
-   * by name.
+   * Copies value into the uniform specified by the handle, which is looked up among the uniforms
+   * declared by the processor currently setting its data. The data must have the same size as the
+   * uniform.
    */
   template <typename T>
   std::enable_if_t<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, void> setData(
-      const std::string& name, const T& value) {
-    onSetData(name, &value, sizeof(value));
+      UniformHandle handle, const T& value) {
+    onSetData(handle, &value, sizeof(value));
   }
 
   /**
    * Convenience method for copying a Matrix to a 3x3 matrix in column-major order.
    */
-  void setData(const std::string& name, const Matrix& matrix);
+  void setData(UniformHandle handle, const Matrix& matrix);
 
  protected:
   std::vector<Uniform> uniforms = {};
@@ -87,15 +154,24 @@ class UniformBuffer {
 
   /**
    * Copies data into the uniform buffer. The data must have the same size as the uniform specified
-   * by name.
+   * by index.
    */
   virtual void onCopyData(size_t index, size_t offset, size_t size, const void* data) = 0;
 
  private:
-  std::string nameSuffix = "";
-  std::unordered_map<std::string, size_t> uniformMap = {};
+  struct HandleEntry {
+    UniformHandle handle = {};
+    size_t index = 0;
+  };
+
+  int processorIndex = -1;
+  // The uniforms declared by each processor, indexed by processorIndex + 1. Slot 0 holds the
+  // uniforms declared outside any processor.
+  std::vector<std::vector<HandleEntry>> slots = {};
+
+  size_t findUniform(UniformHandle handle) const;
 
-  void onSetData(const std::string& name, const void* data, size_t size);
+  void onSetData(UniformHandle handle, const void* data, size_t size);
 
   friend class Pipeline;
 };
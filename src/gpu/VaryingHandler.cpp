@@ -32,6 +32,9 @@ void VaryingHandler::emitAttributes(const GeometryProcessor& processor) {
   for (const auto* attr : processor.vertexAttributes()) {
     addAttribute(attr->asShaderVar());
   }
+  for (const auto* attr : processor.instanceAttributes()) {
+    addAttribute(attr->asShaderVar());
+  }
 }
 
 void VaryingHandler::addAttribute(const ShaderVar& var) {
@@ -19,9 +19,11 @@
 #pragma once
 
 #include "ShaderBuilder.h"
+#include "gpu/UniformBuffer.h"
 
 namespace tgfx {
 static const std::string RTAdjustName = "tgfx_RTAdjust";
+static constexpr UniformHandle RTAdjustHandle("tgfx_RTAdjust");
 
 class VertexShaderBuilder : public ShaderBuilder {
  public:
@@ -95,6 +95,35 @@ static void InitVertexArray(const GLProcGetter* getter, GLFunctions* functions,
   }
 }
 
+static void InitInstancedDraw(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(3, 0)) {
+    functions->drawArraysInstanced =
+        reinterpret_cast<GLDrawArraysInstanced*>(getter->getProcAddress("glDrawArraysInstanced"));
+    functions->drawElementsInstanced = reinterpret_cast<GLDrawElementsInstanced*>(
+        getter->getProcAddress("glDrawElementsInstanced"));
+    functions->vertexAttribDivisor =
+        reinterpret_cast<GLVertexAttribDivisor*>(getter->getProcAddress("glVertexAttribDivisor"));
+  }
+}
+
+static void InitProgramBinary(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(3, 0)) {
+    functions->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+    functions->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+    functions->programParameteri =
+        reinterpret_cast<GLProgramParameteri*>(getter->getProcAddress("glProgramParameteri"));
+  } else if (info.hasExtension("GL_OES_get_program_binary")) {
+    functions->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinaryOES"));
+    functions->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinaryOES"));
+  }
+}
+
 void GLAssembleGLESInterface(const GLProcGetter* getter, GLFunctions* functions,
                              const GLInfo& info) {
   if (info.hasExtension("GL_NV_texture_barrier")) {
@@ -105,5 +134,7 @@ void GLAssembleGLESInterface(const GLProcGetter* getter, GLFunctions* functions,
   InitRenderbufferStorageMultisample(getter, functions, info);
   InitFramebufferTexture2DMultisample(getter, functions, info);
   InitVertexArray(getter, functions, info);
+  InitInstancedDraw(getter, functions, info);
+  InitProgramBinary(getter, functions, info);
 }
 }  // namespace tgfx
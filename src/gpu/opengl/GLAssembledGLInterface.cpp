@@ -72,10 +72,49 @@ static void InitRenderbufferStorageMultisample(const GLProcGetter* getter, GLFun
   }
 }
 
+static void InitInstancedDraw(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(3, 3)) {
+    functions->drawArraysInstanced =
+        reinterpret_cast<GLDrawArraysInstanced*>(getter->getProcAddress("glDrawArraysInstanced"));
+    functions->drawElementsInstanced = reinterpret_cast<GLDrawElementsInstanced*>(
+        getter->getProcAddress("glDrawElementsInstanced"));
+    functions->vertexAttribDivisor =
+        reinterpret_cast<GLVertexAttribDivisor*>(getter->getProcAddress("glVertexAttribDivisor"));
+  }
+}
+
+static void InitProgramBinary(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary")) {
+    functions->getProgramBinary =
+        reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+    functions->programBinary =
+        reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+    functions->programParameteri =
+        reinterpret_cast<GLProgramParameteri*>(getter->getProcAddress("glProgramParameteri"));
+  }
+}
+
+static void InitUniformBuffer(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(3, 1) || info.hasExtension("GL_ARB_uniform_buffer_object")) {
+    functions->bindBufferRange =
+        reinterpret_cast<GLBindBufferRange*>(getter->getProcAddress("glBindBufferRange"));
+    functions->getUniformBlockIndex =
+        reinterpret_cast<GLGetUniformBlockIndex*>(getter->getProcAddress("glGetUniformBlockIndex"));
+    functions->uniformBlockBinding =
+        reinterpret_cast<GLUniformBlockBinding*>(getter->getProcAddress("glUniformBlockBinding"));
+  }
+}
+
 void GLAssembleGLInterface(const GLProcGetter* getter, GLFunctions* functions, const GLInfo& info) {
   InitTextureBarrier(getter, functions, info);
   InitBlitFrameBuffer(getter, functions, info);
   InitRenderbufferStorageMultisample(getter, functions, info);
   InitVertexArray(getter, functions, info);
+  InitInstancedDraw(getter, functions, info);
+  InitProgramBinary(getter, functions, info);
+  InitUniformBuffer(getter, functions, info);
 }
 }  // namespace tgfx
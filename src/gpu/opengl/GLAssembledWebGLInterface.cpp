@@ -40,6 +40,18 @@ static void InitVertexArray(const GLProcGetter* getter, GLFunctions* functions,
   }
 }
 
+static void InitInstancedDraw(const GLProcGetter* getter, GLFunctions* functions,
+                              const GLInfo& info) {
+  if (info.version >= GL_VER(2, 0)) {
+    functions->drawArraysInstanced =
+        reinterpret_cast<GLDrawArraysInstanced*>(getter->getProcAddress("glDrawArraysInstanced"));
+    functions->drawElementsInstanced = reinterpret_cast<GLDrawElementsInstanced*>(
+        getter->getProcAddress("glDrawElementsInstanced"));
+    functions->vertexAttribDivisor =
+        reinterpret_cast<GLVertexAttribDivisor*>(getter->getProcAddress("glVertexAttribDivisor"));
+  }
+}
+
 void GLAssembleWebGLInterface(const GLProcGetter* getter, GLFunctions* functions,
                               const GLInfo& info) {
   if (info.version >= GL_VER(2, 0)) {
@@ -49,5 +61,6 @@ void GLAssembleWebGLInterface(const GLProcGetter* getter, GLFunctions* functions
         getter->getProcAddress("glRenderbufferStorageMultisample"));
   }
   InitVertexArray(getter, functions, info);
+  InitInstancedDraw(getter, functions, info);
 }
 }  // namespace tgfx
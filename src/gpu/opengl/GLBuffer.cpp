@@ -18,16 +18,24 @@
 
 #include "GLBuffer.h"
 #include "GLContext.h"
+#include "GLState.h"
 #include "GLUtil.h"
 #include "core/utils/UniqueID.h"
 
 namespace tgfx {
-static unsigned GetTarget(BufferType bufferType) {
-  return bufferType == BufferType::Index ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+unsigned GLBuffer::GetTarget(BufferType bufferType) {
+  switch (bufferType) {
+    case BufferType::Index:
+      return GL_ELEMENT_ARRAY_BUFFER;
+    case BufferType::Uniform:
+      return GL_UNIFORM_BUFFER;
+    default:
+      return GL_ARRAY_BUFFER;
+  }
 }
 
 std::shared_ptr<GpuBuffer> GpuBuffer::Make(Context* context, BufferType bufferType,
-                                           const void* buffer, size_t size) {
+                                           const void* buffer, size_t size, BufferUsage usage) {
   // Clear the GL errors generated by the previous operations.
   ClearGLError(context);
   auto gl = GLFunctions::Get(context);
@@ -36,14 +44,19 @@ std::shared_ptr<GpuBuffer> GpuBuffer::Make(Context* context, BufferType bufferTy
   if (bufferID == 0) {
     return nullptr;
   }
-  auto glBuffer = Resource::AddToCache(context, new GLBuffer(bufferType, size, bufferID));
+  auto glBuffer = Resource::AddToCache(context, new GLBuffer(bufferType, size, usage, bufferID));
   if (size == 0) {
     return glBuffer;
   }
-  auto target = GetTarget(bufferType);
-  gl->bindBuffer(target, glBuffer->_bufferID);
-  gl->bufferData(target, static_cast<GLsizeiptr>(size), buffer, GL_STATIC_DRAW);
-  gl->bindBuffer(target, 0);
+  auto target = GLBuffer::GetTarget(bufferType);
+  auto state = GLState::Get(context);
+  state->bindBuffer(target, glBuffer->_bufferID);
+  unsigned glUsage = GL_STATIC_DRAW;
+  if (usage == BufferUsage::Dynamic) {
+    glUsage = GL_DYNAMIC_DRAW;
+  }
+  gl->bufferData(target, static_cast<GLsizeiptr>(size), buffer, glUsage);
+  state->bindBuffer(target, 0);
   if (!CheckGLError(context)) {
     return nullptr;
   }
@@ -55,9 +68,11 @@ void GLBuffer::onReleaseGPU() {
     auto gl = GLFunctions::Get(context);
     // Resize the buffer to zero before deleting it can save significant time on some platforms.
     auto target = GetTarget(_bufferType);
-    gl->bindBuffer(target, _bufferID);
+    auto state = GLState::Get(context);
+    state->bindBuffer(target, _bufferID);
     gl->bufferData(target, 0, nullptr, GL_STATIC_DRAW);
     gl->deleteBuffers(1, &_bufferID);
+    state->onDeleteBuffer(_bufferID);
     _bufferID = 0;
   }
 }
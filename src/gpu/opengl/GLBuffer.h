@@ -23,6 +23,11 @@
 namespace tgfx {
 class GLBuffer : public GpuBuffer {
  public:
+  /**
+   * Returns the GL binding target of the specified buffer type.
+   */
+  static unsigned GetTarget(BufferType bufferType);
+
   unsigned bufferID() const {
     return _bufferID;
   }
@@ -33,8 +38,8 @@ class GLBuffer : public GpuBuffer {
  private:
   unsigned _bufferID = 0;
 
-  GLBuffer(BufferType bufferType, size_t size, unsigned bufferID)
-      : GpuBuffer(bufferType, size), _bufferID(bufferID) {
+  GLBuffer(BufferType bufferType, size_t size, BufferUsage usage, unsigned bufferID)
+      : GpuBuffer(bufferType, size, usage), _bufferID(bufferID) {
   }
 
   friend class GpuBuffer;
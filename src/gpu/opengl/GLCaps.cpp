@@ -183,6 +183,20 @@ GLCaps::GLCaps(const GLInfo& info) {
   info.getIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxFragmentSamplers);
   initMSAASupport(info);
   initFormatMap(info);
+  if (programBinarySupport) {
+    int binaryFormatCount = 0;
+    info.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    programBinarySupport = binaryFormatCount > 0;
+  }
+  if (uniformBufferSupport) {
+    info.getIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+    uniformBufferSupport = uniformBufferOffsetAlignment > 0;
+  }
+  for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    auto string = reinterpret_cast<const char*>(info.getString(static_cast<unsigned>(name)));
+    driverInfo += string ? string : "";
+    driverInfo += "\n";
+  }
 }
 
 const TextureFormat& GLCaps::getTextureFormat(PixelFormat pixelFormat) const {
@@ -251,6 +265,12 @@ void GLCaps::initGLSupport(const GLInfo& info) {
                             info.hasExtension("GL_NV_texture_barrier");
   }
   semaphoreSupport = version >= GL_VER(3, 2) || info.hasExtension("GL_ARB_sync");
+  instancedDrawSupport = version >= GL_VER(3, 3) && vertexArrayObjectSupport;
+  programBinarySupport = version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary");
+  // The GLSL 1.50 shaders generated for desktop GL can declare uniform blocks. The GLSL ES 1.00
+  // shaders generated for GLES and WebGL can't, so they keep setting uniforms individually.
+  uniformBufferSupport =
+      version >= GL_VER(3, 1) || info.hasExtension("GL_ARB_uniform_buffer_object");
   if (version < GL_VER(1, 3) && !info.hasExtension("GL_ARB_texture_border_clamp")) {
     clampToBorderSupport = false;
   }
@@ -284,6 +304,8 @@ void GLCaps::initGLESSupport(const GLInfo& info) {
     frameBufferFetchRequiresEnablePerSample = true;
   }
   semaphoreSupport = version >= GL_VER(3, 0) || info.hasExtension("GL_APPLE_sync");
+  instancedDrawSupport = version >= GL_VER(3, 0) && vertexArrayObjectSupport;
+  programBinarySupport = version >= GL_VER(3, 0) || info.hasExtension("GL_OES_get_program_binary");
   if (version < GL_VER(3, 2) && !info.hasExtension("GL_EXT_texture_border_clamp") &&
       !info.hasExtension("GL_NV_texture_border_clamp") &&
       !info.hasExtension("GL_OES_texture_border_clamp")) {
@@ -304,6 +326,7 @@ void GLCaps::initWebGLSupport(const GLInfo& info) {
   textureBarrierSupport = false;
   frameBufferFetchSupport = false;
   semaphoreSupport = version >= GL_VER(2, 0);
+  instancedDrawSupport = version >= GL_VER(2, 0) && vertexArrayObjectSupport;
   clampToBorderSupport = false;
   npotTextureTileSupport = version >= GL_VER(2, 0);
   mipmapSupport = npotTextureTileSupport;
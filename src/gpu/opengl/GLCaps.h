@@ -122,6 +122,16 @@ class GLCaps : public Caps {
   std::string frameBufferFetchColorName;
   std::string frameBufferFetchExtensionString;
   int maxFragmentSamplers = kMaxSaneSamplers;
+  /**
+   * True if linked programs can be saved with glGetProgramBinary() and restored with
+   * glProgramBinary(). WebGL never supports it.
+   */
+  bool programBinarySupport = false;
+  /**
+   * The vendor, renderer and version strings of the driver. Program binaries are only valid for
+   * the exact driver that produced them.
+   */
+  std::string driverInfo;
 
   static const GLCaps* Get(Context* context);
 
@@ -27,5 +27,6 @@ GLContext::GLContext(Device* device, const GLInterface* glInterface)
 }
 
 void GLContext::resetState() {
+  static_cast<GLGpu*>(_gpu)->state()->reset();
 }
 }  // namespace tgfx
@@ -19,8 +19,11 @@
 #include "GLGpu.h"
 #include "GLUtil.h"
 #include "core/utils/PixelFormatUtil.h"
+#include "gpu/ProgramCache.h"
+#include "gpu/opengl/GLBuffer.h"
 #include "gpu/opengl/GLRenderTarget.h"
 #include "gpu/opengl/GLSemaphore.h"
+#include "tgfx/core/Buffer.h"
 
 namespace tgfx {
 std::unique_ptr<Gpu> GLGpu::Make(Context* context) {
@@ -43,11 +46,11 @@ std::unique_ptr<TextureSampler> GLGpu::createSampler(int width, int height, Pixe
   sampler->target = GL_TEXTURE_2D;
   sampler->format = format;
   sampler->maxMipmapLevel = mipLevelCount - 1;
-  gl->bindTexture(sampler->target, sampler->id);
-  gl->texParameteri(sampler->target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  gl->texParameteri(sampler->target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  gl->texParameteri(sampler->target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  gl->texParameteri(sampler->target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  _state.bindTexture(sampler->target, sampler->id);
+  _state.setTextureParameter(sampler->target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  _state.setTextureParameter(sampler->target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  _state.setTextureParameter(sampler->target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  _state.setTextureParameter(sampler->target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   const auto& textureFormat = GLCaps::Get(context)->getTextureFormat(format);
   bool success = true;
   for (int level = 0; level < mipLevelCount && success; level++) {
@@ -61,6 +64,7 @@ std::unique_ptr<TextureSampler> GLGpu::createSampler(int width, int height, Pixe
   }
   if (!success) {
     gl->deleteTextures(1, &(sampler->id));
+    _state.onDeleteTexture(sampler->id);
     return nullptr;
   }
   return sampler;
@@ -72,6 +76,7 @@ void GLGpu::deleteSampler(TextureSampler* sampler) {
     return;
   }
   GLFunctions::Get(context)->deleteTextures(1, &glSampler->id);
+  _state.onDeleteTexture(glSampler->id);
   glSampler->id = 0;
 }
 
@@ -87,7 +92,7 @@ void GLGpu::writePixels(const TextureSampler* sampler, Rect rect, const void* pi
   gl->flush();
   auto caps = GLCaps::Get(context);
   auto glSampler = static_cast<const GLSampler*>(sampler);
-  gl->bindTexture(glSampler->target, glSampler->id);
+  _state.bindTexture(glSampler->target, glSampler->id);
   const auto& format = caps->getTextureFormat(sampler->format);
   auto bytesPerPixel = PixelFormatBytesPerPixel(sampler->format);
   gl->pixelStorei(GL_UNPACK_ALIGNMENT, static_cast<int>(bytesPerPixel));
@@ -172,20 +177,20 @@ void GLGpu::bindTexture(int unitIndex, const TextureSampler* sampler, SamplerSta
     return;
   }
   auto glSampler = static_cast<const GLSampler*>(sampler);
-  auto gl = GLFunctions::Get(context);
-  gl->activeTexture(static_cast<unsigned>(GL_TEXTURE0 + unitIndex));
-  gl->bindTexture(glSampler->target, glSampler->id);
-  gl->texParameteri(glSampler->target, GL_TEXTURE_WRAP_S,
-                    GetGLWrap(glSampler->target, samplerState.wrapModeX));
-  gl->texParameteri(glSampler->target, GL_TEXTURE_WRAP_T,
-                    GetGLWrap(glSampler->target, samplerState.wrapModeY));
+  _state.activeTexture(static_cast<unsigned>(unitIndex));
+  _state.bindTexture(glSampler->target, glSampler->id);
+  _state.setTextureParameter(glSampler->target, GL_TEXTURE_WRAP_S,
+                             GetGLWrap(glSampler->target, samplerState.wrapModeX));
+  _state.setTextureParameter(glSampler->target, GL_TEXTURE_WRAP_T,
+                             GetGLWrap(glSampler->target, samplerState.wrapModeY));
   if (samplerState.mipmapped() && (!context->caps()->mipmapSupport || !glSampler->hasMipmaps())) {
     samplerState.mipmapMode = MipmapMode::None;
   }
-  gl->texParameteri(glSampler->target, GL_TEXTURE_MIN_FILTER,
-                    FilterToGLMinFilter(samplerState.filterMode, samplerState.mipmapMode));
-  gl->texParameteri(glSampler->target, GL_TEXTURE_MAG_FILTER,
-                    FilterToGLMagFilter(samplerState.filterMode));
+  _state.setTextureParameter(
+      glSampler->target, GL_TEXTURE_MIN_FILTER,
+      FilterToGLMinFilter(samplerState.filterMode, samplerState.mipmapMode));
+  _state.setTextureParameter(glSampler->target, GL_TEXTURE_MAG_FILTER,
+                             FilterToGLMagFilter(samplerState.filterMode));
 }
 
 void GLGpu::copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture, int srcX,
@@ -196,7 +201,7 @@ void GLGpu::copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture*
   auto glRenderTarget = static_cast<const GLRenderTarget*>(renderTarget);
   gl->bindFramebuffer(GL_FRAMEBUFFER, glRenderTarget->getFrameBufferID(false));
   auto glSampler = static_cast<const GLSampler*>(texture->getSampler());
-  gl->bindTexture(glSampler->target, glSampler->id);
+  _state.bindTexture(glSampler->target, glSampler->id);
   gl->copyTexSubImage2D(glSampler->target, 0, 0, 0, srcX, srcY, texture->width(),
                         texture->height());
   if (glSampler->hasMipmaps() && glSampler->target == GL_TEXTURE_2D) {
@@ -225,13 +230,13 @@ void GLGpu::resolveRenderTarget(RenderTarget* renderTarget, const Rect& bounds)
   gl->bindFramebuffer(GL_DRAW_FRAMEBUFFER, glRT->getFrameBufferID(false));
   if (caps->msFBOType == MSFBOType::ES_Apple) {
     // Apple's extension uses the scissor as the blit bounds.
-    gl->enable(GL_SCISSOR_TEST);
-    gl->scissor(left, top, right - left, bottom - top);
+    _state.setEnabled(GL_SCISSOR_TEST, true);
+    _state.setScissor(left, top, right - left, bottom - top);
     gl->resolveMultisampleFramebuffer();
-    gl->disable(GL_SCISSOR_TEST);
+    _state.setEnabled(GL_SCISSOR_TEST, false);
   } else {
     // BlitFrameBuffer respects the scissor, so disable it.
-    gl->disable(GL_SCISSOR_TEST);
+    _state.setEnabled(GL_SCISSOR_TEST, false);
     gl->blitFramebuffer(left, top, right, bottom, left, top, right, bottom, GL_COLOR_BUFFER_BIT,
                         GL_NEAREST);
   }
@@ -243,10 +248,158 @@ void GLGpu::regenerateMipmapLevels(const TextureSampler* sampler) {
   if (!glSampler->hasMipmaps() || glSampler->target != GL_TEXTURE_2D) {
     return;
   }
-  gl->bindTexture(glSampler->target, glSampler->id);
+  _state.bindTexture(glSampler->target, glSampler->id);
   gl->generateMipmap(glSampler->target);
 }
 
+void GLGpu::writeBuffer(const GpuBuffer* buffer, size_t offset, const void* data, size_t size) {
+  auto gl = GLFunctions::Get(context);
+  auto target = GLBuffer::GetTarget(buffer->bufferType());
+  _state.bindBuffer(target, static_cast<const GLBuffer*>(buffer)->bufferID());
+  gl->bufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+uint64_t GLGpu::insertFence() {
+  auto gl = GLFunctions::Get(context);
+  if (!context->caps()->semaphoreSupport || gl->clientWaitSync == nullptr) {
+    return 0;
+  }
+  auto sync = gl->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  return reinterpret_cast<uint64_t>(sync);
+}
+
+bool GLGpu::checkFence(uint64_t fence) {
+  if (fence == 0) {
+    return false;
+  }
+  auto gl = GLFunctions::Get(context);
+  auto result = gl->clientWaitSync(reinterpret_cast<void*>(fence), 0, 0);
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void GLGpu::deleteFence(uint64_t fence) {
+  if (fence == 0) {
+    return;
+  }
+  auto gl = GLFunctions::Get(context);
+  gl->deleteSync(reinterpret_cast<void*>(fence));
+}
+
+static std::shared_ptr<Data> MakeProgramBinaryKey(Context* context, const std::string& vertex,
+                                                  const std::string& fragment) {
+  // Processor class IDs are assigned at runtime, so the program key isn't stable across launches.
+  // The generated sources are fully determined by it, and they also change along with the shader
+  // code of the library itself.
+  auto& driverInfo = GLCaps::Get(context)->driverInfo;
+  Buffer buffer(driverInfo.size() + vertex.size() + fragment.size());
+  buffer.writeRange(0, driverInfo.size(), driverInfo.data());
+  buffer.writeRange(driverInfo.size(), vertex.size(), vertex.data());
+  buffer.writeRange(driverInfo.size() + vertex.size(), fragment.size(), fragment.data());
+  return buffer.release();
+}
+
+static unsigned LoadProgramBinary(Context* context, PersistentCache* cache, const Data& key) {
+  auto binary = cache->load(key);
+  if (binary == nullptr || binary->size() <= sizeof(uint32_t)) {
+    return 0;
+  }
+  uint32_t binaryFormat = 0;
+  memcpy(&binaryFormat, binary->data(), sizeof(uint32_t));
+  auto gl = GLFunctions::Get(context);
+  auto programID = gl->createProgram();
+  gl->programBinary(programID, binaryFormat, binary->bytes() + sizeof(uint32_t),
+                    static_cast<int>(binary->size() - sizeof(uint32_t)));
+  int success = 0;
+  gl->getProgramiv(programID, GL_LINK_STATUS, &success);
+  if (!success) {
+    // The driver rejects binaries from other versions, fall back to compiling the sources.
+    gl->deleteProgram(programID);
+    ClearGLError(context);
+    return 0;
+  }
+  return programID;
+}
+
+static void StoreProgramBinary(Context* context, PersistentCache* cache, const Data& key,
+                               unsigned programID) {
+  auto gl = GLFunctions::Get(context);
+  int length = 0;
+  gl->getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  Buffer buffer(sizeof(uint32_t) + static_cast<size_t>(length));
+  unsigned binaryFormat = 0;
+  int binaryLength = 0;
+  gl->getProgramBinary(programID, length, &binaryLength, &binaryFormat,
+                       buffer.bytes() + sizeof(uint32_t));
+  if (binaryLength <= 0) {
+    return;
+  }
+  auto format = static_cast<uint32_t>(binaryFormat);
+  memcpy(buffer.data(), &format, sizeof(uint32_t));
+  auto data = Data::MakeWithoutCopy(buffer.data(), sizeof(uint32_t) + binaryLength);
+  cache->store(key, *data);
+}
+
+unsigned GLGpu::createProgram(const std::string& vertex, const std::string& fragment) {
+  auto persistentCache = context->persistentCache();
+  if (!GLCaps::Get(context)->programBinarySupport) {
+    persistentCache = nullptr;
+  }
+  if (persistentCache == nullptr) {
+    return CreateGLProgram(context, vertex, fragment);
+  }
+  auto binaryKey = MakeProgramBinaryKey(context, vertex, fragment);
+  auto programID = LoadProgramBinary(context, persistentCache, *binaryKey);
+  context->programCache()->notifyPersistentCacheLookup(programID != 0);
+  if (programID != 0) {
+    return programID;
+  }
+  programID = CreateGLProgram(context, vertex, fragment, true);
+  if (programID != 0) {
+    StoreProgramBinary(context, persistentCache, *binaryKey, programID);
+  }
+  return programID;
+}
+
+unsigned GLGpu::takePrecompiledProgram(const std::string& vertex, const std::string& fragment) {
+  if (precompiledPrograms.empty()) {
+    return 0;
+  }
+  auto result = precompiledPrograms.find(ProgramCache::SourceHash(vertex, fragment));
+  if (result == precompiledPrograms.end() || result->second.vertex != vertex ||
+      result->second.fragment != fragment) {
+    return 0;
+  }
+  auto programID = result->second.programID;
+  precompiledPrograms.erase(result);
+  return programID;
+}
+
+bool GLGpu::precompileProgram(const std::string& vertex, const std::string& fragment) {
+  auto hash = ProgramCache::SourceHash(vertex, fragment);
+  if (precompiledPrograms.count(hash) > 0) {
+    return true;
+  }
+  auto programID = createProgram(vertex, fragment);
+  if (programID == 0) {
+    return false;
+  }
+  precompiledPrograms[hash] = {vertex, fragment, programID};
+  return true;
+}
+
+void GLGpu::releaseAll(bool releaseGPU) {
+  if (releaseGPU) {
+    auto gl = GLFunctions::Get(context);
+    for (auto& item : precompiledPrograms) {
+      gl->deleteProgram(item.second.programID);
+    }
+  }
+  precompiledPrograms.clear();
+}
+
 bool GLGpu::insertSemaphore(Semaphore* semaphore) {
   if (semaphore == nullptr) {
     return false;
@@ -18,14 +18,23 @@
 
 #pragma once
 
+#include <unordered_map>
 #include "gpu/Gpu.h"
 #include "gpu/opengl/GLRenderPass.h"
+#include "gpu/opengl/GLState.h"
 
 namespace tgfx {
 class GLGpu : public Gpu {
  public:
   static std::unique_ptr<Gpu> Make(Context* context);
 
+  /**
+   * Returns the tracker of the GL state, which elides redundant state changes.
+   */
+  GLState* state() {
+    return &_state;
+  }
+
   std::unique_ptr<TextureSampler> createSampler(int width, int height, PixelFormat format,
                                                 int mipLevelCount) override;
 
@@ -43,6 +52,31 @@ class GLGpu : public Gpu {
 
   void regenerateMipmapLevels(const TextureSampler* sampler) override;
 
+  void writeBuffer(const GpuBuffer* buffer, size_t offset, const void* data, size_t size) override;
+
+  uint64_t insertFence() override;
+
+  bool checkFence(uint64_t fence) override;
+
+  void deleteFence(uint64_t fence) override;
+
+  /**
+   * Creates a linked program from the given shader sources. The program is restored from
+   * Context::persistentCache() if possible, otherwise it is compiled and then stored into the
+   * cache. Returns 0 if the program fails to compile.
+   */
+  unsigned createProgram(const std::string& vertex, const std::string& fragment);
+
+  /**
+   * Returns the program precompiled from the given shader sources and transfers its ownership to
+   * the caller. Returns 0 if there is no such program.
+   */
+  unsigned takePrecompiledProgram(const std::string& vertex, const std::string& fragment);
+
+  bool precompileProgram(const std::string& vertex, const std::string& fragment) override;
+
+  void releaseAll(bool releaseGPU) override;
+
   bool insertSemaphore(Semaphore* semaphore) override;
 
   bool waitSemaphore(const Semaphore* semaphore) override;
@@ -50,7 +84,16 @@ class GLGpu : public Gpu {
   bool submitToGpu(bool syncCpu) override;
 
  private:
-  explicit GLGpu(Context* context) : Gpu(context) {
+  struct PrecompiledProgram {
+    std::string vertex;
+    std::string fragment;
+    unsigned programID = 0;
+  };
+
+  GLState _state;
+  std::unordered_map<uint64_t, PrecompiledProgram> precompiledPrograms = {};
+
+  explicit GLGpu(Context* context) : Gpu(context), _state(context) {
   }
 };
 }  // namespace tgfx
@@ -115,6 +115,8 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
       reinterpret_cast<GLClearDepthf*>(getter->getProcAddress("glClearDepthf"));
   functions->clearStencil =
       reinterpret_cast<GLClearStencil*>(getter->getProcAddress("glClearStencil"));
+  functions->clientWaitSync =
+      reinterpret_cast<GLClientWaitSync*>(getter->getProcAddress("glClientWaitSync"));
   functions->colorMask = reinterpret_cast<GLColorMask*>(getter->getProcAddress("glColorMask"));
   functions->compileShader =
       reinterpret_cast<GLCompileShader*>(getter->getProcAddress("glCompileShader"));
@@ -23,14 +23,18 @@
 namespace tgfx {
 GLProgram::GLProgram(Context* context, unsigned programID,
                      std::unique_ptr<GLUniformBuffer> uniformBuffer,
-                     std::vector<Attribute> attributes, int vertexStride)
+                     std::vector<Attribute> attributes, int vertexStride,
+                     std::vector<Attribute> instanceAttributes, int instanceStride,
+                     size_t memoryUsage)
     : Program(context), programId(programID), uniformBuffer(std::move(uniformBuffer)),
-      attributes(std::move(attributes)), _vertexStride(vertexStride) {
+      attributes(std::move(attributes)), _vertexStride(vertexStride),
+      _instanceAttributes(std::move(instanceAttributes)), _instanceStride(instanceStride),
+      _memoryUsage(memoryUsage) {
 }
 
 void GLProgram::setupSamplerUniforms(const std::vector<GLUniform>& textureSamplers) const {
   auto gl = GLFunctions::Get(context);
-  gl->useProgram(programId);
+  GLState::Get(context)->useProgram(programId);
   // Assign texture units to sampler uniforms one time up front.
   for (size_t i = 0; i < textureSamplers.size(); ++i) {
     const auto& sampler = textureSamplers[i];
@@ -44,6 +48,7 @@ void GLProgram::onReleaseGPU() {
   if (programId) {
     auto gl = GLFunctions::Get(context);
     gl->deleteProgram(programId);
+    GLState::Get(context)->onDeleteProgram(programId);
   }
 }
 
@@ -85,6 +90,6 @@ void GLProgram::setRenderTargetState(const RenderTarget* renderTarget) {
   renderTargetState.height = height;
   renderTargetState.origin = origin;
   auto v = GetRTAdjustArray(width, height, origin == ImageOrigin::BottomLeft);
-  uniformBuffer->setData(RTAdjustName, v);
+  uniformBuffer->setData(RTAdjustHandle, v);
 }
 }  // namespace tgfx
@@ -36,7 +36,13 @@ class GLProgram : public Program {
   };
 
   GLProgram(Context* context, unsigned programID, std::unique_ptr<GLUniformBuffer> uniformBuffer,
-            std::vector<Attribute> attributes, int vertexStride);
+            std::vector<Attribute> attributes, int vertexStride,
+            std::vector<Attribute> instanceAttributes, int instanceStride,
+            size_t memoryUsage);
+
+  size_t memoryUsage() const override {
+    return _memoryUsage;
+  }
 
   void setupSamplerUniforms(const std::vector<GLUniform>& textureSamplers) const;
 
@@ -64,6 +70,14 @@ class GLProgram : public Program {
     return attributes;
   }
 
+  int instanceStride() const {
+    return _instanceStride;
+  }
+
+  const std::vector<Attribute>& instanceAttributes() const {
+    return _instanceAttributes;
+  }
+
  protected:
   void onReleaseGPU() override;
 
@@ -82,5 +96,8 @@ class GLProgram : public Program {
 
   std::vector<Attribute> attributes;
   int _vertexStride = 0;
+  std::vector<Attribute> _instanceAttributes;
+  int _instanceStride = 0;
+  size_t _memoryUsage = 0;
 };
 }  // namespace tgfx
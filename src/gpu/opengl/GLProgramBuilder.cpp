@@ -18,7 +18,9 @@
 
 #include "GLProgramBuilder.h"
 #include "GLContext.h"
+#include "GLGpu.h"
 #include "GLUtil.h"
+#include "gpu/ProgramCache.h"
 
 namespace tgfx {
 static std::string TypeModifierString(bool isDesktopGL, ShaderVar::TypeModifier t,
@@ -111,29 +113,60 @@ std::unique_ptr<GLProgram> GLProgramBuilder::finalize() {
 
   auto vertex = vertexShaderBuilder()->shaderString();
   auto fragment = fragmentShaderBuilder()->shaderString();
-  auto programID = CreateGLProgram(context, vertex, fragment);
+  auto gpu = static_cast<GLGpu*>(context->gpu());
+  auto programID = gpu->takePrecompiledProgram(vertex, fragment);
   if (programID == 0) {
-    return nullptr;
+    programID = gpu->createProgram(vertex, fragment);
+    if (programID == 0) {
+      return nullptr;
+    }
   }
+  context->programCache()->recordProgram(vertex, fragment);
+  computeMemoryUsage(programID, vertex.size() + fragment.size());
   computeCountsAndStrides(programID);
   resolveProgramResourceLocations(programID);
 
   return createProgram(programID);
 }
 
-void GLProgramBuilder::computeCountsAndStrides(unsigned int programID) {
-  auto gl = GLFunctions::Get(context);
-  vertexStride = 0;
-  for (const auto* attr : pipeline->getGeometryProcessor()->vertexAttributes()) {
+void GLProgramBuilder::computeMemoryUsage(unsigned programID, size_t sourceSize) {
+  // The driver keeps the linked binary around, which is the closest thing to the real footprint.
+  // Fall back to the source size where the binary length can't be queried.
+  memoryUsage = sourceSize;
+  if (GLCaps::Get(context)->programBinarySupport) {
+    auto gl = GLFunctions::Get(context);
+    int binaryLength = 0;
+    gl->getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength > 0) {
+      memoryUsage = static_cast<size_t>(binaryLength);
+    }
+  }
+}
+
+static size_t ComputeAttributes(const GLFunctions* gl, unsigned programID,
+                                const std::vector<const GeometryProcessor::Attribute*>& attrs,
+                                std::vector<GLProgram::Attribute>* attributes) {
+  size_t stride = 0;
+  for (const auto* attr : attrs) {
     GLProgram::Attribute attribute;
     attribute.gpuType = attr->gpuType();
-    attribute.offset = vertexStride;
-    vertexStride += attr->sizeAlign4();
+    attribute.offset = stride;
+    stride += attr->sizeAlign4();
     attribute.location = gl->getAttribLocation(programID, attr->name().c_str());
     if (attribute.location >= 0) {
-      attributes.push_back(attribute);
+      attributes->push_back(attribute);
     }
   }
+  return stride;
+}
+
+void GLProgramBuilder::computeCountsAndStrides(unsigned int programID) {
+  auto gl = GLFunctions::Get(context);
+  auto geometryProcessor = pipeline->getGeometryProcessor();
+  vertexStride =
+      ComputeAttributes(gl, programID, geometryProcessor->vertexAttributes(), &attributes);
+  instanceStride = ComputeAttributes(gl, programID, geometryProcessor->instanceAttributes(),
+                                     &instanceAttributes);
 }
 
 void GLProgramBuilder::resolveProgramResourceLocations(unsigned programID) {
@@ -152,7 +185,8 @@ bool GLProgramBuilder::checkSamplerCounts() {
 std::unique_ptr<GLProgram> GLProgramBuilder::createProgram(unsigned programID) {
   auto uniformBuffer = _uniformHandler.makeUniformBuffer();
   auto program = new GLProgram(context, programID, std::move(uniformBuffer), attributes,
-                               static_cast<int>(vertexStride));
+                               static_cast<int>(vertexStride), instanceAttributes,
+                               static_cast<int>(instanceStride), memoryUsage);
   program->setupSamplerUniforms(_uniformHandler.samplers);
   return std::unique_ptr<GLProgram>(program);
 }
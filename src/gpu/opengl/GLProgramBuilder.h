@@ -41,6 +41,8 @@ class GLProgramBuilder : public ProgramBuilder {
 
   void computeCountsAndStrides(unsigned programID);
 
+  void computeMemoryUsage(unsigned programID, size_t sourceSize);
+
   std::unique_ptr<GLProgram> finalize();
 
   void resolveProgramResourceLocations(unsigned programID);
@@ -75,6 +77,9 @@ class GLProgramBuilder : public ProgramBuilder {
   GLFragmentShaderBuilder _fragBuilder;
   std::vector<GLProgram::Attribute> attributes;
   size_t vertexStride = 0;
+  std::vector<GLProgram::Attribute> instanceAttributes;
+  size_t instanceStride = 0;
+  size_t memoryUsage = 0;
 
   friend class ProgramBuilder;
 };
@@ -21,6 +21,7 @@
 #include "gpu/DrawingManager.h"
 #include "gpu/ProgramCache.h"
 #include "gpu/opengl/GLProgram.h"
+#include "gpu/opengl/GLState.h"
 
 namespace tgfx {
 struct AttribLayout {
@@ -59,19 +60,17 @@ GLRenderPass::GLRenderPass(Context* context) : RenderPass(context) {
     vertexArray = GLVertexArray::Make(context);
     DEBUG_ASSERT(vertexArray != nullptr);
   }
-  sharedVertexBuffer =
-      std::static_pointer_cast<GLBuffer>(GpuBuffer::Make(context, BufferType::Vertex));
-  DEBUG_ASSERT(sharedVertexBuffer != nullptr);
 }
 
 static void UpdateScissor(Context* context, const Rect& scissorRect) {
-  auto gl = GLFunctions::Get(context);
+  auto state = GLState::Get(context);
   if (scissorRect.isEmpty()) {
-    gl->disable(GL_SCISSOR_TEST);
+    state->setEnabled(GL_SCISSOR_TEST, false);
   } else {
-    gl->enable(GL_SCISSOR_TEST);
-    gl->scissor(static_cast<int>(scissorRect.x()), static_cast<int>(scissorRect.y()),
-                static_cast<int>(scissorRect.width()), static_cast<int>(scissorRect.height()));
+    state->setEnabled(GL_SCISSOR_TEST, true);
+    state->setScissor(static_cast<int>(scissorRect.x()), static_cast<int>(scissorRect.y()),
+                      static_cast<int>(scissorRect.width()),
+                      static_cast<int>(scissorRect.height()));
   }
 }
 
@@ -84,41 +83,63 @@ static const unsigned gXfermodeCoeff2Blend[] = {
 };
 
 static void UpdateBlend(Context* context, const BlendInfo* blendFactors) {
-  auto gl = GLFunctions::Get(context);
+  auto state = GLState::Get(context);
   auto caps = GLCaps::Get(context);
   if (caps->frameBufferFetchSupport && caps->frameBufferFetchRequiresEnablePerSample) {
-    if (blendFactors == nullptr) {
-      gl->enable(GL_FETCH_PER_SAMPLE_ARM);
-    } else {
-      gl->disable(GL_FETCH_PER_SAMPLE_ARM);
-    }
+    state->setEnabled(GL_FETCH_PER_SAMPLE_ARM, blendFactors == nullptr);
   }
   if (blendFactors == nullptr || (blendFactors->srcBlend == BlendModeCoeff::One &&
                                   blendFactors->dstBlend == BlendModeCoeff::Zero)) {
     // There is no need to enable blending if the blend mode is src.
-    gl->disable(GL_BLEND);
+    state->setEnabled(GL_BLEND, false);
+  } else {
+    state->setEnabled(GL_BLEND, true);
+    state->setBlendFunc(gXfermodeCoeff2Blend[static_cast<int>(blendFactors->srcBlend)],
+                        gXfermodeCoeff2Blend[static_cast<int>(blendFactors->dstBlend)]);
+    state->setBlendEquation(GL_FUNC_ADD);
+  }
+}
+
+static void UpdateStencil(Context* context, StencilMode mode) {
+  auto state = GLState::Get(context);
+  if (mode == StencilMode::Disabled) {
+    state->setEnabled(GL_STENCIL_TEST, false);
+    state->setColorMask(true);
+    return;
+  }
+  state->setEnabled(GL_STENCIL_TEST, true);
+  if (mode == StencilMode::WriteClip) {
+    state->setColorMask(false);
+    state->setStencilFunc(GL_ALWAYS, 1, 0xFF);
+    state->setStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
   } else {
-    gl->enable(GL_BLEND);
-    gl->blendFunc(gXfermodeCoeff2Blend[static_cast<int>(blendFactors->srcBlend)],
-                  gXfermodeCoeff2Blend[static_cast<int>(blendFactors->dstBlend)]);
-    gl->blendEquation(GL_FUNC_ADD);
+    state->setColorMask(true);
+    state->setStencilFunc(GL_EQUAL, 1, 0xFF);
+    state->setStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
   }
 }
 
 void GLRenderPass::onBindRenderTarget() {
   auto gl = GLFunctions::Get(context);
+  auto state = GLState::Get(context);
+  // Objects may have been created or bound outside the tracker since the last render pass, so the
+  // shadow state is only trusted within a single pass.
+  state->reset();
   auto glRT = static_cast<GLRenderTarget*>(_renderTarget.get());
   gl->bindFramebuffer(GL_FRAMEBUFFER, glRT->getFrameBufferID());
   gl->viewport(0, 0, glRT->width(), glRT->height());
   if (vertexArray) {
-    gl->bindVertexArray(vertexArray->id());
+    state->bindVertexArray(vertexArray->id());
   }
 }
 
 void GLRenderPass::onUnbindRenderTarget() {
   auto gl = GLFunctions::Get(context);
+  // Leave the stencil test and the color writes in their default state for the next user of the
+  // context. Both are usually known to be so already, which makes this free.
+  UpdateStencil(context, StencilMode::Disabled);
   if (vertexArray) {
-    gl->bindVertexArray(0);
+    GLState::Get(context)->bindVertexArray(0);
   }
   gl->bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -130,42 +151,62 @@ bool GLRenderPass::onBindProgramAndScissorClip(const ProgramInfo* programInfo,
     return false;
   }
   ClearGLError(context);
-  auto gl = GLFunctions::Get(context);
   auto* program = static_cast<GLProgram*>(_program);
-  gl->useProgram(program->programID());
+  GLState::Get(context)->useProgram(program->programID());
   UpdateScissor(context, scissorRect);
   UpdateBlend(context, programInfo->blendInfo());
+  UpdateStencil(context, programInfo->stencilMode());
   if (programInfo->requiresBarrier()) {
-    gl->textureBarrier();
+    GLFunctions::Get(context)->textureBarrier();
   }
   program->updateUniformsAndTextureBindings(_renderTarget.get(), programInfo);
   return true;
 }
 
 bool GLRenderPass::onBindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
-                                 std::shared_ptr<GpuBuffer> vertexBuffer,
-                                 std::shared_ptr<Data> vertexData) {
-  auto gl = GLFunctions::Get(context);
-  if (vertexBuffer) {
-    gl->bindBuffer(GL_ARRAY_BUFFER, std::static_pointer_cast<GLBuffer>(vertexBuffer)->bufferID());
-  } else if (vertexData) {
-    gl->bindBuffer(GL_ARRAY_BUFFER, sharedVertexBuffer->bufferID());
-    gl->bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexData->size()), vertexData->data(),
-                   GL_STATIC_DRAW);
-  } else {
+                                 std::shared_ptr<GpuBuffer> vertexBuffer, size_t vertexOffset,
+                                 std::shared_ptr<GpuBuffer> instanceBuffer,
+                                 size_t instanceOffset) {
+  if (vertexBuffer == nullptr) {
     return false;
   }
+  auto gl = GLFunctions::Get(context);
+  auto state = GLState::Get(context);
+  state->bindBuffer(GL_ARRAY_BUFFER, std::static_pointer_cast<GLBuffer>(vertexBuffer)->bufferID());
   auto* program = static_cast<GLProgram*>(_program);
   for (const auto& attribute : program->vertexAttributes()) {
     const AttribLayout& layout = GetAttribLayout(attribute.gpuType);
-    gl->vertexAttribPointer(static_cast<unsigned>(attribute.location), layout.count, layout.type,
-                            layout.normalized, program->vertexStride(),
-                            reinterpret_cast<void*>(attribute.offset));
-    gl->enableVertexAttribArray(static_cast<unsigned>(attribute.location));
+    state->setVertexAttribute(static_cast<unsigned>(attribute.location), layout.count, layout.type,
+                              layout.normalized, program->vertexStride(),
+                              vertexOffset + attribute.offset);
+  }
+  uint32_t newInstancedLocations = 0;
+  if (instanceBuffer) {
+    if (gl->vertexAttribDivisor == nullptr) {
+      return false;
+    }
+    state->bindBuffer(GL_ARRAY_BUFFER,
+                      std::static_pointer_cast<GLBuffer>(instanceBuffer)->bufferID());
+    for (const auto& attribute : program->instanceAttributes()) {
+      const AttribLayout& layout = GetAttribLayout(attribute.gpuType);
+      state->setVertexAttribute(static_cast<unsigned>(attribute.location), layout.count,
+                                layout.type, layout.normalized, program->instanceStride(),
+                                instanceOffset + attribute.offset);
+      newInstancedLocations |= 1u << attribute.location;
+    }
   }
+  // Divisors are stored in the vertex array owned by this render pass, so only the locations that
+  // switch between per-vertex and per-instance need to be updated.
+  auto changedLocations = instancedLocations ^ newInstancedLocations;
+  for (unsigned location = 0; changedLocations != 0; location++, changedLocations >>= 1) {
+    if (changedLocations & 1u) {
+      gl->vertexAttribDivisor(location, (newInstancedLocations >> location) & 1u);
+    }
+  }
+  instancedLocations = newInstancedLocations;
   if (indexBuffer) {
-    gl->bindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-                   std::static_pointer_cast<GLBuffer>(indexBuffer)->bufferID());
+    state->bindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                      std::static_pointer_cast<GLBuffer>(indexBuffer)->bufferID());
   }
   return true;
 }
@@ -184,13 +225,43 @@ void GLRenderPass::onDraw(PrimitiveType primitiveType, size_t offset, size_t cou
   }
 }
 
+void GLRenderPass::onDrawInstanced(PrimitiveType primitiveType, size_t offset, size_t count,
+                                   size_t instanceCount, bool drawIndexed) {
+  auto gl = GLFunctions::Get(context);
+  if (drawIndexed) {
+    gl->drawElementsInstanced(gPrimitiveType[static_cast<int>(primitiveType)],
+                              static_cast<int>(count), GL_UNSIGNED_SHORT,
+                              reinterpret_cast<void*>(offset * sizeof(uint16_t)),
+                              static_cast<int>(instanceCount));
+  } else {
+    gl->drawArraysInstanced(gPrimitiveType[static_cast<int>(primitiveType)],
+                            static_cast<int>(offset), static_cast<int>(count),
+                            static_cast<int>(instanceCount));
+  }
+}
+
 void GLRenderPass::onClear(const Rect& scissor, Color color) {
   auto gl = GLFunctions::Get(context);
   UpdateScissor(context, scissor);
+  GLState::Get(context)->setColorMask(true);
   gl->clearColor(color.red, color.green, color.blue, color.alpha);
   gl->clear(GL_COLOR_BUFFER_BIT);
 }
 
+bool GLRenderPass::onClearStencil(const Rect& scissor) {
+  auto glRT = static_cast<GLRenderTarget*>(_renderTarget.get());
+  if (!glRT->attachStencilBuffer()) {
+    return false;
+  }
+  auto gl = GLFunctions::Get(context);
+  UpdateScissor(context, scissor);
+  // The write mask isn't tracked, and clears only touch the stencil bits it allows.
+  gl->stencilMask(0xFF);
+  gl->clearStencil(0);
+  gl->clear(GL_STENCIL_BUFFER_BIT);
+  return true;
+}
+
 void GLRenderPass::onCopyToTexture(Texture* texture, int srcX, int srcY) {
   auto gpu = context->gpu();
   if (_renderTarget->sampleCount() > 1) {
@@ -239,7 +310,7 @@ bool GLRenderPass::copyAsBlit(Texture* texture, int srcX, int srcY) {
 #endif
   gl->bindFramebuffer(GL_READ_FRAMEBUFFER, sourceFrameBufferID);
   gl->bindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer->id());
-  gl->disable(GL_SCISSOR_TEST);
+  GLState::Get(context)->setEnabled(GL_SCISSOR_TEST, false);
   auto right = srcX + texture->width();
   auto bottom = srcY + texture->height();
   gl->blitFramebuffer(srcX, srcY, right, bottom, 0, 0, texture->width(), texture->height(),
@@ -251,7 +322,7 @@ bool GLRenderPass::copyAsBlit(Texture* texture, int srcX, int srcY) {
   gl->bindFramebuffer(GL_FRAMEBUFFER, frameBuffer->id());
   gl->framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, glSampler->target, 0, 0);
   if (glSampler->hasMipmaps() && glSampler->target == GL_TEXTURE_2D) {
-    gl->bindTexture(glSampler->target, glSampler->id);
+    GLState::Get(context)->bindTexture(glSampler->target, glSampler->id);
     gl->generateMipmap(glSampler->target);
   }
   gl->bindFramebuffer(GL_FRAMEBUFFER, sourceFrameBufferID);
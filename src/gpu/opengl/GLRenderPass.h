@@ -36,17 +36,21 @@ class GLRenderPass : public RenderPass {
   bool onBindProgramAndScissorClip(const ProgramInfo* programInfo,
                                    const Rect& scissorRect) override;
   bool onBindBuffers(std::shared_ptr<GpuBuffer> indexBuffer,
-                     std::shared_ptr<GpuBuffer> vertexBuffer,
-                     std::shared_ptr<Data> vertexData) override;
+                     std::shared_ptr<GpuBuffer> vertexBuffer, size_t vertexOffset,
+                     std::shared_ptr<GpuBuffer> instanceBuffer, size_t instanceOffset) override;
   void onDraw(PrimitiveType primitiveType, size_t baseVertex, size_t count,
               bool drawIndexed) override;
+  void onDrawInstanced(PrimitiveType primitiveType, size_t offset, size_t count,
+                       size_t instanceCount, bool drawIndexed) override;
   void onClear(const Rect& scissor, Color color) override;
+  bool onClearStencil(const Rect& scissor) override;
   void onCopyToTexture(Texture* texture, int srcX, int srcY) override;
 
  private:
   std::shared_ptr<GLVertexArray> vertexArray = nullptr;
   std::shared_ptr<GLFrameBuffer> frameBuffer = nullptr;
-  std::shared_ptr<GLBuffer> sharedVertexBuffer = nullptr;
+  // The attribute locations that currently have a divisor of 1 in the vertex array.
+  uint32_t instancedLocations = 0;
 
   bool copyAsBlit(Texture* texture, int srcX, int srcY);
 };
@@ -47,12 +47,11 @@ std::shared_ptr<RenderTarget> RenderTarget::MakeFrom(Context* context,
   return Resource::AddToCache(context, target);
 }
 
-static bool RenderbufferStorageMSAA(Context* context, int sampleCount, PixelFormat pixelFormat,
-                                    int width, int height) {
+static bool RenderbufferStorageMSAA(Context* context, int sampleCount, unsigned format, int width,
+                                    int height) {
   ClearGLError(context);
   auto gl = GLFunctions::Get(context);
   auto caps = GLCaps::Get(context);
-  auto format = caps->getTextureFormat(pixelFormat).sizedFormat;
   switch (caps->msFBOType) {
     case MSFBOType::Standard:
       gl->renderbufferStorageMultisample(GL_RENDERBUFFER, sampleCount, format, width, height);
@@ -120,8 +119,10 @@ static bool CreateRenderBuffer(const Texture* texture, unsigned& frameBufferID,
     return false;
   }
   gl->bindRenderbuffer(GL_RENDERBUFFER, renderBufferID);
-  if (!RenderbufferStorageMSAA(texture->getContext(), sampleCount, texture->getSampler()->format,
-                               texture->width(), texture->height())) {
+  auto caps = GLCaps::Get(texture->getContext());
+  auto format = caps->getTextureFormat(texture->getSampler()->format).sizedFormat;
+  if (!RenderbufferStorageMSAA(texture->getContext(), sampleCount, format, texture->width(),
+                               texture->height())) {
     return false;
   }
   gl->bindFramebuffer(GL_FRAMEBUFFER, frameBufferID);
@@ -215,6 +216,46 @@ static void CopyPixels(const ImageInfo& srcInfo, const void* srcPixels, const Im
   pixmap.readPixels(dstInfo, dstPixels);
 }
 
+bool GLRenderTarget::attachStencilBuffer() {
+  if (stencilBufferID > 0) {
+    return true;
+  }
+  if (externalResource) {
+    return false;
+  }
+  auto gl = GLFunctions::Get(context);
+  gl->genRenderbuffers(1, &stencilBufferID);
+  if (stencilBufferID == 0) {
+    return false;
+  }
+  gl->bindRenderbuffer(GL_RENDERBUFFER, stencilBufferID);
+  auto success = false;
+  if (sampleCount() > 1) {
+    // The stencil buffer must have the same sample count as the color attachment it belongs to.
+    success = RenderbufferStorageMSAA(context, sampleCount(), GL_STENCIL_INDEX8, width(), height());
+  } else {
+    ClearGLError(context);
+    gl->renderbufferStorage(GL_RENDERBUFFER, GL_STENCIL_INDEX8, width(), height());
+    success = CheckGLError(context);
+  }
+  if (success) {
+    gl->bindFramebuffer(GL_FRAMEBUFFER, frameBufferDraw);
+    gl->framebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                stencilBufferID);
+#ifndef TGFX_BUILD_FOR_WEB
+    if (gl->checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+      gl->framebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+      success = false;
+    }
+#endif
+  }
+  if (!success) {
+    gl->deleteRenderbuffers(1, &stencilBufferID);
+    stencilBufferID = 0;
+  }
+  return success;
+}
+
 BackendRenderTarget GLRenderTarget::getBackendRenderTarget() const {
   GLFrameBufferInfo glInfo = {};
   glInfo.id = frameBufferDraw;
@@ -285,5 +326,9 @@ void GLRenderTarget::onReleaseGPU() {
     gl->bindFramebuffer(GL_FRAMEBUFFER, 0);
   }
   ReleaseResource(context, frameBufferRead, frameBufferDraw, renderBufferID);
+  if (stencilBufferID > 0) {
+    GLFunctions::Get(context)->deleteRenderbuffers(1, &stencilBufferID);
+    stencilBufferID = 0;
+  }
 }
 }  // namespace tgfx
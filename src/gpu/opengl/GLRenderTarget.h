@@ -37,6 +37,12 @@ class GLRenderTarget : public RenderTarget {
    */
   unsigned getFrameBufferID(bool forDraw = true) const;
 
+  /**
+   * Attaches a stencil buffer to the frame buffer for drawing if it doesn't have one yet. Returns
+   * false if the render target wraps an external frame buffer or the attachment fails.
+   */
+  bool attachStencilBuffer();
+
   BackendRenderTarget getBackendRenderTarget() const override;
 
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0,
@@ -50,6 +56,7 @@ class GLRenderTarget : public RenderTarget {
   unsigned frameBufferRead = 0;
   unsigned frameBufferDraw = 0;
   unsigned renderBufferID = 0;
+  unsigned stencilBufferID = 0;
   unsigned textureTarget = 0;
   bool externalResource = false;
 
@@ -0,0 +1,317 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLState.h"
+#include "gpu/opengl/GLGpu.h"
+#include "tgfx/gpu/opengl/GLFunctions.h"
+
+namespace tgfx {
+GLState* GLState::Get(Context* context) {
+  return context ? static_cast<GLGpu*>(context->gpu())->state() : nullptr;
+}
+
+static int TextureTargetIndex(unsigned target) {
+  switch (target) {
+    case GL_TEXTURE_2D:
+      return 0;
+    case GL_TEXTURE_RECTANGLE:
+      return 1;
+    case GL_TEXTURE_EXTERNAL_OES:
+      return 2;
+    default:
+      return -1;
+  }
+}
+
+static int TextureParameterIndex(unsigned name) {
+  switch (name) {
+    case GL_TEXTURE_WRAP_S:
+      return 0;
+    case GL_TEXTURE_WRAP_T:
+      return 1;
+    case GL_TEXTURE_MIN_FILTER:
+      return 2;
+    case GL_TEXTURE_MAG_FILTER:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+void GLState::reset() {
+  programID = UnknownID;
+  blendEnabled = UnknownValue;
+  scissorEnabled = UnknownValue;
+  stencilEnabled = UnknownValue;
+  colorMaskEnabled = UnknownValue;
+  fetchPerSampleEnabled = UnknownValue;
+  scissorRect = {UnknownValue, UnknownValue, UnknownValue, UnknownValue};
+  blendSrcFactor = UnknownID;
+  blendDstFactor = UnknownID;
+  blendEquation = UnknownID;
+  stencilFunc = {UnknownID, UnknownID, UnknownID};
+  stencilOp = {UnknownID, UnknownID, UnknownID};
+  arrayBufferID = UnknownID;
+  vertexArrayID = UnknownID;
+  resetVertexArrayState();
+  activeUnit = UnknownID;
+  textureUnits.clear();
+}
+
+void GLState::resetVertexArrayState() {
+  // The element buffer binding and the attributes are part of the vertex array object.
+  elementBufferID = UnknownID;
+  vertexAttributes.clear();
+}
+
+bool GLState::shouldIssue(bool changed) {
+  if (changed) {
+    _issuedCalls++;
+  } else {
+    _skippedCalls++;
+  }
+  return changed;
+}
+
+void GLState::useProgram(unsigned id) {
+  if (shouldIssue(programID != id)) {
+    GLFunctions::Get(context)->useProgram(id);
+    programID = id;
+  }
+}
+
+int* GLState::capabilityState(unsigned capability) {
+  switch (capability) {
+    case GL_BLEND:
+      return &blendEnabled;
+    case GL_SCISSOR_TEST:
+      return &scissorEnabled;
+    case GL_STENCIL_TEST:
+      return &stencilEnabled;
+    case GL_FETCH_PER_SAMPLE_ARM:
+      return &fetchPerSampleEnabled;
+    default:
+      return nullptr;
+  }
+}
+
+void GLState::setEnabled(unsigned capability, bool enabled) {
+  auto state = capabilityState(capability);
+  auto value = enabled ? 1 : 0;
+  if (!shouldIssue(state == nullptr || *state != value)) {
+    return;
+  }
+  auto gl = GLFunctions::Get(context);
+  if (enabled) {
+    gl->enable(capability);
+  } else {
+    gl->disable(capability);
+  }
+  if (state != nullptr) {
+    *state = value;
+  }
+}
+
+void GLState::setScissor(int x, int y, int width, int height) {
+  std::array<int, 4> rect = {x, y, width, height};
+  if (shouldIssue(scissorRect != rect)) {
+    GLFunctions::Get(context)->scissor(x, y, width, height);
+    scissorRect = rect;
+  }
+}
+
+void GLState::setBlendFunc(unsigned srcFactor, unsigned dstFactor) {
+  if (shouldIssue(blendSrcFactor != srcFactor || blendDstFactor != dstFactor)) {
+    GLFunctions::Get(context)->blendFunc(srcFactor, dstFactor);
+    blendSrcFactor = srcFactor;
+    blendDstFactor = dstFactor;
+  }
+}
+
+void GLState::setBlendEquation(unsigned mode) {
+  if (shouldIssue(blendEquation != mode)) {
+    GLFunctions::Get(context)->blendEquation(mode);
+    blendEquation = mode;
+  }
+}
+
+void GLState::setColorMask(bool enabled) {
+  auto value = enabled ? 1 : 0;
+  if (shouldIssue(colorMaskEnabled != value)) {
+    GLFunctions::Get(context)->colorMask(enabled, enabled, enabled, enabled);
+    colorMaskEnabled = value;
+  }
+}
+
+void GLState::setStencilFunc(unsigned func, int ref, unsigned mask) {
+  std::array<unsigned, 3> value = {func, static_cast<unsigned>(ref), mask};
+  if (shouldIssue(stencilFunc != value)) {
+    GLFunctions::Get(context)->stencilFunc(func, ref, mask);
+    stencilFunc = value;
+  }
+}
+
+void GLState::setStencilOp(unsigned stencilFail, unsigned depthFail, unsigned depthPass) {
+  std::array<unsigned, 3> value = {stencilFail, depthFail, depthPass};
+  if (shouldIssue(stencilOp != value)) {
+    GLFunctions::Get(context)->stencilOp(stencilFail, depthFail, depthPass);
+    stencilOp = value;
+  }
+}
+
+void GLState::bindBuffer(unsigned target, unsigned bufferID) {
+  unsigned* state = nullptr;
+  if (target == GL_ARRAY_BUFFER) {
+    state = &arrayBufferID;
+  } else if (target == GL_ELEMENT_ARRAY_BUFFER) {
+    state = &elementBufferID;
+  }
+  if (!shouldIssue(state == nullptr || *state != bufferID)) {
+    return;
+  }
+  GLFunctions::Get(context)->bindBuffer(target, bufferID);
+  if (state != nullptr) {
+    *state = bufferID;
+  }
+}
+
+void GLState::bindVertexArray(unsigned id) {
+  if (shouldIssue(vertexArrayID != id)) {
+    GLFunctions::Get(context)->bindVertexArray(id);
+    vertexArrayID = id;
+    resetVertexArrayState();
+  }
+}
+
+void GLState::setVertexAttribute(unsigned location, int count, unsigned type, bool normalized,
+                                 int stride, size_t offset) {
+  if (location >= vertexAttributes.size()) {
+    vertexAttributes.resize(location + 1);
+  }
+  auto& attribute = vertexAttributes[location];
+  auto gl = GLFunctions::Get(context);
+  // The pointer can't be compared if the bound array buffer is unknown.
+  auto changed = arrayBufferID == UnknownID || attribute.bufferID != arrayBufferID ||
+                 attribute.count != count || attribute.type != type ||
+                 attribute.normalized != normalized || attribute.stride != stride ||
+                 attribute.offset != offset;
+  if (shouldIssue(changed)) {
+    gl->vertexAttribPointer(location, count, type, normalized, stride,
+                            reinterpret_cast<void*>(offset));
+    attribute = {arrayBufferID, count, type, normalized, stride, offset, attribute.enabled};
+  }
+  if (shouldIssue(!attribute.enabled)) {
+    gl->enableVertexAttribArray(location);
+    attribute.enabled = true;
+  }
+}
+
+void GLState::activeTexture(unsigned unit) {
+  if (unit >= textureUnits.size()) {
+    textureUnits.resize(unit + 1);
+  }
+  if (shouldIssue(activeUnit != unit)) {
+    GLFunctions::Get(context)->activeTexture(GL_TEXTURE0 + unit);
+    activeUnit = unit;
+  }
+}
+
+GLState::TextureBinding* GLState::activeTextureBinding(unsigned target) {
+  auto targetIndex = TextureTargetIndex(target);
+  if (activeUnit == UnknownID || targetIndex < 0) {
+    return nullptr;
+  }
+  return &textureUnits[activeUnit][static_cast<size_t>(targetIndex)];
+}
+
+void GLState::bindTexture(unsigned target, unsigned textureID) {
+  auto binding = activeTextureBinding(target);
+  if (!shouldIssue(binding == nullptr || binding->textureID != textureID)) {
+    return;
+  }
+  GLFunctions::Get(context)->bindTexture(target, textureID);
+  if (binding != nullptr) {
+    *binding = {};
+    binding->textureID = textureID;
+  }
+}
+
+void GLState::setTextureParameter(unsigned target, unsigned name, int value) {
+  auto binding = activeTextureBinding(target);
+  auto parameterIndex = TextureParameterIndex(name);
+  if (binding == nullptr || binding->textureID == UnknownID || parameterIndex < 0) {
+    shouldIssue(true);
+    GLFunctions::Get(context)->texParameteri(target, name, value);
+    return;
+  }
+  auto& parameter = binding->parameters[static_cast<size_t>(parameterIndex)];
+  if (!shouldIssue(parameter != value)) {
+    return;
+  }
+  GLFunctions::Get(context)->texParameteri(target, name, value);
+  // The parameters belong to the texture object, so forget them on every other unit that has the
+  // same texture bound.
+  auto textureID = binding->textureID;
+  for (auto& unit : textureUnits) {
+    for (auto& other : unit) {
+      if (other.textureID == textureID && &other != binding) {
+        other.parameters = {UnknownValue, UnknownValue, UnknownValue, UnknownValue};
+      }
+    }
+  }
+  parameter = value;
+}
+
+void GLState::onDeleteProgram(unsigned id) {
+  if (programID == id) {
+    programID = UnknownID;
+  }
+}
+
+void GLState::onDeleteBuffer(unsigned bufferID) {
+  if (arrayBufferID == bufferID) {
+    arrayBufferID = 0;
+  }
+  if (elementBufferID == bufferID) {
+    elementBufferID = 0;
+  }
+  for (auto& attribute : vertexAttributes) {
+    if (attribute.bufferID == bufferID) {
+      attribute.bufferID = UnknownID;
+    }
+  }
+}
+
+void GLState::onDeleteTexture(unsigned textureID) {
+  for (auto& unit : textureUnits) {
+    for (auto& binding : unit) {
+      if (binding.textureID == textureID) {
+        binding = {};
+        binding.textureID = 0;
+      }
+    }
+  }
+}
+
+void GLState::onDeleteVertexArray(unsigned id) {
+  if (vertexArrayID == id) {
+    vertexArrayID = 0;
+    resetVertexArrayState();
+  }
+}
+}  // namespace tgfx
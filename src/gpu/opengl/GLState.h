@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include "tgfx/gpu/Context.h"
+
+namespace tgfx {
+/**
+ * GLState shadows the parts of the GL context state that change on every draw, and only forwards
+ * a call to the driver if it actually changes the state. Anything that is unknown, e.g. after
+ * reset(), is always forwarded. All state changes of the tracked kinds inside tgfx must go through
+ * GLState, or the shadow copy goes stale.
+ */
+class GLState {
+ public:
+  static GLState* Get(Context* context);
+
+  explicit GLState(Context* context) : context(context) {
+  }
+
+  /**
+   * Marks all state as unknown. Called at the start of each render pass and whenever the context
+   * state may have been modified outside tgfx.
+   */
+  void reset();
+
+  void useProgram(unsigned programID);
+
+  /**
+   * Enables or disables a capability. GL_BLEND, GL_SCISSOR_TEST, GL_STENCIL_TEST and
+   * GL_FETCH_PER_SAMPLE_ARM are tracked, other capabilities are always forwarded.
+   */
+  void setEnabled(unsigned capability, bool enabled);
+
+  void setScissor(int x, int y, int width, int height);
+
+  void setBlendFunc(unsigned srcFactor, unsigned dstFactor);
+
+  void setBlendEquation(unsigned mode);
+
+  /**
+   * Enables or disables writing to all color channels at once.
+   */
+  void setColorMask(bool enabled);
+
+  void setStencilFunc(unsigned func, int ref, unsigned mask);
+
+  void setStencilOp(unsigned stencilFail, unsigned depthFail, unsigned depthPass);
+
+  /**
+   * Binds a buffer. GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are tracked, other targets are
+   * always forwarded.
+   */
+  void bindBuffer(unsigned target, unsigned bufferID);
+
+  void bindVertexArray(unsigned vertexArrayID);
+
+  /**
+   * Points the attribute at the given location to the buffer currently bound to GL_ARRAY_BUFFER
+   * and enables it.
+   */
+  void setVertexAttribute(unsigned location, int count, unsigned type, bool normalized, int stride,
+                          size_t offset);
+
+  /**
+   * Selects the texture unit used by bindTexture() and setTextureParameter(). The unit is an
+   * index starting from 0, not a GL_TEXTUREi enum.
+   */
+  void activeTexture(unsigned unit);
+
+  void bindTexture(unsigned target, unsigned textureID);
+
+  /**
+   * Sets a parameter of the texture bound to the target of the active unit. The wrap and filter
+   * parameters are tracked, other parameters are always forwarded.
+   */
+  void setTextureParameter(unsigned target, unsigned name, int value);
+
+  /**
+   * Notifies the tracker that a program, buffer or texture was deleted, since the driver unbinds
+   * deleted objects and may reuse their names.
+   */
+  void onDeleteProgram(unsigned programID);
+
+  void onDeleteBuffer(unsigned bufferID);
+
+  void onDeleteTexture(unsigned textureID);
+
+  void onDeleteVertexArray(unsigned vertexArrayID);
+
+  /**
+   * Returns the number of state calls forwarded to the driver.
+   */
+  size_t issuedCalls() const {
+    return _issuedCalls;
+  }
+
+  /**
+   * Returns the number of state calls skipped because they wouldn't change anything.
+   */
+  size_t skippedCalls() const {
+    return _skippedCalls;
+  }
+
+ private:
+  static constexpr unsigned UnknownID = ~0u;
+  static constexpr int UnknownValue = -1;
+  static constexpr size_t TextureTargetCount = 3;
+  static constexpr size_t TextureParameterCount = 4;
+
+  struct VertexAttribute {
+    unsigned bufferID = UnknownID;
+    int count = 0;
+    unsigned type = 0;
+    bool normalized = false;
+    int stride = 0;
+    size_t offset = 0;
+    bool enabled = false;
+  };
+
+  struct TextureBinding {
+    unsigned textureID = UnknownID;
+    std::array<int, TextureParameterCount> parameters = {UnknownValue, UnknownValue, UnknownValue,
+                                                         UnknownValue};
+  };
+
+  Context* context = nullptr;
+  size_t _issuedCalls = 0;
+  size_t _skippedCalls = 0;
+  unsigned programID = UnknownID;
+  int blendEnabled = UnknownValue;
+  int scissorEnabled = UnknownValue;
+  int stencilEnabled = UnknownValue;
+  int colorMaskEnabled = UnknownValue;
+  int fetchPerSampleEnabled = UnknownValue;
+  std::array<int, 4> scissorRect = {UnknownValue, UnknownValue, UnknownValue, UnknownValue};
+  unsigned blendSrcFactor = UnknownID;
+  unsigned blendDstFactor = UnknownID;
+  unsigned blendEquation = UnknownID;
+  std::array<unsigned, 3> stencilFunc = {UnknownID, UnknownID, UnknownID};
+  std::array<unsigned, 3> stencilOp = {UnknownID, UnknownID, UnknownID};
+  unsigned arrayBufferID = UnknownID;
+  unsigned elementBufferID = UnknownID;
+  unsigned vertexArrayID = UnknownID;
+  std::vector<VertexAttribute> vertexAttributes = {};
+  unsigned activeUnit = UnknownID;
+  std::vector<std::array<TextureBinding, TextureTargetCount>> textureUnits = {};
+
+  bool shouldIssue(bool changed);
+  int* capabilityState(unsigned capability);
+  TextureBinding* activeTextureBinding(unsigned target);
+  void resetVertexArrayState();
+};
+}  // namespace tgfx
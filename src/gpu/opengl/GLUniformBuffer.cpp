@@ -18,9 +18,59 @@
 
 #include "GLUniformBuffer.h"
 #include "core/utils/Log.h"
+#include "gpu/ResourceProvider.h"
+#include "gpu/opengl/GLBuffer.h"
 #include "tgfx/gpu/opengl/GLFunctions.h"
 
 namespace tgfx {
+/**
+ * Returns the base alignment of the uniform type in the std140 layout. Vectors of three and four
+ * components, and the columns of matrices, are aligned to 16 bytes.
+ */
+static size_t Std140Alignment(Uniform::Type type) {
+  switch (type) {
+    case Uniform::Type::Float:
+    case Uniform::Type::Int:
+      return 4;
+    case Uniform::Type::Float2:
+    case Uniform::Type::Int2:
+      return 8;
+    default:
+      return 16;
+  }
+}
+
+/**
+ * Returns the size of the uniform type in the std140 layout, where each matrix column is padded
+ * to a vec4.
+ */
+static size_t Std140Size(const Uniform& uniform) {
+  switch (uniform.type) {
+    case Uniform::Type::Float2x2:
+      return 32;
+    case Uniform::Type::Float3x3:
+      return 48;
+    default:
+      return uniform.size();
+  }
+}
+
+GLUniformBuffer::GLUniformBuffer(std::vector<Uniform> uniformList)
+    : UniformBuffer(std::move(uniformList)) {
+  size_t offset = 0;
+  for (auto& uniform : uniforms) {
+    auto alignment = Std140Alignment(uniform.type);
+    offset = (offset + alignment - 1) / alignment * alignment;
+    blockOffsets.push_back(offset);
+    offset += Std140Size(uniform);
+  }
+  blockSize = (offset + 15) / 16 * 16;
+  if (blockSize > 0) {
+    // Zero the padding between the members, it is uploaded along with them.
+    buffer = new (std::nothrow) uint8_t[blockSize]();
+  }
+}
+
 GLUniformBuffer::GLUniformBuffer(std::vector<Uniform> uniformList, std::vector<int> locationList)
     : UniformBuffer(std::move(uniformList)), locations(std::move(locationList)) {
   DEBUG_ASSERT(uniforms.size() == locations.size());
@@ -36,6 +86,28 @@ GLUniformBuffer::~GLUniformBuffer() {
 }
 
 void GLUniformBuffer::onCopyData(size_t index, size_t offset, size_t size, const void* data) {
+  if (!blockOffsets.empty()) {
+    // Matrices are stored column by column with each column padded to 16 bytes.
+    auto type = uniforms[index].type;
+    size_t columns = 1;
+    if (type == Uniform::Type::Float2x2) {
+      columns = 2;
+    } else if (type == Uniform::Type::Float3x3) {
+      columns = 3;
+    }
+    auto columnSize = size / columns;
+    auto columnStride = columns > 1 ? 16 : columnSize;
+    auto target = buffer + blockOffsets[index];
+    auto source = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < columns; i++) {
+      auto column = target + i * columnStride;
+      if (memcmp(column, source + i * columnSize, columnSize) != 0) {
+        memcpy(column, source + i * columnSize, columnSize);
+        bufferChanged = true;
+      }
+    }
+    return;
+  }
   if (!dirtyFlags[index] && memcmp(buffer + offset, data, size) == 0) {
     return;
   }
@@ -45,6 +117,10 @@ void GLUniformBuffer::onCopyData(size_t index, size_t offset, size_t size, const
 }
 
 void GLUniformBuffer::uploadToGPU(Context* context) {
+  if (!blockOffsets.empty()) {
+    uploadUniformBlock(context);
+    return;
+  }
   if (!bufferChanged) {
     return;
   }
@@ -97,4 +173,25 @@ void GLUniformBuffer::uploadToGPU(Context* context) {
     index++;
   }
 }
+
+void GLUniformBuffer::uploadUniformBlock(Context* context) {
+  auto allocator = context->resourceProvider()->uniformAllocator();
+  // The slice written by a previous flush may have been reused since, so the block is written
+  // again after the allocator recycles its buffers, even if no uniform changed.
+  if (bufferChanged || blockBufferID == 0 || blockGeneration != allocator->generation()) {
+    auto slice = allocator->write(buffer, blockSize);
+    if (slice.buffer == nullptr) {
+      blockBufferID = 0;
+      return;
+    }
+    blockBufferID = std::static_pointer_cast<GLBuffer>(slice.buffer)->bufferID();
+    blockBufferOffset = slice.offset;
+    blockGeneration = allocator->generation();
+    bufferChanged = false;
+  }
+  // The binding point is shared by all programs, so it is bound again for every draw.
+  auto gl = GLFunctions::Get(context);
+  gl->bindBufferRange(GL_UNIFORM_BUFFER, UNIFORM_BLOCK_BINDING, blockBufferID,
+                      static_cast<GLintptr>(blockBufferOffset), static_cast<GLsizeiptr>(blockSize));
+}
 }  // namespace tgfx
@@ -22,10 +22,26 @@
 #include "tgfx/gpu/Context.h"
 
 namespace tgfx {
+/**
+ * The binding point of the uniform block declared by programs when Caps::uniformBufferSupport is
+ * true.
+ */
+static constexpr unsigned UNIFORM_BLOCK_BINDING = 0;
+
 class GLUniformBuffer : public UniformBuffer {
  public:
+  /**
+   * Creates a uniform buffer that sets each uniform at its location with glUniform*().
+   */
   GLUniformBuffer(std::vector<Uniform> uniforms, std::vector<int> locations);
 
+  /**
+   * Creates a uniform buffer that stores the uniforms in the std140 layout of a uniform block. The
+   * block is streamed into a shared uniform buffer and bound with a single glBindBufferRange()
+   * call per draw.
+   */
+  explicit GLUniformBuffer(std::vector<Uniform> uniforms);
+
   ~GLUniformBuffer() override;
 
   void uploadToGPU(Context* context);
@@ -38,5 +54,12 @@ class GLUniformBuffer : public UniformBuffer {
   bool bufferChanged = false;
   std::vector<int> locations = {};
   std::vector<bool> dirtyFlags = {};
+  std::vector<size_t> blockOffsets = {};
+  size_t blockSize = 0;
+  unsigned blockBufferID = 0;
+  size_t blockBufferOffset = 0;
+  uint64_t blockGeneration = 0;
+
+  void uploadUniformBlock(Context* context);
 };
 }  // namespace tgfx
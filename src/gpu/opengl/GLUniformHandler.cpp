@@ -27,6 +27,8 @@ std::string GLUniformHandler::internalAddUniform(ShaderFlags visibility, SLType
   uniform.variable.setTypeModifier(ShaderVar::TypeModifier::Uniform);
   uniform.variable.setName(programBuilder->nameVariable(name));
   uniform.visibility = visibility;
+  uniform.handle = UniformHandle(name);
+  uniform.processorIndex = programBuilder->currentProcessorIndex();
   uniforms.push_back(uniform);
   return uniform.variable.name();
 }
@@ -61,13 +63,33 @@ SamplerHandle GLUniformHandler::internalAddSampler(const TextureSampler* sampler
   return SamplerHandle(samplers.size() - 1);
 }
 
+static constexpr char UNIFORM_BLOCK_NAME[] = "UniformBlock";
+
+bool GLUniformHandler::usesUniformBlock() const {
+  return programBuilder->getContext()->caps()->uniformBufferSupport && !uniforms.empty();
+}
+
 std::string GLUniformHandler::getUniformDeclarations(ShaderFlags visibility) const {
   std::string ret;
-  for (auto& uniform : uniforms) {
-    if ((uniform.visibility & visibility) == visibility) {
-      ret += programBuilder->getShaderVarDeclarations(uniform.variable, visibility);
+  if (usesUniformBlock()) {
+    // Both shaders declare the same block with all members, which keeps their layouts identical.
+    ret += "layout(std140) uniform ";
+    ret += UNIFORM_BLOCK_NAME;
+    ret += " {\n";
+    for (auto& uniform : uniforms) {
+      ShaderVar member(uniform.variable.name(), uniform.variable.type());
+      ret += "  ";
+      ret += programBuilder->getShaderVarDeclarations(member, visibility);
       ret += ";\n";
     }
+    ret += "};\n";
+  } else {
+    for (auto& uniform : uniforms) {
+      if ((uniform.visibility & visibility) == visibility) {
+        ret += programBuilder->getShaderVarDeclarations(uniform.variable, visibility);
+        ret += ";\n";
+      }
+    }
   }
   for (const auto& sampler : samplers) {
     if ((sampler.visibility & visibility) == visibility) {
@@ -80,8 +102,15 @@ std::string GLUniformHandler::getUniformDeclarations(ShaderFlags visibility) con
 
 void GLUniformHandler::resolveUniformLocations(unsigned programID) {
   auto gl = GLFunctions::Get(programBuilder->getContext());
-  for (auto& uniform : uniforms) {
-    uniform.location = gl->getUniformLocation(programID, uniform.variable.name().c_str());
+  if (usesUniformBlock()) {
+    auto blockIndex = gl->getUniformBlockIndex(programID, UNIFORM_BLOCK_NAME);
+    if (blockIndex != GL_INVALID_INDEX) {
+      gl->uniformBlockBinding(programID, blockIndex, UNIFORM_BLOCK_BINDING);
+    }
+  } else {
+    for (auto& uniform : uniforms) {
+      uniform.location = gl->getUniformLocation(programID, uniform.variable.name().c_str());
+    }
   }
   for (auto& sampler : samplers) {
     sampler.location = gl->getUniformLocation(programID, sampler.variable.name().c_str());
@@ -135,10 +164,14 @@ std::unique_ptr<GLUniformBuffer> GLUniformHandler::makeUniformBuffer() const {
         break;
     }
     if (type.has_value()) {
-      uniformList.push_back({uniform.variable.name(), *type});
+      uniformList.push_back(
+          {uniform.variable.name(), *type, uniform.handle, uniform.processorIndex});
       locations.push_back(uniform.location);
     }
   }
+  if (usesUniformBlock()) {
+    return std::make_unique<GLUniformBuffer>(std::move(uniformList));
+  }
   return std::make_unique<GLUniformBuffer>(std::move(uniformList), std::move(locations));
 }
 }  // namespace tgfx
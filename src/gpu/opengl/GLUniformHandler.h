@@ -29,6 +29,8 @@ struct GLUniform {
   ShaderVar variable;
   ShaderFlags visibility = ShaderFlags::None;
   int location = UNUSED_UNIFORM;
+  UniformHandle handle = {};
+  int processorIndex = -1;
 };
 
 class GLUniformHandler : public UniformHandler {
@@ -51,6 +53,11 @@ class GLUniformHandler : public UniformHandler {
 
   std::string getUniformDeclarations(ShaderFlags visibility) const override;
 
+  /**
+   * Returns true if the uniforms are declared as members of a std140 uniform block.
+   */
+  bool usesUniformBlock() const;
+
   void resolveUniformLocations(unsigned programID);
 
   std::unique_ptr<GLUniformBuffer> makeUniformBuffer() const;
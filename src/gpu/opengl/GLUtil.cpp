@@ -87,7 +87,8 @@ GLVersion GetGLVersion(const char* versionString) {
   return {};
 }
 
-unsigned CreateGLProgram(Context* context, const std::string& vertex, const std::string& fragment) {
+unsigned CreateGLProgram(Context* context, const std::string& vertex, const std::string& fragment,
+                         bool retrievableBinary) {
   auto vertexShader = LoadGLShader(context, GL_VERTEX_SHADER, vertex);
   if (vertexShader == 0) {
     return 0;
@@ -100,6 +101,9 @@ unsigned CreateGLProgram(Context* context, const std::string& vertex, const std:
   auto programHandle = gl->createProgram();
   gl->attachShader(programHandle, vertexShader);
   gl->attachShader(programHandle, fragmentShader);
+  if (retrievableBinary && gl->programParameteri != nullptr) {
+    gl->programParameteri(programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   gl->linkProgram(programHandle);
   int success;
   gl->getProgramiv(programHandle, GL_LINK_STATUS, &success);
@@ -42,7 +42,8 @@ unsigned PixelFormatToGLSizeFormat(PixelFormat pixelFormat);
 
 GLVersion GetGLVersion(const char* versionString);
 
-unsigned CreateGLProgram(Context* context, const std::string& vertex, const std::string& fragment);
+unsigned CreateGLProgram(Context* context, const std::string& vertex, const std::string& fragment,
+                         bool retrievableBinary = false);
 
 unsigned LoadGLShader(Context* context, unsigned shaderType, const std::string& source);
 
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLVertexArray.h"
+#include "GLState.h"
 #include "tgfx/gpu/opengl/GLFunctions.h"
 
 namespace tgfx {
@@ -37,6 +38,7 @@ void GLVertexArray::onReleaseGPU() {
   auto gl = GLFunctions::Get(context);
   if (_id > 0) {
     gl->deleteVertexArrays(1, &_id);
+    GLState::Get(context)->onDeleteVertexArray(_id);
     _id = 0;
   }
 }
@@ -26,6 +26,7 @@
 #include "core/utils/UniqueID.h"
 #include "gpu/Gpu.h"
 #include "gpu/opengl/GLSampler.h"
+#include "gpu/opengl/GLState.h"
 #include "tgfx/gpu/opengl/egl/EGLDevice.h"
 #if defined(__OHOS__)
 #include <native_buffer/native_buffer.h>
@@ -123,11 +124,12 @@ std::shared_ptr<EGLHardwareTexture> EGLHardwareTexture::MakeFrom(Context* contex
     eglext::eglDestroyImageKHR(display, eglImage);
     return nullptr;
   }
-  glBindTexture(sampler->target, sampler->id);
-  glTexParameteri(sampler->target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(sampler->target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri(sampler->target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(sampler->target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  auto state = GLState::Get(context);
+  state->bindTexture(sampler->target, sampler->id);
+  state->setTextureParameter(sampler->target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  state->setTextureParameter(sampler->target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  state->setTextureParameter(sampler->target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  state->setTextureParameter(sampler->target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
   eglext::glEGLImageTargetTexture2DOES(sampler->target, (GLeglImageOES)eglImage);
   auto eglHardwareTexture = new EGLHardwareTexture(hardwareBuffer, eglImage, width, height);
   glTexture = Resource::AddToCache(context, eglHardwareTexture, scratchKey);
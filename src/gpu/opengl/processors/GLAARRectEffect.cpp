@@ -0,0 +1,61 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLAARRectEffect.h"
+
+namespace tgfx {
+static constexpr UniformHandle InnerRectUniform("InnerRect");
+static constexpr UniformHandle InvRadiiSquaredUniform("InvRadiiSquared");
+
+std::unique_ptr<AARRectEffect> AARRectEffect::Make(const RRect& rRect) {
+  return std::unique_ptr<AARRectEffect>(new GLAARRectEffect(rRect));
+}
+
+GLAARRectEffect::GLAARRectEffect(const RRect& rRect) : AARRectEffect(rRect) {
+}
+
+void GLAARRectEffect::emitCode(EmitArgs& args) const {
+  auto* fragBuilder = args.fragBuilder;
+  auto* uniformHandler = args.uniformHandler;
+
+  auto rectName = uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "InnerRect");
+  auto radiiName =
+      uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float2, "InvRadiiSquared");
+  // The distance to the inner rect is zero everywhere except the corners and the outside edges,
+  // where the implicit ellipse function divided by its gradient length approximates the distance
+  // to the boundary.
+  fragBuilder->codeAppendf("vec2 dxy0 = %s.xy - gl_FragCoord.xy;", rectName.c_str());
+  fragBuilder->codeAppendf("vec2 dxy1 = gl_FragCoord.xy - %s.zw;", rectName.c_str());
+  fragBuilder->codeAppend("vec2 dxy = max(max(dxy0, dxy1), 0.0);");
+  fragBuilder->codeAppendf("vec2 Z = dxy * %s;", radiiName.c_str());
+  fragBuilder->codeAppend("float implicit = dot(Z, dxy) - 1.0;");
+  fragBuilder->codeAppend("float gradDot = max(4.0 * dot(Z, Z), 1.0e-4);");
+  fragBuilder->codeAppend("float approxDist = implicit * inversesqrt(gradDot);");
+  fragBuilder->codeAppend("float coverage = clamp(0.5 - approxDist, 0.0, 1.0);");
+  fragBuilder->codeAppendf("%s = %s * coverage;", args.outputColor.c_str(),
+                           args.inputColor.c_str());
+}
+
+void GLAARRectEffect::onSetData(UniformBuffer* uniformBuffer) const {
+  auto& radii = rRect.radii;
+  auto innerRect = rRect.rect.makeInset(radii.x, radii.y);
+  uniformBuffer->setData(InnerRectUniform, innerRect);
+  Point invRadiiSquared = {1.0f / (radii.x * radii.x), 1.0f / (radii.y * radii.y)};
+  uniformBuffer->setData(InvRadiiSquaredUniform, invRadiiSquared);
+}
+}  // namespace tgfx
@@ -19,6 +19,8 @@
 #include "GLAARectEffect.h"
 
 namespace tgfx {
+static constexpr UniformHandle RectUniform("Rect");
+
 std::unique_ptr<AARectEffect> AARectEffect::Make(const Rect& rect) {
   return std::unique_ptr<AARectEffect>(new GLAARectEffect(rect));
 }
@@ -44,6 +46,6 @@ void GLAARectEffect::onSetData(UniformBuffer* uniformBuffer) const {
   // The AA math in the shader evaluates to 0 at the uploaded coordinates, so outset by 0.5
   // to interpolate from 0 at a half pixel inset and 1 at a half pixel outset of rect.
   auto outRect = rect.makeOutset(0.5f, 0.5f);
-  uniformBuffer->setData("Rect", outRect);
+  uniformBuffer->setData(RectUniform, outRect);
 }
 }  // namespace tgfx
@@ -19,6 +19,8 @@
 #include "GLAlphaThresholdFragmentProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle ThresholdUniform("Threshold");
+
 void GLAlphaThresholdFragmentProcessor::emitCode(EmitArgs& args) const {
   auto* uniformHandler = args.uniformHandler;
   auto thresholdUniformName =
@@ -41,7 +43,7 @@ void GLAlphaThresholdFragmentProcessor::emitCode(EmitArgs& args) const {
 }
 
 void GLAlphaThresholdFragmentProcessor::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("Threshold", threshold);
+  uniformBuffer->setData(ThresholdUniform, threshold);
 }
 
 }  // namespace tgfx
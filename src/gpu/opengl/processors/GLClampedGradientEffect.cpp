@@ -19,6 +19,9 @@
 #include "GLClampedGradientEffect.h"
 
 namespace tgfx {
+static constexpr UniformHandle LeftBorderColorUniform("leftBorderColor");
+static constexpr UniformHandle RightBorderColorUniform("rightBorderColor");
+
 std::unique_ptr<ClampedGradientEffect> ClampedGradientEffect::Make(
     std::unique_ptr<FragmentProcessor> colorizer, std::unique_ptr<FragmentProcessor> gradLayout,
     Color leftBorderColor, Color rightBorderColor) {
@@ -60,7 +63,7 @@ void GLClampedGradientEffect::emitCode(EmitArgs& args) const {
 }
 
 void GLClampedGradientEffect::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("leftBorderColor", leftBorderColor);
-  uniformBuffer->setData("rightBorderColor", rightBorderColor);
+  uniformBuffer->setData(LeftBorderColorUniform, leftBorderColor);
+  uniformBuffer->setData(RightBorderColorUniform, rightBorderColor);
 }
 }  // namespace tgfx
@@ -19,6 +19,9 @@
 #include "GLColorMatrixFragmentProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle MatrixUniform("Matrix");
+static constexpr UniformHandle VectorUniform("Vector");
+
 std::unique_ptr<ColorMatrixFragmentProcessor> ColorMatrixFragmentProcessor::Make(
     const std::array<float, 20>& matrix) {
   return std::unique_ptr<ColorMatrixFragmentProcessor>(new GLColorMatrixFragmentProcessor(matrix));
@@ -58,7 +61,7 @@ void GLColorMatrixFragmentProcessor::onSetData(UniformBuffer* uniformBuffer) con
       matrix[14],
       matrix[19],
   };
-  uniformBuffer->setData("Matrix", m);
-  uniformBuffer->setData("Vector", vec);
+  uniformBuffer->setData(MatrixUniform, m);
+  uniformBuffer->setData(VectorUniform, vec);
 }
 }  // namespace tgfx
@@ -19,6 +19,9 @@
 #include "GLConicGradientLayout.h"
 
 namespace tgfx {
+static constexpr UniformHandle BiasUniform("Bias");
+static constexpr UniformHandle ScaleUniform("Scale");
+
 std::unique_ptr<ConicGradientLayout> ConicGradientLayout::Make(Matrix matrix, float bias,
                                                                float scale) {
   return std::unique_ptr<ConicGradientLayout>(new GLConicGradientLayout(matrix, bias, scale));
@@ -42,7 +45,7 @@ void GLConicGradientLayout::emitCode(EmitArgs& args) const {
 }
 
 void GLConicGradientLayout::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("Bias", bias);
-  uniformBuffer->setData("Scale", scale);
+  uniformBuffer->setData(BiasUniform, bias);
+  uniformBuffer->setData(ScaleUniform, scale);
 }
 }  // namespace tgfx
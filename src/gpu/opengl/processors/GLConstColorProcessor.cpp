@@ -19,6 +19,8 @@
 #include "GLConstColorProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle ColorUniform("Color");
+
 std::unique_ptr<ConstColorProcessor> ConstColorProcessor::Make(Color color, InputMode mode) {
   return std::unique_ptr<ConstColorProcessor>(new GLConstColorProcessor(color, mode));
 }
@@ -44,6 +46,6 @@ void GLConstColorProcessor::emitCode(EmitArgs& args) const {
 }
 
 void GLConstColorProcessor::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("Color", color);
+  uniformBuffer->setData(ColorUniform, color);
 }
 }  // namespace tgfx
@@ -19,6 +19,9 @@
 #include "GLDefaultGeometryProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle ColorUniform("Color");
+static constexpr UniformHandle MatrixUniform("Matrix");
+
 std::unique_ptr<DefaultGeometryProcessor> DefaultGeometryProcessor::Make(Color color, int width,
                                                                          int height, AAType aa,
                                                                          const Matrix& viewMatrix,
@@ -27,12 +30,23 @@ std::unique_ptr<DefaultGeometryProcessor> DefaultGeometryProcessor::Make(Color c
       new GLDefaultGeometryProcessor(color, width, height, aa, viewMatrix, uvMatrix));
 }
 
+std::unique_ptr<DefaultGeometryProcessor> DefaultGeometryProcessor::MakeInstanced(int width,
+                                                                                  int height,
+                                                                                  AAType aa) {
+  return std::unique_ptr<DefaultGeometryProcessor>(
+      new GLDefaultGeometryProcessor(width, height, aa));
+}
+
 GLDefaultGeometryProcessor::GLDefaultGeometryProcessor(Color color, int width, int height,
                                                        AAType aa, const Matrix& viewMatrix,
                                                        const Matrix& uvMatrix)
     : DefaultGeometryProcessor(color, width, height, aa, viewMatrix, uvMatrix) {
 }
 
+GLDefaultGeometryProcessor::GLDefaultGeometryProcessor(int width, int height, AAType aa)
+    : DefaultGeometryProcessor(width, height, aa) {
+}
+
 void GLDefaultGeometryProcessor::emitCode(EmitArgs& args) const {
   auto* vertBuilder = args.vertBuilder;
   auto* fragBuilder = args.fragBuilder;
@@ -41,11 +55,18 @@ void GLDefaultGeometryProcessor::emitCode(EmitArgs& args) const {
 
   varyingHandler->emitAttributes(*this);
 
-  auto matrixName =
-      args.uniformHandler->addUniform(ShaderFlags::Vertex, SLType::Float3x3, "Matrix");
   std::string positionName = "position";
-  vertBuilder->codeAppendf("vec2 %s = (%s * vec3(%s, 1.0)).xy;", positionName.c_str(),
-                           matrixName.c_str(), position.name().c_str());
+  if (instanced) {
+    vertBuilder->codeAppendf("vec3 localPosition = vec3(%s, 1.0);", position.name().c_str());
+    vertBuilder->codeAppendf("vec2 %s = vec2(dot(%s, localPosition), dot(%s, localPosition));",
+                             positionName.c_str(), instanceMatrixRow0.name().c_str(),
+                             instanceMatrixRow1.name().c_str());
+  } else {
+    auto matrixName =
+        args.uniformHandler->addUniform(ShaderFlags::Vertex, SLType::Float3x3, "Matrix");
+    vertBuilder->codeAppendf("vec2 %s = (%s * vec3(%s, 1.0)).xy;", positionName.c_str(),
+                             matrixName.c_str(), position.name().c_str());
+  }
 
   emitTransforms(vertBuilder, varyingHandler, uniformHandler, position.asShaderVar(),
                  args.fpCoordTransformHandler);
@@ -59,8 +80,15 @@ void GLDefaultGeometryProcessor::emitCode(EmitArgs& args) const {
     fragBuilder->codeAppendf("%s = vec4(1.0);", args.outputCoverage.c_str());
   }
 
-  auto colorName = args.uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "Color");
-  fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorName.c_str());
+  if (instanced) {
+    auto colorVar = varyingHandler->addVarying("Color", SLType::Float4);
+    vertBuilder->codeAppendf("%s = %s;", colorVar.vsOut().c_str(), instanceColor.name().c_str());
+    fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorVar.fsIn().c_str());
+  } else {
+    auto colorName =
+        args.uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "Color");
+    fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorName.c_str());
+  }
 
   // Emit the vertex position to the hardware in the normalized window coordinates it expects.
   args.vertBuilder->emitNormalizedPosition(positionName);
@@ -69,7 +97,10 @@ void GLDefaultGeometryProcessor::emitCode(EmitArgs& args) const {
 void GLDefaultGeometryProcessor::setData(UniformBuffer* uniformBuffer,
                                          FPCoordTransformIter* transformIter) const {
   setTransformDataHelper(uvMatrix, uniformBuffer, transformIter);
-  uniformBuffer->setData("Color", color);
-  uniformBuffer->setData("Matrix", viewMatrix);
+  if (instanced) {
+    return;
+  }
+  uniformBuffer->setData(ColorUniform, color);
+  uniformBuffer->setData(MatrixUniform, viewMatrix);
 }
 }  // namespace tgfx
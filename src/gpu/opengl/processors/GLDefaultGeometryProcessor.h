@@ -27,6 +27,8 @@ class GLDefaultGeometryProcessor : public DefaultGeometryProcessor {
   GLDefaultGeometryProcessor(Color color, int width, int height, AAType aa,
                              const Matrix& viewMatrix, const Matrix& uvMatrix);
 
+  GLDefaultGeometryProcessor(int width, int height, AAType aa);
+
   void emitCode(EmitArgs& args) const override;
 
   void setData(UniformBuffer* uniformBuffer, FPCoordTransformIter* transformIter) const override;
@@ -19,6 +19,8 @@
 #include "GLDeviceSpaceTextureEffect.h"
 
 namespace tgfx {
+static constexpr UniformHandle DeviceCoordMatrixUniform("DeviceCoordMatrix");
+
 std::unique_ptr<DeviceSpaceTextureEffect> DeviceSpaceTextureEffect::Make(
     std::shared_ptr<TextureProxy> textureProxy, const Matrix& uvMatrix) {
   if (textureProxy == nullptr) {
@@ -61,6 +63,6 @@ void GLDeviceSpaceTextureEffect::onSetData(UniformBuffer* uniformBuffer) const {
   auto deviceCoordMatrix = uvMatrix;
   auto scale = texture->getTextureCoord(1, 1);
   deviceCoordMatrix.postScale(scale.x, scale.y);
-  uniformBuffer->setData("DeviceCoordMatrix", deviceCoordMatrix);
+  uniformBuffer->setData(DeviceCoordMatrixUniform, deviceCoordMatrix);
 }
 }  // namespace tgfx
@@ -20,6 +20,9 @@
 #include "core/utils/Log.h"
 
 namespace tgfx {
+static constexpr UniformHandle BlurUniform("Blur");
+static constexpr UniformHandle StepUniform("Step");
+
 std::unique_ptr<DualBlurFragmentProcessor> DualBlurFragmentProcessor::Make(
     DualBlurPassMode passMode, std::unique_ptr<FragmentProcessor> processor, Point blurOffset) {
   if (processor == nullptr) {
@@ -101,7 +104,7 @@ void GLDualBlurFragmentProcessor::onSetData(UniformBuffer* uniformBuffer) const
     matrix.mapPoints(stepVectors, 2);
   }
   Point step = stepVectors[1] - stepVectors[0];
-  uniformBuffer->setData("Blur", blurOffset);
-  uniformBuffer->setData("Step", step);
+  uniformBuffer->setData(BlurUniform, blurOffset);
+  uniformBuffer->setData(StepUniform, step);
 }
 }  // namespace tgfx
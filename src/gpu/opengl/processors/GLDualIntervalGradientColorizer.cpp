@@ -19,6 +19,12 @@
 #include "GLDualIntervalGradientColorizer.h"
 
 namespace tgfx {
+static constexpr UniformHandle Scale01Uniform("scale01");
+static constexpr UniformHandle Bias01Uniform("bias01");
+static constexpr UniformHandle Scale23Uniform("scale23");
+static constexpr UniformHandle Bias23Uniform("bias23");
+static constexpr UniformHandle ThresholdUniform("threshold");
+
 std::unique_ptr<DualIntervalGradientColorizer> DualIntervalGradientColorizer::Make(
     Color c0, Color c1, Color c2, Color c3, float threshold) {
   Color scale01;
@@ -74,10 +80,10 @@ void GLDualIntervalGradientColorizer::emitCode(EmitArgs& args) const {
 }
 
 void GLDualIntervalGradientColorizer::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("scale01", scale01);
-  uniformBuffer->setData("bias01", bias01);
-  uniformBuffer->setData("scale23", scale23);
-  uniformBuffer->setData("bias23", bias23);
-  uniformBuffer->setData("threshold", threshold);
+  uniformBuffer->setData(Scale01Uniform, scale01);
+  uniformBuffer->setData(Bias01Uniform, bias01);
+  uniformBuffer->setData(Scale23Uniform, scale23);
+  uniformBuffer->setData(Bias23Uniform, bias23);
+  uniformBuffer->setData(ThresholdUniform, threshold);
 }
 }  // namespace tgfx
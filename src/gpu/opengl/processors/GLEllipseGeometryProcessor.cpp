@@ -26,11 +26,58 @@ std::unique_ptr<EllipseGeometryProcessor> EllipseGeometryProcessor::Make(int wid
       new GLEllipseGeometryProcessor(width, height, stroke, useScale));
 }
 
+std::unique_ptr<EllipseGeometryProcessor> EllipseGeometryProcessor::MakeInstanced(int width,
+                                                                                  int height,
+                                                                                  bool useScale,
+                                                                                  AAType aa) {
+  return std::unique_ptr<EllipseGeometryProcessor>(
+      new GLEllipseGeometryProcessor(width, height, useScale, aa));
+}
+
 GLEllipseGeometryProcessor::GLEllipseGeometryProcessor(int width, int height, bool stroke,
                                                        bool useScale)
     : EllipseGeometryProcessor(width, height, stroke, useScale) {
 }
 
+GLEllipseGeometryProcessor::GLEllipseGeometryProcessor(int width, int height, bool useScale,
+                                                       AAType aa)
+    : EllipseGeometryProcessor(width, height, useScale, aa) {
+}
+
+void GLEllipseGeometryProcessor::emitInstancedVertices(EmitArgs& args) const {
+  // Mirrors the vertex generation of RRectVerticesProvider. The xy components of the corner select
+  // the left/top or right/bottom edge of the bloated bounds, and the zw components move the vertex
+  // inwards by the outer radii.
+  auto* vertBuilder = args.vertBuilder;
+  auto& corner = inPosition.name();
+  auto& rect = inRect.name();
+  auto& radii = inRadii.name();
+  // On MSAA, bloat by sqrt(2) to guarantee full sample coverage, see RRectVerticesProvider.
+  auto aaBloat = aa == AAType::MSAA ? "1.41421356" : "0.5";
+  vertBuilder->codeAppendf("vec4 bounds = %s + vec4(-%s, -%s, %s, %s);", rect.c_str(), aaBloat,
+                           aaBloat, aaBloat, aaBloat);
+  vertBuilder->codeAppendf("vec2 outerRadii = %s + vec2(%s);", radii.c_str(), aaBloat);
+  vertBuilder->codeAppendf("vec2 localPosition = mix(bounds.xy, bounds.zw, %s.xy) + %s.zw * "
+                           "outerRadii;",
+                           corner.c_str(), corner.c_str());
+  vertBuilder->codeAppend("vec3 localPoint = vec3(localPosition, 1.0);");
+  vertBuilder->codeAppendf("vec2 devicePosition = vec2(dot(%s, localPoint), dot(%s, localPoint));",
+                           inMatrixRow0.name().c_str(), inMatrixRow1.name().c_str());
+  // The inner offsets use FLOAT_NEARLY_ZERO (1 / 4096) since the shader calls inversesqrt().
+  vertBuilder->codeAppendf("vec2 offset = mix(outerRadii / %s, vec2(0.000244140625), abs(%s.zw));",
+                           radii.c_str(), corner.c_str());
+  if (useScale) {
+    vertBuilder->codeAppendf("vec3 ellipseOffset = vec3(offset, max(%s.x, %s.y));", radii.c_str(),
+                             radii.c_str());
+  } else {
+    vertBuilder->codeAppend("vec2 ellipseOffset = offset;");
+  }
+  vertBuilder->codeAppendf("vec2 reciprocalRadii = vec2(%s.x > 0.0 ? 1.0 / %s.x : 1000000.0, "
+                           "%s.y > 0.0 ? 1.0 / %s.y : 1000000.0);",
+                           radii.c_str(), radii.c_str(), radii.c_str(), radii.c_str());
+  vertBuilder->codeAppend("vec4 ellipseRadii = vec4(reciprocalRadii, 1000000.0, 1000000.0);");
+}
+
 void GLEllipseGeometryProcessor::emitCode(EmitArgs& args) const {
   auto* vertBuilder = args.vertBuilder;
   auto* varyingHandler = args.varyingHandler;
@@ -39,25 +86,36 @@ void GLEllipseGeometryProcessor::emitCode(EmitArgs& args) const {
   // emit attributes
   varyingHandler->emitAttributes(*this);
 
+  auto positionName = inPosition.name();
+  auto offsetName = inEllipseOffset.name();
+  auto radiiName = inEllipseRadii.name();
+  auto colorName = inColor.name();
+  if (instanced) {
+    emitInstancedVertices(args);
+    positionName = "devicePosition";
+    offsetName = "ellipseOffset";
+    radiiName = "ellipseRadii";
+    colorName = inInstanceColor.name();
+  }
+
   auto offsetType = useScale ? SLType::Float3 : SLType::Float2;
   auto ellipseOffsets = varyingHandler->addVarying("EllipseOffsets", offsetType);
-  vertBuilder->codeAppendf("%s = %s;", ellipseOffsets.vsOut().c_str(),
-                           inEllipseOffset.name().c_str());
+  vertBuilder->codeAppendf("%s = %s;", ellipseOffsets.vsOut().c_str(), offsetName.c_str());
 
   auto ellipseRadii = varyingHandler->addVarying("EllipseRadii", SLType::Float4);
-  vertBuilder->codeAppendf("%s = %s;", ellipseRadii.vsOut().c_str(), inEllipseRadii.name().c_str());
+  vertBuilder->codeAppendf("%s = %s;", ellipseRadii.vsOut().c_str(), radiiName.c_str());
 
   auto* fragBuilder = args.fragBuilder;
   // setup pass through color
   auto color = varyingHandler->addVarying("Color", SLType::Float4);
-  vertBuilder->codeAppendf("%s = %s;", color.vsOut().c_str(), inColor.name().c_str());
+  vertBuilder->codeAppendf("%s = %s;", color.vsOut().c_str(), colorName.c_str());
   fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), color.fsIn().c_str());
 
   // Setup position
-  args.vertBuilder->emitNormalizedPosition(inPosition.name());
+  args.vertBuilder->emitNormalizedPosition(positionName);
   // emit transforms
-  emitTransforms(vertBuilder, varyingHandler, uniformHandler, inPosition.asShaderVar(),
-                 args.fpCoordTransformHandler);
+  emitTransforms(vertBuilder, varyingHandler, uniformHandler,
+                 ShaderVar(positionName, SLType::Float2), args.fpCoordTransformHandler);
   // For stroked ellipses, we use the full ellipse equation (x^2/a^2 + y^2/b^2 = 1)
   // to compute both the edges because we need two separate test equations for
   // the single offset.
@@ -25,8 +25,13 @@ class GLEllipseGeometryProcessor : public EllipseGeometryProcessor {
  public:
   GLEllipseGeometryProcessor(int width, int height, bool stroke, bool useScale);
 
+  GLEllipseGeometryProcessor(int width, int height, bool useScale, AAType aa);
+
   void emitCode(EmitArgs& args) const override;
 
   void setData(UniformBuffer* uniformBuffer, FPCoordTransformIter* transformIter) const override;
+
+ private:
+  void emitInstancedVertices(EmitArgs& args) const;
 };
 }  // namespace tgfx
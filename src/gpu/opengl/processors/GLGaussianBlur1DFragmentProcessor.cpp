@@ -19,6 +19,9 @@
 #include "GLGaussianBlur1DFragmentProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle SigmaUniform("Sigma");
+static constexpr UniformHandle StepUniform("Step");
+
 
 std::unique_ptr<GaussianBlur1DFragmentProcessor> GaussianBlur1DFragmentProcessor::Make(
     std::unique_ptr<FragmentProcessor> processor, float sigma, GaussianBlurDirection direction,
@@ -80,7 +83,7 @@ void GLGaussianBlur1DFragmentProcessor::onSetData(UniformBuffer* uniformBuffer)
     matrix.mapPoints(stepVectors, 2);
   }
   Point step = stepVectors[1] - stepVectors[0];
-  uniformBuffer->setData("Sigma", sigma);
-  uniformBuffer->setData("Step", step);
+  uniformBuffer->setData(SigmaUniform, sigma);
+  uniformBuffer->setData(StepUniform, step);
 }
 }  // namespace tgfx
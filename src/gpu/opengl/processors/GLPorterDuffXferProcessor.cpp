@@ -20,6 +20,9 @@
 #include "gpu/opengl/GLBlend.h"
 
 namespace tgfx {
+static constexpr UniformHandle DstTextureUpperLeftUniform("DstTextureUpperLeft");
+static constexpr UniformHandle DstTextureCoordScaleUniform("DstTextureCoordScale");
+
 std::unique_ptr<PorterDuffXferProcessor> PorterDuffXferProcessor::Make(
     BlendMode blend, DstTextureInfo dstTextureInfo) {
   return std::unique_ptr<PorterDuffXferProcessor>(
@@ -81,7 +84,7 @@ void GLPorterDuffXferProcessor::setData(UniformBuffer* uniformBuffer) const {
   if (dstTexture == nullptr) {
     return;
   }
-  uniformBuffer->setData("DstTextureUpperLeft", dstTextureInfo.offset);
+  uniformBuffer->setData(DstTextureUpperLeftUniform, dstTextureInfo.offset);
   int width;
   int height;
   if (dstTexture->getSampler()->type() == SamplerType::Rectangle) {
@@ -92,6 +95,6 @@ void GLPorterDuffXferProcessor::setData(UniformBuffer* uniformBuffer) const {
     height = dstTexture->height();
   }
   float scales[] = {1.f / static_cast<float>(width), 1.f / static_cast<float>(height)};
-  uniformBuffer->setData("DstTextureCoordScale", scales);
+  uniformBuffer->setData(DstTextureCoordScaleUniform, scales);
 }
 }  // namespace tgfx
@@ -19,15 +19,39 @@
 #include "GLQuadPerEdgeAAGeometryProcessor.h"
 
 namespace tgfx {
+static constexpr UniformHandle ColorUniform("Color");
+
 std::unique_ptr<QuadPerEdgeAAGeometryProcessor> QuadPerEdgeAAGeometryProcessor::Make(
-    int width, int height, AAType aa, std::optional<Color> uniformColor, bool useUVCoord) {
-  return std::unique_ptr<QuadPerEdgeAAGeometryProcessor>(
-      new GLQuadPerEdgeAAGeometryProcessor(width, height, aa, uniformColor, useUVCoord));
+    int width, int height, AAType aa, std::optional<Color> uniformColor, bool useUVCoord,
+    bool instanced) {
+  return std::unique_ptr<QuadPerEdgeAAGeometryProcessor>(new GLQuadPerEdgeAAGeometryProcessor(
+      width, height, aa, uniformColor, useUVCoord, instanced));
 }
 
 GLQuadPerEdgeAAGeometryProcessor::GLQuadPerEdgeAAGeometryProcessor(
-    int width, int height, AAType aa, std::optional<Color> uniformColor, bool useUVCoord)
-    : QuadPerEdgeAAGeometryProcessor(width, height, aa, uniformColor, useUVCoord) {
+    int width, int height, AAType aa, std::optional<Color> uniformColor, bool useUVCoord,
+    bool instanced)
+    : QuadPerEdgeAAGeometryProcessor(width, height, aa, uniformColor, useUVCoord, instanced) {
+}
+
+void GLQuadPerEdgeAAGeometryProcessor::emitInstancedPosition(EmitArgs& args) const {
+  auto* vertBuilder = args.vertBuilder;
+  auto& rect = instanceRect.name();
+  auto& row0 = instanceMatrixRow0.name();
+  auto& row1 = instanceMatrixRow1.name();
+  vertBuilder->codeAppendf("vec2 localPosition = mix(%s.xy, %s.zw, %s.xy);", rect.c_str(),
+                           rect.c_str(), position.name().c_str());
+  if (aa == AAType::Coverage) {
+    // Inset the inner quad and outset the outer quad by half a pixel in the device space.
+    vertBuilder->codeAppendf("float padding = 0.5 / length(vec2(%s.x, %s.x));", row0.c_str(),
+                             row1.c_str());
+    vertBuilder->codeAppendf(
+        "localPosition += (%s.xy * 2.0 - 1.0) * padding * (1.0 - 2.0 * %s.z);",
+        position.name().c_str(), position.name().c_str());
+  }
+  vertBuilder->codeAppend("vec3 localPoint = vec3(localPosition, 1.0);");
+  vertBuilder->codeAppendf("vec2 devicePosition = vec2(dot(%s, localPoint), dot(%s, localPoint));",
+                           row0.c_str(), row1.c_str());
 }
 
 void GLQuadPerEdgeAAGeometryProcessor::emitCode(EmitArgs& args) const {
@@ -38,7 +62,13 @@ void GLQuadPerEdgeAAGeometryProcessor::emitCode(EmitArgs& args) const {
 
   varyingHandler->emitAttributes(*this);
 
+  auto positionName = position.name();
   auto uvCoordsVar = uvCoord.isInitialized() ? uvCoord.asShaderVar() : position.asShaderVar();
+  if (instanced) {
+    emitInstancedPosition(args);
+    positionName = "devicePosition";
+    uvCoordsVar = ShaderVar(useUVCoord ? "localPosition" : positionName, SLType::Float2);
+  }
   emitTransforms(vertBuilder, varyingHandler, uniformHandler, uvCoordsVar,
                  args.fpCoordTransformHandler);
 
@@ -56,20 +86,21 @@ void GLQuadPerEdgeAAGeometryProcessor::emitCode(EmitArgs& args) const {
         args.uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "Color");
     fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorName.c_str());
   } else {
+    auto& colorName = instanced ? instanceColor.name() : color.name();
     auto colorVar = varyingHandler->addVarying("Color", SLType::Float4);
-    vertBuilder->codeAppendf("%s = %s;", colorVar.vsOut().c_str(), color.name().c_str());
+    vertBuilder->codeAppendf("%s = %s;", colorVar.vsOut().c_str(), colorName.c_str());
     fragBuilder->codeAppendf("%s = %s;", args.outputColor.c_str(), colorVar.fsIn().c_str());
   }
 
   // Emit the vertex position to the hardware in the normalized window coordinates it expects.
-  args.vertBuilder->emitNormalizedPosition(position.name());
+  args.vertBuilder->emitNormalizedPosition(positionName);
 }
 
 void GLQuadPerEdgeAAGeometryProcessor::setData(UniformBuffer* uniformBuffer,
                                                FPCoordTransformIter* transformIter) const {
   setTransformDataHelper(Matrix::I(), uniformBuffer, transformIter);
   if (uniformColor.has_value()) {
-    uniformBuffer->setData("Color", *uniformColor);
+    uniformBuffer->setData(ColorUniform, *uniformColor);
   }
 }
 }  // namespace tgfx
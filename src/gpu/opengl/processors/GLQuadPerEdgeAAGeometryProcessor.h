@@ -25,10 +25,14 @@ namespace tgfx {
 class GLQuadPerEdgeAAGeometryProcessor : public QuadPerEdgeAAGeometryProcessor {
  public:
   GLQuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
-                                   std::optional<Color> uniformColor, bool useUVCoord);
+                                   std::optional<Color> uniformColor, bool useUVCoord,
+                                   bool instanced);
 
   void emitCode(EmitArgs& args) const override;
 
   void setData(UniformBuffer* uniformBuffer, FPCoordTransformIter* transformIter) const override;
+
+ private:
+  void emitInstancedPosition(EmitArgs& args) const;
 };
 }  // namespace tgfx
@@ -19,6 +19,9 @@
 #include "GLSingleIntervalGradientColorizer.h"
 
 namespace tgfx {
+static constexpr UniformHandle StartUniform("start");
+static constexpr UniformHandle EndUniform("end");
+
 std::unique_ptr<SingleIntervalGradientColorizer> SingleIntervalGradientColorizer::Make(Color start,
                                                                                        Color end) {
   return std::unique_ptr<SingleIntervalGradientColorizer>(
@@ -39,7 +42,7 @@ void GLSingleIntervalGradientColorizer::emitCode(EmitArgs& args) const {
 }
 
 void GLSingleIntervalGradientColorizer::onSetData(UniformBuffer* uniformBuffer) const {
-  uniformBuffer->setData("start", start);
-  uniformBuffer->setData("end", end);
+  uniformBuffer->setData(StartUniform, start);
+  uniformBuffer->setData(EndUniform, end);
 }
 }  // namespace tgfx
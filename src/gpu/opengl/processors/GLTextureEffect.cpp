@@ -20,6 +20,9 @@
 #include <unordered_map>
 
 namespace tgfx {
+static constexpr UniformHandle AlphaStartUniform("AlphaStart");
+static constexpr UniformHandle Mat3ColorConversionUniform("Mat3ColorConversion");
+
 static const float ColorConversion601LimitRange[] = {
     1.164384f, 1.164384f, 1.164384f, 0.0f, -0.391762f, 2.017232f, 1.596027f, -0.812968f, 0.0f,
 };
@@ -165,32 +168,31 @@ void GLTextureEffect::onSetData(UniformBuffer* uniformBuffer) const {
   }
   if (alphaStart != Point::Zero()) {
     auto alphaStartValue = texture->getTextureCoord(alphaStart.x, alphaStart.y);
-    uniformBuffer->setData("AlphaStart", alphaStartValue);
+    uniformBuffer->setData(AlphaStartUniform, alphaStartValue);
   }
   auto yuvTexture = getYUVTexture();
   if (yuvTexture) {
-    std::string mat3ColorConversion = "Mat3ColorConversion";
     switch (yuvTexture->colorSpace()) {
       case YUVColorSpace::BT601_LIMITED:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion601LimitRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion601LimitRange);
         break;
       case YUVColorSpace::BT601_FULL:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion601FullRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion601FullRange);
         break;
       case YUVColorSpace::BT709_LIMITED:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion709LimitRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion709LimitRange);
         break;
       case YUVColorSpace::BT709_FULL:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion709FullRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion709FullRange);
         break;
       case YUVColorSpace::BT2020_LIMITED:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion2020LimitRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion2020LimitRange);
         break;
       case YUVColorSpace::BT2020_FULL:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversion2020FullRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversion2020FullRange);
         break;
       case YUVColorSpace::JPEG_FULL:
-        uniformBuffer->setData(mat3ColorConversion, ColorConversionJPEGFullRange);
+        uniformBuffer->setData(Mat3ColorConversionUniform, ColorConversionJPEGFullRange);
         break;
       default:
         break;
@@ -21,6 +21,10 @@
 #include "gpu/processors/TextureEffect.h"
 
 namespace tgfx {
+static constexpr UniformHandle DimensionUniform("Dimension");
+static constexpr UniformHandle SubsetUniform("Subset");
+static constexpr UniformHandle ClampUniform("Clamp");
+
 std::unique_ptr<FragmentProcessor> TiledTextureEffect::Make(std::shared_ptr<TextureProxy> proxy,
                                                             TileMode tileModeX, TileMode tileModeY,
                                                             const SamplingOptions& options,
@@ -412,9 +416,9 @@ void GLTiledTextureEffect::onSetData(UniformBuffer* uniformBuffer) const {
                              texture->getSampler()->type() != SamplerType::Rectangle;
   if (hasDimensionUniform) {
     auto dimensions = texture->getTextureCoord(1.f, 1.f);
-    uniformBuffer->setData("Dimension", dimensions);
+    uniformBuffer->setData(DimensionUniform, dimensions);
   }
-  auto pushRect = [&](Rect subset, const std::string& uni) {
+  auto pushRect = [&](Rect subset, UniformHandle uni) {
     float rect[4] = {subset.left, subset.top, subset.right, subset.bottom};
     if (texture->origin() == ImageOrigin::BottomLeft) {
       auto h = static_cast<float>(texture->height());
@@ -434,10 +438,10 @@ void GLTiledTextureEffect::onSetData(UniformBuffer* uniformBuffer) const {
     uniformBuffer->setData(uni, rect);
   };
   if (ShaderModeUsesSubset(sampling.shaderModeX) || ShaderModeUsesSubset(sampling.shaderModeY)) {
-    pushRect(sampling.shaderSubset, "Subset");
+    pushRect(sampling.shaderSubset, SubsetUniform);
   }
   if (ShaderModeUsesClamp(sampling.shaderModeX) || ShaderModeUsesClamp(sampling.shaderModeY)) {
-    pushRect(sampling.shaderClamp, "Clamp");
+    pushRect(sampling.shaderClamp, ClampUniform);
   }
 }
 }  // namespace tgfx
@@ -20,6 +20,25 @@
 #include "core/utils/MathExtra.h"
 
 namespace tgfx {
+static constexpr UniformHandle Thresholds1_7Uniform("thresholds1_7");
+static constexpr UniformHandle Thresholds9_13Uniform("thresholds9_13");
+static constexpr UniformHandle Scale0_1Uniform("scale0_1");
+static constexpr UniformHandle Scale2_3Uniform("scale2_3");
+static constexpr UniformHandle Scale4_5Uniform("scale4_5");
+static constexpr UniformHandle Scale6_7Uniform("scale6_7");
+static constexpr UniformHandle Scale8_9Uniform("scale8_9");
+static constexpr UniformHandle Scale10_11Uniform("scale10_11");
+static constexpr UniformHandle Scale12_13Uniform("scale12_13");
+static constexpr UniformHandle Scale14_15Uniform("scale14_15");
+static constexpr UniformHandle Bias0_1Uniform("bias0_1");
+static constexpr UniformHandle Bias2_3Uniform("bias2_3");
+static constexpr UniformHandle Bias4_5Uniform("bias4_5");
+static constexpr UniformHandle Bias6_7Uniform("bias6_7");
+static constexpr UniformHandle Bias8_9Uniform("bias8_9");
+static constexpr UniformHandle Bias10_11Uniform("bias10_11");
+static constexpr UniformHandle Bias12_13Uniform("bias12_13");
+static constexpr UniformHandle Bias14_15Uniform("bias14_15");
+
 struct UnrolledBinaryUniformName {
   std::string scale0_1;
   std::string scale2_3;
@@ -262,31 +281,31 @@ void GLUnrolledBinaryGradientColorizer::emitCode(EmitArgs& args) const {
   fragBuilder->codeAppendf("%s = vec4(t * scale + bias);", args.outputColor.c_str());
 }
 
-void SetUniformData(UniformBuffer* uniformBuffer, const std::string& name, int intervalCount,
+void SetUniformData(UniformBuffer* uniformBuffer, UniformHandle handle, int intervalCount,
                     int limit, const Color& value) {
   if (intervalCount > limit) {
-    uniformBuffer->setData(name, value);
+    uniformBuffer->setData(handle, value);
   }
 }
 
 void GLUnrolledBinaryGradientColorizer::onSetData(UniformBuffer* uniformBuffer) const {
-  SetUniformData(uniformBuffer, "scale0_1", intervalCount, 0, scale0_1);
-  SetUniformData(uniformBuffer, "scale2_3", intervalCount, 1, scale2_3);
-  SetUniformData(uniformBuffer, "scale4_5", intervalCount, 2, scale4_5);
-  SetUniformData(uniformBuffer, "scale6_7", intervalCount, 3, scale6_7);
-  SetUniformData(uniformBuffer, "scale8_9", intervalCount, 4, scale8_9);
-  SetUniformData(uniformBuffer, "scale10_11", intervalCount, 5, scale10_11);
-  SetUniformData(uniformBuffer, "scale12_13", intervalCount, 6, scale12_13);
-  SetUniformData(uniformBuffer, "scale14_15", intervalCount, 7, scale14_15);
-  SetUniformData(uniformBuffer, "bias0_1", intervalCount, 0, bias0_1);
-  SetUniformData(uniformBuffer, "bias2_3", intervalCount, 1, bias2_3);
-  SetUniformData(uniformBuffer, "bias4_5", intervalCount, 2, bias4_5);
-  SetUniformData(uniformBuffer, "bias6_7", intervalCount, 3, bias6_7);
-  SetUniformData(uniformBuffer, "bias8_9", intervalCount, 4, bias8_9);
-  SetUniformData(uniformBuffer, "bias10_11", intervalCount, 5, bias10_11);
-  SetUniformData(uniformBuffer, "bias12_13", intervalCount, 6, bias12_13);
-  SetUniformData(uniformBuffer, "bias14_15", intervalCount, 7, bias14_15);
-  uniformBuffer->setData("thresholds1_7", thresholds1_7);
-  uniformBuffer->setData("thresholds9_13", thresholds9_13);
+  SetUniformData(uniformBuffer, Scale0_1Uniform, intervalCount, 0, scale0_1);
+  SetUniformData(uniformBuffer, Scale2_3Uniform, intervalCount, 1, scale2_3);
+  SetUniformData(uniformBuffer, Scale4_5Uniform, intervalCount, 2, scale4_5);
+  SetUniformData(uniformBuffer, Scale6_7Uniform, intervalCount, 3, scale6_7);
+  SetUniformData(uniformBuffer, Scale8_9Uniform, intervalCount, 4, scale8_9);
+  SetUniformData(uniformBuffer, Scale10_11Uniform, intervalCount, 5, scale10_11);
+  SetUniformData(uniformBuffer, Scale12_13Uniform, intervalCount, 6, scale12_13);
+  SetUniformData(uniformBuffer, Scale14_15Uniform, intervalCount, 7, scale14_15);
+  SetUniformData(uniformBuffer, Bias0_1Uniform, intervalCount, 0, bias0_1);
+  SetUniformData(uniformBuffer, Bias2_3Uniform, intervalCount, 1, bias2_3);
+  SetUniformData(uniformBuffer, Bias4_5Uniform, intervalCount, 2, bias4_5);
+  SetUniformData(uniformBuffer, Bias6_7Uniform, intervalCount, 3, bias6_7);
+  SetUniformData(uniformBuffer, Bias8_9Uniform, intervalCount, 4, bias8_9);
+  SetUniformData(uniformBuffer, Bias10_11Uniform, intervalCount, 5, bias10_11);
+  SetUniformData(uniformBuffer, Bias12_13Uniform, intervalCount, 6, bias12_13);
+  SetUniformData(uniformBuffer, Bias14_15Uniform, intervalCount, 7, bias14_15);
+  uniformBuffer->setData(Thresholds1_7Uniform, thresholds1_7);
+  uniformBuffer->setData(Thresholds9_13Uniform, thresholds9_13);
 }
 }  // namespace tgfx
@@ -28,6 +28,12 @@ static void emscripten_glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeou
   emscripten_glWaitSync(sync, flags, timeoutLo, timeoutHi);
 }
 
+static GLenum emscripten_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+  auto timeoutLo = static_cast<uint32_t>(timeout);
+  uint32_t timeoutHi = timeout >> 32;
+  return emscripten_glClientWaitSync(sync, flags, timeoutLo, timeoutHi);
+}
+
 void* WebGLProcGetter::getProcAddress(const char* name) const {
 #define N(X)                                        \
   if (0 == strcmp(#X, name)) {                      \
@@ -138,9 +144,13 @@ void* WebGLProcGetter::getProcAddress(const char* name) const {
   N(glGenVertexArraysOES)
   N(glFenceSync)
   N(glWaitSync)
+  N(glClientWaitSync)
   N(glDeleteSync)
   N(glBlitFramebuffer)
   N(glRenderbufferStorageMultisample)
+  N(glDrawArraysInstanced)
+  N(glDrawElementsInstanced)
+  N(glVertexAttribDivisor)
 #undef N
 
   // We explicitly do not use GetProcAddress or something similar because its code size is quite
@@ -19,21 +19,39 @@
 #include "DrawOp.h"
 #include "core/utils/Log.h"
 #include "gpu/Gpu.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
 std::unique_ptr<Pipeline> DrawOp::createPipeline(RenderPass* renderPass,
-                                                 std::unique_ptr<GeometryProcessor> gp) {
+                                                 std::unique_ptr<GeometryProcessor> gp,
+                                                 std::unique_ptr<FragmentProcessor> extraCoverage) {
   auto numColorProcessors = colors.size();
   std::vector<std::unique_ptr<FragmentProcessor>> fragmentProcessors = {};
   fragmentProcessors.resize(numColorProcessors + coverages.size());
   std::move(colors.begin(), colors.end(), fragmentProcessors.begin());
   std::move(coverages.begin(), coverages.end(),
             fragmentProcessors.begin() + static_cast<int>(numColorProcessors));
+  // Drop the moved-from processors, so a later pipeline never receives null entries.
+  colors.clear();
+  coverages.clear();
+  if (extraCoverage != nullptr) {
+    fragmentProcessors.push_back(std::move(extraCoverage));
+  }
   auto format = renderPass->renderTarget()->format();
   auto caps = renderPass->getContext()->caps();
   const auto& swizzle = caps->getWriteSwizzle(format);
-  return std::make_unique<Pipeline>(std::move(gp), std::move(fragmentProcessors),
-                                    numColorProcessors, std::move(xferProcessor), blendMode,
-                                    &swizzle);
+  auto pipeline = std::make_unique<Pipeline>(std::move(gp), std::move(fragmentProcessors),
+                                             numColorProcessors, std::move(xferProcessor),
+                                             blendMode, &swizzle);
+  pipeline->setStencilMode(stencilMode);
+  return pipeline;
+}
+
+std::unique_ptr<DataSource<Data>> DrawOp::MakeVertexSource(std::unique_ptr<DataSource<Data>> source,
+                                                           uint32_t renderFlags) {
+  if (source == nullptr || (renderFlags & RenderFlags::DisableAsyncTask)) {
+    return source;
+  }
+  return DataSource<Data>::Async(std::move(source));
 }
 }  // namespace tgfx
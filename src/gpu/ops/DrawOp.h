@@ -20,6 +20,7 @@
 
 #include <functional>
 #include "Op.h"
+#include "core/DataSource.h"
 #include "gpu/AAType.h"
 #include "gpu/Pipeline.h"
 #include "gpu/RenderPass.h"
@@ -27,8 +28,14 @@
 namespace tgfx {
 class DrawOp : public Op {
  public:
-  std::unique_ptr<Pipeline> createPipeline(RenderPass* renderPass,
-                                           std::unique_ptr<GeometryProcessor> gp);
+  /**
+   * Creates a pipeline that takes over the fragment processors and the xfer processor of the op,
+   * and appends the optional extraCoverage after the op's own coverage processors. Later calls
+   * create pipelines without them, so an op that draws with several pipelines must have none.
+   */
+  std::unique_ptr<Pipeline> createPipeline(
+      RenderPass* renderPass, std::unique_ptr<GeometryProcessor> gp,
+      std::unique_ptr<FragmentProcessor> extraCoverage = nullptr);
 
   const Rect& scissorRect() const {
     return _scissorRect;
@@ -38,6 +45,14 @@ class DrawOp : public Op {
     _scissorRect = scissorRect;
   }
 
+  /**
+   * Sets how the op uses the stencil buffer. Ops clipped by a path use StencilMode::TestClip to
+   * draw only inside the clip written by the preceding StencilClipOp.
+   */
+  void setStencilMode(StencilMode mode) {
+    stencilMode = mode;
+  }
+
   void setBlendMode(BlendMode mode) {
     blendMode = mode;
   }
@@ -60,11 +75,20 @@ class DrawOp : public Op {
   explicit DrawOp(AAType aaType) : aaType(aaType) {
   }
 
+  /**
+   * Prepares the transient vertex data of an op. Unless async tasks are disabled, the data is
+   * generated in a background task. Either way, it is streamed into the shared vertex buffers of
+   * the current flush when the op executes instead of getting a GPU buffer of its own.
+   */
+  static std::unique_ptr<DataSource<Data>> MakeVertexSource(
+      std::unique_ptr<DataSource<Data>> source, uint32_t renderFlags);
+
  private:
   Rect _scissorRect = Rect::MakeEmpty();
   std::vector<std::unique_ptr<FragmentProcessor>> colors = {};
   std::vector<std::unique_ptr<FragmentProcessor>> coverages = {};
   std::unique_ptr<XferProcessor> xferProcessor = nullptr;
   BlendMode blendMode = BlendMode::SrcOver;
+  StencilMode stencilMode = StencilMode::Disabled;
 };
 }  // namespace tgfx
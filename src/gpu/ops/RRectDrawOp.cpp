@@ -189,6 +189,45 @@ class RRectVerticesProvider : public DataSource<Data> {
   bool useScale = false;
 };
 
+class RRectInstancesProvider : public DataSource<Data> {
+ public:
+  explicit RRectInstancesProvider(std::vector<RRectPaint> rRectPaints)
+      : rRectPaints(std::move(rRectPaints)) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    // rect (4), radii (2), matrix rows (3 + 3), color (1)
+    static constexpr size_t PerInstanceCount = 13;
+    Buffer buffer(rRectPaints.size() * PerInstanceCount * sizeof(float));
+    auto vertices = reinterpret_cast<float*>(buffer.data());
+    auto index = 0;
+    for (auto& rRectPaint : rRectPaints) {
+      auto viewMatrix = rRectPaint.viewMatrix;
+      auto rRect = rRectPaint.rRect;
+      auto scales = viewMatrix.getAxisScales();
+      rRect.scale(scales.x, scales.y);
+      viewMatrix.preScale(1 / scales.x, 1 / scales.y);
+      vertices[index++] = rRect.rect.left;
+      vertices[index++] = rRect.rect.top;
+      vertices[index++] = rRect.rect.right;
+      vertices[index++] = rRect.rect.bottom;
+      vertices[index++] = rRect.radii.x;
+      vertices[index++] = rRect.radii.y;
+      vertices[index++] = viewMatrix.getScaleX();
+      vertices[index++] = viewMatrix.getSkewX();
+      vertices[index++] = viewMatrix.getTranslateX();
+      vertices[index++] = viewMatrix.getSkewY();
+      vertices[index++] = viewMatrix.getScaleY();
+      vertices[index++] = viewMatrix.getTranslateY();
+      WriteUByte4Color(vertices, index, rRectPaint.color);
+    }
+    return buffer.release();
+  }
+
+ private:
+  std::vector<RRectPaint> rRectPaints;
+};
+
 static bool UseScale(Context* context) {
   return !context->caps()->floatIs32Bits;
 }
@@ -201,14 +240,21 @@ std::unique_ptr<RRectDrawOp> RRectDrawOp::Make(Context* context,
   }
   auto drawOp = std::unique_ptr<RRectDrawOp>(new RRectDrawOp(aaType, rects.size()));
   drawOp->indexBufferProxy = context->resourceProvider()->rRectIndexBuffer();
+  if (rects.size() > 1 && context->caps()->instancedDrawSupport) {
+    // Upload one small record per round rect and expand it into the 9-patch in the vertex shader.
+    drawOp->instanced = true;
+    drawOp->vertexBufferProxy = context->resourceProvider()->rRectUnitBuffer();
+    auto instanceProvider = std::make_unique<RRectInstancesProvider>(rects);
+    drawOp->instanceSource = MakeVertexSource(std::move(instanceProvider), renderFlags);
+    return drawOp;
+  }
   auto useScale = UseScale(context);
   auto vertexProvider = std::make_unique<RRectVerticesProvider>(rects, aaType, useScale);
   if (rects.size() > 1) {
-    drawOp->vertexBufferProxy = GpuBufferProxy::MakeFrom(context, std::move(vertexProvider),
-                                                         BufferType::Vertex, renderFlags);
+    drawOp->vertexSource = MakeVertexSource(std::move(vertexProvider), renderFlags);
   } else {
     // If we only have one rect, it is not worth the async task overhead.
-    drawOp->vertexData = vertexProvider->getData();
+    drawOp->vertexSource = std::move(vertexProvider);
   }
   return drawOp;
 }
@@ -225,25 +271,42 @@ void RRectDrawOp::execute(RenderPass* renderPass) {
     return;
   }
   std::shared_ptr<GpuBuffer> vertexBuffer = nullptr;
+  std::shared_ptr<Data> vertexData = nullptr;
   if (vertexBufferProxy) {
     vertexBuffer = vertexBufferProxy->getBuffer();
     if (vertexBuffer == nullptr) {
       return;
     }
-  } else if (vertexData == nullptr) {
+  } else {
+    vertexData = vertexSource ? vertexSource->getData() : nullptr;
+    if (vertexData == nullptr) {
+      return;
+    }
+  }
+  auto width = renderPass->renderTarget()->width();
+  auto height = renderPass->renderTarget()->height();
+  auto useScale = UseScale(renderPass->getContext());
+  auto numIndicesPerRRect = ResourceProvider::NumIndicesPerRRect();
+  if (instanced) {
+    auto instanceData = instanceSource ? instanceSource->getData() : nullptr;
+    if (instanceData == nullptr) {
+      return;
+    }
+    auto pipeline = createPipeline(
+        renderPass, EllipseGeometryProcessor::MakeInstanced(width, height, useScale, aaType));
+    renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+    renderPass->bindBuffers(indexBuffer, vertexBuffer, instanceData);
+    renderPass->drawIndexedInstanced(PrimitiveType::Triangles, 0, numIndicesPerRRect, rectCount);
     return;
   }
-  auto pipeline = createPipeline(
-      renderPass, EllipseGeometryProcessor::Make(renderPass->renderTarget()->width(),
-                                                 renderPass->renderTarget()->height(), false,
-                                                 UseScale(renderPass->getContext())));
+  auto pipeline =
+      createPipeline(renderPass, EllipseGeometryProcessor::Make(width, height, false, useScale));
   renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
   if (vertexBuffer) {
     renderPass->bindBuffers(indexBuffer, vertexBuffer);
   } else {
     renderPass->bindBuffers(indexBuffer, vertexData);
   }
-  auto numIndicesPerRRect = ResourceProvider::NumIndicesPerRRect();
   renderPass->drawIndexed(PrimitiveType::Triangles, 0, rectCount * numIndicesPerRRect);
 }
 }  // namespace tgfx
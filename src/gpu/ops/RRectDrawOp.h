@@ -35,10 +35,17 @@ struct RRectPaint {
 class RRectDrawOp : public DrawOp {
  public:
   /**
-   * The maximum number of round rects that can be drawn in a single draw call.
+   * The maximum number of round rects that can be drawn in a single non-instanced draw call.
    */
   static constexpr uint16_t MaxNumRRects = 512;
 
+  /**
+   * The maximum number of round rects batched into a single instanced draw call if
+   * Caps::instancedDrawSupport is true. Instancing has no hard limit, but capping the batches keeps
+   * the instance buffers small and the batch bounds tight for the overlap tests of later draws.
+   */
+  static constexpr uint16_t MaxNumInstancedRRects = 4096;
+
   /**
    * Create a new RRectDrawOp for a list of RRectPaints. Note that the returned RRectDrawOp is in
    * the device space.
@@ -52,8 +59,10 @@ class RRectDrawOp : public DrawOp {
   RRectDrawOp(AAType aaType, size_t rectCount);
 
   size_t rectCount = 0;
+  bool instanced = false;
   std::shared_ptr<GpuBufferProxy> indexBufferProxy = nullptr;
   std::shared_ptr<GpuBufferProxy> vertexBufferProxy = nullptr;
-  std::shared_ptr<Data> vertexData = nullptr;
+  std::unique_ptr<DataSource<Data>> vertexSource = nullptr;
+  std::unique_ptr<DataSource<Data>> instanceSource = nullptr;
 };
 }  // namespace tgfx
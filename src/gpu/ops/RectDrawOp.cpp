@@ -131,6 +131,43 @@ class RectNonCoverageVerticesProvider : public DataSource<Data> {
   bool useUVCoord = false;
 };
 
+class RectInstancesProvider : public DataSource<Data> {
+ public:
+  RectInstancesProvider(std::vector<RectPaint> rectPaints, bool hasColor)
+      : rectPaints(std::move(rectPaints)), hasColor(hasColor) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    // rect (4), matrix rows (3 + 3), color (1)
+    size_t perInstanceCount = hasColor ? 11 : 10;
+    Buffer buffer(rectPaints.size() * perInstanceCount * sizeof(float));
+    auto vertices = reinterpret_cast<float*>(buffer.data());
+    auto index = 0;
+    for (auto& rectPaint : rectPaints) {
+      auto& rect = rectPaint.rect;
+      auto& viewMatrix = rectPaint.viewMatrix;
+      vertices[index++] = rect.left;
+      vertices[index++] = rect.top;
+      vertices[index++] = rect.right;
+      vertices[index++] = rect.bottom;
+      vertices[index++] = viewMatrix.getScaleX();
+      vertices[index++] = viewMatrix.getSkewX();
+      vertices[index++] = viewMatrix.getTranslateX();
+      vertices[index++] = viewMatrix.getSkewY();
+      vertices[index++] = viewMatrix.getScaleY();
+      vertices[index++] = viewMatrix.getTranslateY();
+      if (hasColor) {
+        WriteUByte4Color(vertices, index, rectPaint.color);
+      }
+    }
+    return buffer.release();
+  }
+
+ private:
+  std::vector<RectPaint> rectPaints = {};
+  bool hasColor = false;
+};
+
 std::unique_ptr<RectDrawOp> RectDrawOp::Make(Context* context, const std::vector<RectPaint>& rects,
                                              bool useUVCoord, AAType aaType, uint32_t renderFlags) {
   if (rects.empty()) {
@@ -146,10 +183,24 @@ std::unique_ptr<RectDrawOp> RectDrawOp::Make(Context* context, const std::vector
     }
   }
   drawOp->uniformColor = uniformColor;
+  auto resourceProvider = context->resourceProvider();
+  if (rects.size() > 1 && context->caps()->instancedDrawSupport) {
+    // Upload one small record per rect and expand it into a quad in the vertex shader.
+    drawOp->instanced = true;
+    if (aaType == AAType::Coverage) {
+      drawOp->indexBufferProxy = resourceProvider->aaQuadIndexBuffer();
+      drawOp->vertexBufferProxy = resourceProvider->aaQuadUnitBuffer();
+    } else {
+      drawOp->vertexBufferProxy = resourceProvider->nonAAQuadUnitBuffer();
+    }
+    auto source = std::make_unique<RectInstancesProvider>(rects, !uniformColor.has_value());
+    drawOp->instanceSource = MakeVertexSource(std::move(source), renderFlags);
+    return drawOp;
+  }
   if (aaType == AAType::Coverage) {
-    drawOp->indexBufferProxy = context->resourceProvider()->aaQuadIndexBuffer();
+    drawOp->indexBufferProxy = resourceProvider->aaQuadIndexBuffer();
   } else if (rects.size() > 1) {
-    drawOp->indexBufferProxy = context->resourceProvider()->nonAAQuadIndexBuffer();
+    drawOp->indexBufferProxy = resourceProvider->nonAAQuadIndexBuffer();
   }
   std::unique_ptr<DataSource<Data>> source = nullptr;
   if (aaType == AAType::Coverage) {
@@ -160,11 +211,10 @@ std::unique_ptr<RectDrawOp> RectDrawOp::Make(Context* context, const std::vector
                                                                useUVCoord);
   }
   if (rects.size() > 1) {
-    drawOp->vertexBufferProxy =
-        GpuBufferProxy::MakeFrom(context, std::move(source), BufferType::Vertex, renderFlags);
+    drawOp->vertexSource = MakeVertexSource(std::move(source), renderFlags);
   } else {
     // If we only have one rect, it is not worth the async task overhead.
-    drawOp->vertexData = source->getData();
+    drawOp->vertexSource = std::move(source);
   }
   return drawOp;
 }
@@ -182,19 +232,40 @@ void RectDrawOp::execute(RenderPass* renderPass) {
     }
   }
   std::shared_ptr<GpuBuffer> vertexBuffer;
+  std::shared_ptr<Data> vertexData;
   if (vertexBufferProxy) {
     vertexBuffer = vertexBufferProxy->getBuffer();
     if (vertexBuffer == nullptr) {
       return;
     }
-  } else if (vertexData == nullptr) {
-    return;
+  } else {
+    vertexData = vertexSource ? vertexSource->getData() : nullptr;
+    if (vertexData == nullptr) {
+      return;
+    }
+  }
+  std::shared_ptr<Data> instanceData;
+  if (instanced) {
+    instanceData = instanceSource ? instanceSource->getData() : nullptr;
+    if (instanceData == nullptr) {
+      return;
+    }
   }
   auto pipeline = createPipeline(
       renderPass, QuadPerEdgeAAGeometryProcessor::Make(renderPass->renderTarget()->width(),
                                                        renderPass->renderTarget()->height(), aaType,
-                                                       uniformColor, useUVCoord));
+                                                       uniformColor, useUVCoord, instanced));
   renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+  if (instanced) {
+    renderPass->bindBuffers(indexBuffer, vertexBuffer, instanceData);
+    if (indexBuffer != nullptr) {
+      renderPass->drawIndexedInstanced(PrimitiveType::Triangles, 0,
+                                       ResourceProvider::NumIndicesPerAAQuad(), rectCount);
+    } else {
+      renderPass->drawInstanced(PrimitiveType::TriangleStrip, 0, 4, rectCount);
+    }
+    return;
+  }
   if (vertexBuffer) {
     renderPass->bindBuffers(indexBuffer, vertexBuffer);
   } else {
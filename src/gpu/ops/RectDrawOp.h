@@ -35,15 +35,22 @@ struct RectPaint {
 class RectDrawOp : public DrawOp {
  public:
   /**
-   * The maximum number of non-AA rects that can be drawn in a single draw call.
+   * The maximum number of non-AA rects that can be drawn in a single non-instanced draw call.
    */
   static constexpr uint16_t MaxNumNonAARects = 2048;  // max possible: (1 << 14) - 1;
 
   /**
-   * The maximum number of AA rects that can be drawn in a single draw call.
+   * The maximum number of AA rects that can be drawn in a single non-instanced draw call.
    */
   static constexpr uint16_t MaxNumAARects = 512;  // max possible: (1 << 13) - 1;
 
+  /**
+   * The maximum number of rects batched into a single instanced draw call if
+   * Caps::instancedDrawSupport is true. Instancing has no hard limit, but capping the batches keeps
+   * the instance buffers small and the batch bounds tight for the overlap tests of later draws.
+   */
+  static constexpr uint16_t MaxNumInstancedRects = 4096;
+
   /**
    * Create a new RectDrawOp for a list of RectPaints. The returned RectDrawOp is in the local space
    * of each rect.
@@ -59,8 +66,10 @@ class RectDrawOp : public DrawOp {
   size_t rectCount = 0;
   std::optional<Color> uniformColor = std::nullopt;
   bool useUVCoord = false;
+  bool instanced = false;
   std::shared_ptr<GpuBufferProxy> indexBufferProxy = nullptr;
   std::shared_ptr<GpuBufferProxy> vertexBufferProxy = nullptr;
-  std::shared_ptr<Data> vertexData = nullptr;
+  std::unique_ptr<DataSource<Data>> vertexSource = nullptr;
+  std::unique_ptr<DataSource<Data>> instanceSource = nullptr;
 };
 }  // namespace tgfx
@@ -17,39 +17,156 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeDrawOp.h"
+#include "core/DataSource.h"
 #include "core/PathTriangulator.h"
 #include "core/utils/Log.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/Quad.h"
+#include "gpu/ResourceProvider.h"
 #include "gpu/processors/DefaultGeometryProcessor.h"
 #include "gpu/processors/TextureEffect.h"
 #include "tgfx/core/Buffer.h"
 
 namespace tgfx {
+// matrix rows (3 + 3), color (1)
+static constexpr size_t FloatsPerInstance = 7;
+
+static void WriteUByte4Color(float* vertices, size_t& index, const Color& color) {
+  auto bytes = reinterpret_cast<uint8_t*>(&vertices[index++]);
+  bytes[0] = static_cast<uint8_t>(color.red * 255);
+  bytes[1] = static_cast<uint8_t>(color.green * 255);
+  bytes[2] = static_cast<uint8_t>(color.blue * 255);
+  bytes[3] = static_cast<uint8_t>(color.alpha * 255);
+}
+
+class ShapeInstancesProvider : public DataSource<Data> {
+ public:
+  ShapeInstancesProvider(std::vector<Matrix> matrices, std::vector<Color> colors)
+      : matrices(std::move(matrices)), colors(std::move(colors)) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    Buffer buffer(matrices.size() * FloatsPerInstance * sizeof(float));
+    auto vertices = reinterpret_cast<float*>(buffer.data());
+    size_t index = 0;
+    for (size_t i = 0; i < matrices.size(); i++) {
+      auto& matrix = matrices[i];
+      vertices[index++] = matrix.getScaleX();
+      vertices[index++] = matrix.getSkewX();
+      vertices[index++] = matrix.getTranslateX();
+      vertices[index++] = matrix.getSkewY();
+      vertices[index++] = matrix.getScaleY();
+      vertices[index++] = matrix.getTranslateY();
+      WriteUByte4Color(vertices, index, colors[i]);
+    }
+    return buffer.release();
+  }
+
+ private:
+  std::vector<Matrix> matrices = {};
+  std::vector<Color> colors = {};
+};
+
 std::unique_ptr<ShapeDrawOp> ShapeDrawOp::Make(std::shared_ptr<GpuShapeProxy> shapeProxy,
                                                Color color, const Matrix& uvMatrix, AAType aaType) {
   if (shapeProxy == nullptr) {
     return nullptr;
   }
-  return std::unique_ptr<ShapeDrawOp>(
-      new ShapeDrawOp(std::move(shapeProxy), color, uvMatrix, aaType));
+  std::vector<ShapePaint> shapes = {};
+  shapes.emplace_back(std::move(shapeProxy), color, uvMatrix);
+  return std::unique_ptr<ShapeDrawOp>(new ShapeDrawOp(std::move(shapes), aaType));
+}
+
+std::unique_ptr<ShapeDrawOp> ShapeDrawOp::Make(Context* context, std::vector<ShapePaint> shapes,
+                                               AAType aaType, uint32_t renderFlags) {
+  if (shapes.empty()) {
+    return nullptr;
+  }
+  auto drawOp = std::unique_ptr<ShapeDrawOp>(new ShapeDrawOp(std::move(shapes), aaType));
+  if (drawOp->shapes.size() == 1 || !context->caps()->instancedDrawSupport) {
+    return drawOp;
+  }
+  std::vector<Matrix> matrices = {};
+  std::vector<Color> colors = {};
+  matrices.reserve(drawOp->shapes.size());
+  colors.reserve(drawOp->shapes.size());
+  for (auto& shape : drawOp->shapes) {
+    matrices.push_back(shape.shapeProxy->getDrawingMatrix());
+    colors.push_back(shape.color);
+  }
+  auto provider = std::make_unique<ShapeInstancesProvider>(std::move(matrices), std::move(colors));
+  drawOp->instanceSource = MakeVertexSource(std::move(provider), renderFlags);
+  return drawOp;
 }
 
-ShapeDrawOp::ShapeDrawOp(std::shared_ptr<GpuShapeProxy> shapeProxy, Color color,
-                         const Matrix& uvMatrix, AAType aaType)
-    : DrawOp(aaType), shapeProxy(std::move(shapeProxy)), color(color), uvMatrix(uvMatrix) {
+ShapeDrawOp::ShapeDrawOp(std::vector<ShapePaint> shapes, AAType aaType)
+    : DrawOp(aaType), shapes(std::move(shapes)) {
 }
 
 void ShapeDrawOp::execute(RenderPass* renderPass) {
+  if (instanceSource == nullptr) {
+    for (auto& shape : shapes) {
+      drawShape(renderPass, shape);
+    }
+    return;
+  }
+  auto instanceData = instanceSource->getData();
+  if (instanceData == nullptr) {
+    return;
+  }
+  // Each run of shapes binds the instance records at its own offset, so they are streamed once.
+  auto allocator = renderPass->getContext()->resourceProvider()->vertexAllocator();
+  auto instanceSlice = allocator->write(instanceData->data(), instanceData->size());
+  if (instanceSlice.buffer == nullptr) {
+    return;
+  }
+  auto pipeline = createPipeline(
+      renderPass, DefaultGeometryProcessor::MakeInstanced(renderPass->renderTarget()->width(),
+                                                          renderPass->renderTarget()->height(),
+                                                          aaType));
+  auto programBound = false;
+  size_t index = 0;
+  while (index < shapes.size()) {
+    auto triangles = shapes[index].shapeProxy->getTriangles();
+    if (triangles == nullptr) {
+      // The shape was rasterized into a mask, which needs a texture effect of its own.
+      drawShape(renderPass, shapes[index++]);
+      programBound = false;
+      continue;
+    }
+    // Identical shapes share the same cached triangles, so consecutive ones are drawn together.
+    size_t instanceCount = 1;
+    while (index + instanceCount < shapes.size() &&
+           shapes[index + instanceCount].shapeProxy->getTriangles() == triangles) {
+      instanceCount++;
+    }
+    if (!programBound) {
+      renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+      programBound = true;
+    }
+    auto vertexCount = aaType == AAType::Coverage
+                           ? PathTriangulator::GetAATriangleCount(triangles->size())
+                           : PathTriangulator::GetTriangleCount(triangles->size());
+    renderPass->bindBuffers(nullptr, triangles->buffer(), instanceSlice.buffer,
+                            instanceSlice.offset + index * FloatsPerInstance * sizeof(float),
+                            triangles->offset());
+    renderPass->drawInstanced(PrimitiveType::Triangles, 0, vertexCount, instanceCount);
+    index += instanceCount;
+  }
+}
+
+void ShapeDrawOp::drawShape(RenderPass* renderPass, const ShapePaint& shape) {
+  auto& shapeProxy = shape.shapeProxy;
   if (shapeProxy == nullptr) {
     return;
   }
   auto viewMatrix = shapeProxy->getDrawingMatrix();
-  auto realUVMatrix = uvMatrix;
+  auto realUVMatrix = shape.uvMatrix;
   realUVMatrix.preConcat(viewMatrix);
-  auto vertexBuffer = shapeProxy->getTriangles();
+  auto triangles = shapeProxy->getTriangles();
   std::shared_ptr<Data> vertexData = nullptr;
-  if (vertexBuffer == nullptr) {
+  std::unique_ptr<FragmentProcessor> maskFP = nullptr;
+  if (triangles == nullptr) {
     auto textureProxy = shapeProxy->getTextureProxy();
     if (textureProxy == nullptr) {
       return;
@@ -59,13 +176,13 @@ void ShapeDrawOp::execute(RenderPass* renderPass) {
       return;
     }
     auto maskRect = Rect::MakeWH(textureProxy->width(), textureProxy->height());
-    auto maskFP = TextureEffect::Make(std::move(textureProxy), {}, &maskMatrix, true);
+    maskFP = TextureEffect::Make(std::move(textureProxy), {}, &maskMatrix, true);
     if (maskFP == nullptr) {
       return;
     }
-    addCoverageFP(std::move(maskFP));
     Path path = {};
     path.addRect(maskRect);
+    maskVertices.clear();
     if (aaType == AAType::Coverage) {
       PathTriangulator::ToAATriangles(path, maskRect, &maskVertices);
     } else {
@@ -73,17 +190,20 @@ void ShapeDrawOp::execute(RenderPass* renderPass) {
     }
     vertexData = Data::MakeWithoutCopy(maskVertices.data(), maskVertices.size() * sizeof(float));
   }
+  // The mask only joins this pipeline and is never added to the fragment processors of the op.
   auto pipeline = createPipeline(
-      renderPass, DefaultGeometryProcessor::Make(color, renderPass->renderTarget()->width(),
-                                                 renderPass->renderTarget()->height(), aaType,
-                                                 viewMatrix, realUVMatrix));
+      renderPass,
+      DefaultGeometryProcessor::Make(shape.color, renderPass->renderTarget()->width(),
+                                     renderPass->renderTarget()->height(), aaType, viewMatrix,
+                                     realUVMatrix),
+      std::move(maskFP));
   renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
-  auto vertexDataSize = vertexBuffer ? vertexBuffer->size() : vertexData->size();
+  auto vertexDataSize = triangles ? triangles->size() : vertexData->size();
   auto vertexCount = aaType == AAType::Coverage
                          ? PathTriangulator::GetAATriangleCount(vertexDataSize)
                          : PathTriangulator::GetTriangleCount(vertexDataSize);
-  if (vertexBuffer != nullptr) {
-    renderPass->bindBuffers(nullptr, vertexBuffer);
+  if (triangles != nullptr) {
+    renderPass->bindBuffers(nullptr, triangles->buffer(), triangles->offset());
   } else {
     renderPass->bindBuffers(nullptr, vertexData);
   }
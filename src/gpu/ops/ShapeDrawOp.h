@@ -23,20 +23,39 @@
 #include "tgfx/core/Shape.h"
 
 namespace tgfx {
+struct ShapePaint {
+  ShapePaint(std::shared_ptr<GpuShapeProxy> shapeProxy, const Color& color, const Matrix& uvMatrix)
+      : shapeProxy(std::move(shapeProxy)), color(color), uvMatrix(uvMatrix) {
+  }
+
+  std::shared_ptr<GpuShapeProxy> shapeProxy;
+  Color color;
+  Matrix uvMatrix;
+};
+
 class ShapeDrawOp : public DrawOp {
  public:
   static std::unique_ptr<ShapeDrawOp> Make(std::shared_ptr<GpuShapeProxy> shapeProxy, Color color,
                                            const Matrix& uvMatrix, AAType aaType);
 
+  /**
+   * Creates a new ShapeDrawOp for a list of ShapePaints. If Caps::instancedDrawSupport is true, the
+   * triangulated shapes share one program binding, and their colors and view matrices are passed
+   * as per-instance attributes. No fragment processors should be added to the returned op, since
+   * each shape drawn as a mask needs a pipeline of its own.
+   */
+  static std::unique_ptr<ShapeDrawOp> Make(Context* context, std::vector<ShapePaint> shapes,
+                                           AAType aaType, uint32_t renderFlags);
+
   void execute(RenderPass* renderPass) override;
 
  private:
-  std::shared_ptr<GpuShapeProxy> shapeProxy = nullptr;
-  Color color = Color::Transparent();
-  Matrix uvMatrix = Matrix::I();
+  std::vector<ShapePaint> shapes = {};
+  std::unique_ptr<DataSource<Data>> instanceSource = nullptr;
   std::vector<float> maskVertices = {};
 
-  ShapeDrawOp(std::shared_ptr<GpuShapeProxy> shapeProxy, Color color, const Matrix& uvMatrix,
-              AAType aaType);
+  ShapeDrawOp(std::vector<ShapePaint> shapes, AAType aaType);
+
+  void drawShape(RenderPass* renderPass, const ShapePaint& shape);
 };
 }  // namespace tgfx
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StencilClipOp.h"
+#include "core/PathTriangulator.h"
+#include "gpu/processors/DefaultGeometryProcessor.h"
+
+namespace tgfx {
+class ClipVerticesProvider : public DataSource<Data> {
+ public:
+  ClipVerticesProvider(Path clip, const Rect& clipBounds)
+      : clip(std::move(clip)), clipBounds(clipBounds) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    std::vector<float> vertices = {};
+    if (PathTriangulator::ToTriangles(clip, clipBounds, &vertices) == 0) {
+      return nullptr;
+    }
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+
+ private:
+  Path clip = {};
+  Rect clipBounds = Rect::MakeEmpty();
+};
+
+std::unique_ptr<StencilClipOp> StencilClipOp::Make(const Path& clip, const Rect& clipBounds,
+                                                   const Rect& scissorRect, uint32_t renderFlags) {
+  if (clipBounds.isEmpty()) {
+    return nullptr;
+  }
+  auto provider = std::make_unique<ClipVerticesProvider>(clip, clipBounds);
+  auto vertexSource = MakeVertexSource(std::move(provider), renderFlags);
+  auto op = std::unique_ptr<StencilClipOp>(new StencilClipOp(std::move(vertexSource)));
+  op->setScissorRect(scissorRect);
+  op->setStencilMode(StencilMode::WriteClip);
+  return op;
+}
+
+StencilClipOp::StencilClipOp(std::unique_ptr<DataSource<Data>> vertexSource)
+    : DrawOp(AAType::None), vertexSource(std::move(vertexSource)) {
+}
+
+void StencilClipOp::execute(RenderPass* renderPass) {
+  // An empty triangulation still clears the stencil buffer, which clips out everything.
+  renderPass->clearStencil(scissorRect());
+  auto vertexData = vertexSource->getData();
+  if (vertexData == nullptr) {
+    return;
+  }
+  auto renderTarget = renderPass->renderTarget();
+  auto pipeline = createPipeline(
+      renderPass, DefaultGeometryProcessor::Make(Color::White(), renderTarget->width(),
+                                                 renderTarget->height(), aaType, Matrix::I(),
+                                                 Matrix::I()));
+  renderPass->bindProgramAndScissorClip(pipeline.get(), scissorRect());
+  renderPass->bindBuffers(nullptr, vertexData);
+  renderPass->draw(PrimitiveType::Triangles, 0,
+                   PathTriangulator::GetTriangleCount(vertexData->size()));
+}
+}  // namespace tgfx
@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "DrawOp.h"
+#include "tgfx/core/Path.h"
+
+namespace tgfx {
+/**
+ * StencilClipOp writes a clip path into the stencil buffer of the render target, so the following
+ * draw ops using StencilMode::TestClip are clipped by it without sampling a clip mask. The path is
+ * triangulated without antialiasing. Clip edges only get smoothed on multisampled render targets.
+ */
+class StencilClipOp : public DrawOp {
+ public:
+  /**
+   * Creates a StencilClipOp for the clip path in device space. The stencil buffer is cleared within
+   * the scissor rect first, so it must cover all the pixels the clipped ops may touch. Returns
+   * nullptr if the clip is empty.
+   */
+  static std::unique_ptr<StencilClipOp> Make(const Path& clip, const Rect& clipBounds,
+                                             const Rect& scissorRect, uint32_t renderFlags);
+
+  void execute(RenderPass* renderPass) override;
+
+ private:
+  std::unique_ptr<DataSource<Data>> vertexSource = nullptr;
+
+  explicit StencilClipOp(std::unique_ptr<DataSource<Data>> vertexSource);
+};
+}  // namespace tgfx
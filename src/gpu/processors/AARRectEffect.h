@@ -0,0 +1,45 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/processors/FragmentProcessor.h"
+#include "tgfx/core/RRect.h"
+
+namespace tgfx {
+/**
+ * AARRectEffect multiplies the input color by the antialiased coverage of a device-space round
+ * rect, which lets round rect clips skip rasterizing a clip mask.
+ */
+class AARRectEffect : public FragmentProcessor {
+ public:
+  static std::unique_ptr<AARRectEffect> Make(const RRect& rRect);
+
+  std::string name() const override {
+    return "AARRectEffect";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  explicit AARRectEffect(const RRect& rRect) : FragmentProcessor(ClassID()), rRect(rRect) {
+  }
+
+  RRect rRect = {};
+};
+}  // namespace tgfx
@@ -32,8 +32,25 @@ DefaultGeometryProcessor::DefaultGeometryProcessor(Color color, int width, int h
   setVertexAttributes(&position, attributeCount);
 }
 
+DefaultGeometryProcessor::DefaultGeometryProcessor(int width, int height, AAType aa)
+    : GeometryProcessor(ClassID()), color(Color::White()), width(width), height(height), aa(aa),
+      instanced(true) {
+  position = {"aPosition", SLType::Float2};
+  int attributeCount = 1;
+  if (aa == AAType::Coverage) {
+    attributeCount = 2;
+    coverage = {"inCoverage", SLType::Float};
+  }
+  setVertexAttributes(&position, attributeCount);
+  instanceMatrixRow0 = {"inMatrixRow0", SLType::Float3};
+  instanceMatrixRow1 = {"inMatrixRow1", SLType::Float3};
+  instanceColor = {"inColor", SLType::UByte4Color};
+  setInstanceAttributes(&instanceMatrixRow0, 3);
+}
+
 void DefaultGeometryProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
   uint32_t flags = aa == AAType::Coverage ? 1 : 0;
+  flags |= instanced ? 2 : 0;
   bytesKey->write(flags);
 }
 }  // namespace tgfx
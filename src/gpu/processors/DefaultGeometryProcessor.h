@@ -28,6 +28,12 @@ class DefaultGeometryProcessor : public GeometryProcessor {
                                                         AAType aa, const Matrix& viewMatrix,
                                                         const Matrix& uvMatrix);
 
+  /**
+   * Creates a DefaultGeometryProcessor that reads the color and the view matrix of each shape from
+   * the per-instance attributes, which allows a batch of shapes to share one program binding.
+   */
+  static std::unique_ptr<DefaultGeometryProcessor> MakeInstanced(int width, int height, AAType aa);
+
   std::string name() const override {
     return "DefaultGeometryProcessor";
   }
@@ -38,10 +44,15 @@ class DefaultGeometryProcessor : public GeometryProcessor {
   DefaultGeometryProcessor(Color color, int width, int height, AAType aa, const Matrix& viewMatrix,
                            const Matrix& uvMatrix);
 
+  DefaultGeometryProcessor(int width, int height, AAType aa);
+
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
   Attribute position;
   Attribute coverage;
+  Attribute instanceMatrixRow0;
+  Attribute instanceMatrixRow1;
+  Attribute instanceColor;
 
   Color color;
   int width = 1;
@@ -49,5 +60,6 @@ class DefaultGeometryProcessor : public GeometryProcessor {
   AAType aa = AAType::None;
   Matrix viewMatrix = Matrix::I();
   Matrix uvMatrix = Matrix::I();
+  bool instanced = false;
 };
 }  // namespace tgfx
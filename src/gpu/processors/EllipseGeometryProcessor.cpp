@@ -34,8 +34,23 @@ EllipseGeometryProcessor::EllipseGeometryProcessor(int width, int height, bool s
   this->setVertexAttributes(&inPosition, 4);
 }
 
+EllipseGeometryProcessor::EllipseGeometryProcessor(int width, int height, bool useScale, AAType aa)
+    : GeometryProcessor(ClassID()), width(width), height(height), stroke(false),
+      useScale(useScale), instanced(true), aa(aa) {
+  inPosition = {"inCorner", SLType::Float4};
+  this->setVertexAttributes(&inPosition, 1);
+  inRect = {"inRect", SLType::Float4};
+  inRadii = {"inRadii", SLType::Float2};
+  inMatrixRow0 = {"inMatrixRow0", SLType::Float3};
+  inMatrixRow1 = {"inMatrixRow1", SLType::Float3};
+  inInstanceColor = {"inColor", SLType::UByte4Color};
+  this->setInstanceAttributes(&inRect, 5);
+}
+
 void EllipseGeometryProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
   uint32_t flags = stroke ? 1 : 0;
+  flags |= instanced ? 2 : 0;
+  flags |= aa == AAType::MSAA ? 4 : 0;
   bytesKey->write(flags);
 }
 }  // namespace tgfx
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "GeometryProcessor.h"
+#include "gpu/AAType.h"
 
 namespace tgfx {
 /**
@@ -34,6 +35,15 @@ class EllipseGeometryProcessor : public GeometryProcessor {
   static std::unique_ptr<EllipseGeometryProcessor> Make(int width, int height, bool stroke,
                                                         bool useScale);
 
+  /**
+   * Creates an EllipseGeometryProcessor for filled round rects drawn with instancing. The vertex
+   * buffer holds the 16 corners of a unit 9-patch, and the instance buffer holds one record per
+   * round rect, containing the rect, the radii, the first two rows of the view matrix and the
+   * color, all scaled to the device space the same way RRectDrawOp does on the CPU.
+   */
+  static std::unique_ptr<EllipseGeometryProcessor> MakeInstanced(int width, int height,
+                                                                 bool useScale, AAType aa);
+
   std::string name() const override {
     return "EllipseGeometryProcessor";
   }
@@ -43,6 +53,8 @@ class EllipseGeometryProcessor : public GeometryProcessor {
 
   EllipseGeometryProcessor(int width, int height, bool stroke, bool useScale);
 
+  EllipseGeometryProcessor(int width, int height, bool useScale, AAType aa);
+
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
   Attribute inPosition;
@@ -50,9 +62,17 @@ class EllipseGeometryProcessor : public GeometryProcessor {
   Attribute inEllipseOffset;
   Attribute inEllipseRadii;
 
+  Attribute inRect;
+  Attribute inRadii;
+  Attribute inMatrixRow0;
+  Attribute inMatrixRow1;
+  Attribute inInstanceColor;
+
   int width = 1;
   int height = 1;
   bool stroke;
   bool useScale;
+  bool instanced = false;
+  AAType aa = AAType::None;
 };
 }  // namespace tgfx
@@ -64,6 +64,10 @@ void GeometryProcessor::computeProcessorKey(Context*, BytesKey* bytesKey) const
   for (const auto* attribute : attributes) {
     attribute->computeKey(bytesKey);
   }
+  bytesKey->write(static_cast<uint32_t>(_instanceAttributes.size()));
+  for (const auto* attribute : _instanceAttributes) {
+    attribute->computeKey(bytesKey);
+  }
 }
 
 void GeometryProcessor::setVertexAttributes(const Attribute* attrs, int attrCount) {
@@ -74,15 +78,21 @@ void GeometryProcessor::setVertexAttributes(const Attribute* attrs, int attrCoun
   }
 }
 
+void GeometryProcessor::setInstanceAttributes(const Attribute* attrs, int attrCount) {
+  for (int i = 0; i < attrCount; ++i) {
+    if (attrs[i].isInitialized()) {
+      _instanceAttributes.push_back(attrs + i);
+    }
+  }
+}
+
 void GeometryProcessor::setTransformDataHelper(const Matrix& uvMatrix, UniformBuffer* uniformBuffer,
                                                FPCoordTransformIter* transformIter) const {
   int i = 0;
   while (const CoordTransform* coordTransform = transformIter->next()) {
     Matrix combined = Matrix::I();
     combined.setConcat(coordTransform->getTotalMatrix(), uvMatrix);
-    std::string uniformName = TRANSFORM_UNIFORM_PREFIX;
-    uniformName += std::to_string(i);
-    uniformBuffer->setData(uniformName, combined);
+    uniformBuffer->setData(UniformHandle::MakeIndexed(TRANSFORM_UNIFORM_PREFIX, i), combined);
     ++i;
   }
 }
@@ -74,6 +74,14 @@ class GeometryProcessor : public Processor {
     return attributes;
   }
 
+  /**
+   * Returns the attributes that advance once per instance rather than once per vertex. They are
+   * read from a separate instance buffer in instanced draws.
+   */
+  const std::vector<const Attribute*>& instanceAttributes() const {
+    return _instanceAttributes;
+  }
+
   void computeProcessorKey(Context* context, BytesKey* bytesKey) const override;
 
   class FPCoordTransformHandler {
@@ -127,6 +135,8 @@ class GeometryProcessor : public Processor {
 
   void setVertexAttributes(const Attribute* attrs, int attrCount);
 
+  void setInstanceAttributes(const Attribute* attrs, int attrCount);
+
   /**
    * A helper to upload coord transform matrices in setData().
    */
@@ -146,5 +156,6 @@ class GeometryProcessor : public Processor {
   }
 
   std::vector<const Attribute*> attributes = {};
+  std::vector<const Attribute*> _instanceAttributes = {};
 };
 }  // namespace tgfx
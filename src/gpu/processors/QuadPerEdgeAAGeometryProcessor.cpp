@@ -22,9 +22,25 @@
 namespace tgfx {
 QuadPerEdgeAAGeometryProcessor::QuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
                                                                std::optional<Color> uniformColor,
-                                                               bool useUVCoord)
+                                                               bool useUVCoord, bool instanced)
     : GeometryProcessor(ClassID()), width(width), height(height), aa(aa),
-      uniformColor(uniformColor) {
+      uniformColor(uniformColor), useUVCoord(useUVCoord), instanced(instanced) {
+  if (instanced) {
+    if (aa == AAType::Coverage) {
+      position = {"aCornerWithCoverage", SLType::Float3};
+    } else {
+      position = {"aCorner", SLType::Float2};
+    }
+    setVertexAttributes(&position, 1);
+    instanceRect = {"aRect", SLType::Float4};
+    instanceMatrixRow0 = {"aMatrixRow0", SLType::Float3};
+    instanceMatrixRow1 = {"aMatrixRow1", SLType::Float3};
+    if (!uniformColor.has_value()) {
+      instanceColor = {"inColor", SLType::UByte4Color};
+    }
+    setInstanceAttributes(&instanceRect, 4);
+    return;
+  }
   if (aa == AAType::Coverage) {
     position = {"aPositionWithCoverage", SLType::Float3};
   } else {
@@ -44,6 +60,8 @@ QuadPerEdgeAAGeometryProcessor::QuadPerEdgeAAGeometryProcessor(int width, int he
 void QuadPerEdgeAAGeometryProcessor::onComputeProcessorKey(BytesKey* bytesKey) const {
   uint32_t flags = aa == AAType::Coverage ? 1 : 0;
   flags |= uniformColor.has_value() ? 0 : 2;
+  flags |= instanced ? 4 : 0;
+  flags |= useUVCoord ? 8 : 0;
   bytesKey->write(flags);
 }
 }  // namespace tgfx
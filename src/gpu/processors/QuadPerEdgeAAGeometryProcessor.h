@@ -26,9 +26,15 @@
 namespace tgfx {
 class QuadPerEdgeAAGeometryProcessor : public GeometryProcessor {
  public:
+  /**
+   * Creates a QuadPerEdgeAAGeometryProcessor. If instanced is true, the processor expects a unit
+   * quad in the vertex buffer and one record per rect in the instance buffer, containing the rect,
+   * the first two rows of the view matrix and the optional color. The quad positions, the
+   * anti-aliasing coverage and the UV coordinates are then computed in the vertex shader.
+   */
   static std::unique_ptr<QuadPerEdgeAAGeometryProcessor> Make(int width, int height, AAType aa,
                                                               std::optional<Color> uniformColor,
-                                                              bool useUVCoord);
+                                                              bool useUVCoord, bool instanced);
 
   std::string name() const override {
     return "QuadPerEdgeAAGeometryProcessor";
@@ -38,17 +44,25 @@ class QuadPerEdgeAAGeometryProcessor : public GeometryProcessor {
   DEFINE_PROCESSOR_CLASS_ID
 
   QuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
-                                 std::optional<Color> uniformColor, bool useUVCoord);
+                                 std::optional<Color> uniformColor, bool useUVCoord,
+                                 bool instanced);
 
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
-  Attribute position;  // May contain coverage as last channel
+  Attribute position;  // May contain coverage as last channel, the unit corner if instanced.
   Attribute uvCoord;
   Attribute color;
 
+  Attribute instanceRect;
+  Attribute instanceMatrixRow0;
+  Attribute instanceMatrixRow1;
+  Attribute instanceColor;
+
   int width = 1;
   int height = 1;
   AAType aa = AAType::None;
   std::optional<Color> uniformColor = std::nullopt;
+  bool useUVCoord = false;
+  bool instanced = false;
 };
 }  // namespace tgfx
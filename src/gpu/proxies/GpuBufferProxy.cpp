@@ -49,4 +49,8 @@ GpuBufferProxy::GpuBufferProxy(UniqueKey uniqueKey, BufferType bufferType)
 std::shared_ptr<GpuBuffer> GpuBufferProxy::getBuffer() const {
   return Resource::Find<GpuBuffer>(context, handle.key());
 }
+
+std::shared_ptr<GpuBufferRange> GpuBufferProxy::getBufferRange() const {
+  return Resource::Find<GpuBufferRange>(context, handle.key());
+}
 }  // namespace tgfx
\ No newline at end of file
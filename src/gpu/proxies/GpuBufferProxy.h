@@ -20,7 +20,7 @@
 
 #include "ResourceProxy.h"
 #include "core/DataSource.h"
-#include "gpu/GpuBuffer.h"
+#include "gpu/GpuBufferArena.h"
 #include "tgfx/core/Data.h"
 
 namespace tgfx {
@@ -50,6 +50,11 @@ class GpuBufferProxy : public ResourceProxy {
    */
   std::shared_ptr<GpuBuffer> getBuffer() const;
 
+  /**
+   * Returns the associated GpuBufferRange instance if the data was uploaded into a GpuBufferArena.
+   */
+  std::shared_ptr<GpuBufferRange> getBufferRange() const;
+
  private:
   BufferType _bufferType = BufferType::Vertex;
 
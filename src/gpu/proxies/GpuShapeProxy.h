@@ -36,8 +36,12 @@ class GpuShapeProxy {
     return drawingMatrix;
   }
 
-  std::shared_ptr<GpuBuffer> getTriangles() const {
-    return triangles ? triangles->getBuffer() : nullptr;
+  /**
+   * Returns the range of the shared vertex buffer holding the triangles of the shape, or nullptr
+   * if the shape was rasterized into a texture instead.
+   */
+  std::shared_ptr<GpuBufferRange> getTriangles() const {
+    return triangles ? triangles->getBufferRange() : nullptr;
   }
 
   std::shared_ptr<TextureProxy> getTextureProxy() const {
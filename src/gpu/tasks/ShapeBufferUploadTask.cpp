@@ -17,7 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeBufferUploadTask.h"
-#include "gpu/GpuBuffer.h"
+#include "gpu/ResourceProvider.h"
 #include "gpu/Texture.h"
 
 namespace tgfx {
@@ -50,13 +50,13 @@ bool ShapeBufferUploadTask::execute(Context* context) {
     return false;
   }
   if (auto triangles = shapeBuffer->triangles()) {
-    auto gpuBuffer =
-        GpuBuffer::Make(context, BufferType::Vertex, triangles->data(), triangles->size());
-    if (!gpuBuffer) {
-      LOGE("ShapeBufferUploadTask::execute() Failed to create the GpuBuffer!");
+    auto arena = context->resourceProvider()->shapeBufferArena();
+    auto bufferRange = arena->allocate(triangles->data(), triangles->size());
+    if (!bufferRange) {
+      LOGE("ShapeBufferUploadTask::execute() Failed to allocate the GpuBufferRange!");
       return false;
     }
-    gpuBuffer->assignUniqueKey(uniqueKey);
+    bufferRange->assignUniqueKey(uniqueKey);
   } else {
     auto imageBuffer = shapeBuffer->imageBuffer();
     auto texture = Texture::MakeFrom(context, std::move(imageBuffer));
@@ -17,19 +17,23 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/PathRef.h"
-#include "core/Records.h"
+#include "core/PictureRecords.h"
 #include "core/images/ResourceImage.h"
 #include "core/images/SubsetImage.h"
 #include "core/images/TransformImage.h"
 #include "core/shapes/AppendShape.h"
 #include "core/shapes/ProviderShape.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/GlyphAtlas.h"
+#include "gpu/ImageAtlas.h"
 #include "gpu/RenderContext.h"
+#include "gpu/ResourceProvider.h"
 #include "gpu/Texture.h"
 #include "gpu/opengl/GLCaps.h"
 #include "gpu/opengl/GLSampler.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
+#include "gpu/ops/ShapeDrawOp.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Fill.h"
@@ -226,6 +230,82 @@ TGFX_TEST(CanvasTest, merge_draw_call_rrect) {
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/merge_draw_call_rrect"));
 }
 
+TGFX_TEST(CanvasTest, merge_draw_call_large_batch) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(image != nullptr);
+  auto surface = Surface::Make(context, 720, 160);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  // Each grid holds more shapes than a single non-instanced draw call can take.
+  constexpr size_t ShapeCount = 600;
+  constexpr int Columns = 30;
+  auto cellRect = [](size_t index, float offsetX) {
+    auto x = offsetX + static_cast<float>(static_cast<int>(index) % Columns) * 8.f + 0.5f;
+    auto y = static_cast<float>(static_cast<int>(index) / Columns) * 8.f + 0.5f;
+    return Rect::MakeXYWH(x, y, 6.f, 6.f);
+  };
+  for (size_t i = 0; i < ShapeCount; i++) {
+    canvas->drawRect(cellRect(i, 0.f), paint);
+  }
+  paint.setColor(Color::Blue());
+  for (size_t i = 0; i < ShapeCount; i++) {
+    canvas->drawRoundRect(cellRect(i, 240.f), 2.f, 2.f, paint);
+  }
+  auto scaleX = 6.f / static_cast<float>(image->width());
+  auto scaleY = 6.f / static_cast<float>(image->height());
+  for (size_t i = 0; i < ShapeCount; i++) {
+    auto rect = cellRect(i, 480.f);
+    auto matrix = Matrix::MakeScale(scaleX, scaleY);
+    matrix.postTranslate(rect.left, rect.top);
+    canvas->drawImage(image, matrix);
+  }
+  surface->renderContext->flush();
+  auto* drawingManager = context->drawingManager();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  // Instanced batches are capped far above ShapeCount, otherwise the batches are split by the index
+  // buffers.
+  size_t maxCount = ShapeCount;
+  if (!context->caps()->instancedDrawSupport) {
+    maxCount = std::min(RectDrawOp::MaxNumAARects, RRectDrawOp::MaxNumRRects);
+  }
+  auto opsPerGrid = (ShapeCount + maxCount - 1) / maxCount;
+  ASSERT_EQ(task->ops.size(), 1 + 3 * opsPerGrid);
+  for (size_t i = 0; i < opsPerGrid; i++) {
+    auto count = std::min(maxCount, ShapeCount - i * maxCount);
+    EXPECT_EQ(static_cast<RectDrawOp*>(task->ops[1 + i].get())->rectCount, count);
+    EXPECT_EQ(static_cast<RRectDrawOp*>(task->ops[1 + opsPerGrid + i].get())->rectCount, count);
+    EXPECT_EQ(static_cast<RectDrawOp*>(task->ops[1 + 2 * opsPerGrid + i].get())->rectCount,
+              count);
+  }
+  context->flush();
+  EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/merge_draw_call_large_batch"));
+
+  // Instanced batches are split as well once they reach their cap.
+  canvas->clear(Color::White());
+  paint.setColor(Color::Red());
+  size_t rectCount = RectDrawOp::MaxNumInstancedRects + 1;
+  for (size_t i = 0; i < rectCount; i++) {
+    canvas->drawRect(cellRect(i % ShapeCount, 0.f), paint);
+  }
+  surface->renderContext->flush();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  maxCount = RectDrawOp::MaxNumInstancedRects;
+  if (!context->caps()->instancedDrawSupport) {
+    maxCount = RectDrawOp::MaxNumAARects;
+  }
+  auto opCount = (rectCount + maxCount - 1) / maxCount;
+  ASSERT_EQ(task->ops.size(), 1 + opCount);
+  EXPECT_EQ(static_cast<RectDrawOp*>(task->ops[1].get())->rectCount, maxCount);
+  context->flush();
+}
+
 TGFX_TEST(CanvasTest, textShape) {
   auto serifTypeface =
       Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
@@ -741,7 +821,7 @@ TGFX_TEST(CanvasTest, inversePath) {
   canvas->drawPath(path, paint);
   canvas->restore();
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/inversePath_rect"));
-  auto uniqueKey = PathRef::GetUniqueKey(path);
+  auto uniqueKey = PathRef::GetContentKey(path);
   auto cachesBefore = FindResourceByDomainID(context, uniqueKey.domainID());
   EXPECT_EQ(cachesBefore.size(), 1u);
   canvas->clear();
@@ -756,6 +836,163 @@ TGFX_TEST(CanvasTest, inversePath) {
   EXPECT_TRUE(cachesBefore.front() == cachesAfter.front());
 }
 
+TGFX_TEST(CanvasTest, PathContentKey) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto makePath = [](float radius) {
+    Path path = {};
+    path.addRoundRect(Rect::MakeXYWH(20, 20, 160, 120), radius, radius);
+    path.addArc(Rect::MakeXYWH(40, 40, 100, 80), 0, 270);
+    return path;
+  };
+  auto path = makePath(30);
+  auto samePath = makePath(30);
+  EXPECT_FALSE(path.isSame(samePath));
+  EXPECT_TRUE(PathRef::GetUniqueKey(path) != PathRef::GetUniqueKey(samePath));
+  auto contentKey = PathRef::GetContentKey(path);
+  EXPECT_TRUE(contentKey == PathRef::GetContentKey(samePath));
+  auto otherPath = makePath(31);
+  EXPECT_TRUE(contentKey != PathRef::GetContentKey(otherPath));
+  otherPath = path;
+  otherPath.setFillType(PathFillType::EvenOdd);
+  EXPECT_TRUE(contentKey != PathRef::GetContentKey(otherPath));
+
+  // Paths whose content hashes collide are compared in full and get different keys.
+  auto collidingPath = makePath(32);
+  collidingPath.pathRef->contentHash = path.pathRef->getContentHash();
+  EXPECT_TRUE(contentKey != PathRef::GetContentKey(collidingPath));
+  auto copiedPath = makePath(32);
+  copiedPath.pathRef->contentHash = path.pathRef->getContentHash();
+  EXPECT_TRUE(PathRef::GetContentKey(collidingPath) == PathRef::GetContentKey(copiedPath));
+
+  auto surface = Surface::Make(context, 200, 200);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  canvas->drawPath(path, paint);
+  context->flush();
+  auto cachesBefore = FindResourceByDomainID(context, contentKey.domainID());
+  ASSERT_FALSE(cachesBefore.empty());
+  path = {};
+  canvas->clear();
+  canvas->drawPath(samePath, paint);
+  context->flush();
+  auto cachesAfter = FindResourceByDomainID(context, contentKey.domainID());
+  ASSERT_EQ(cachesAfter.size(), cachesBefore.size());
+  EXPECT_TRUE(cachesBefore.front() == cachesAfter.front());
+  canvas->clear();
+  canvas->drawPath(collidingPath, paint);
+  context->flush();
+  EXPECT_EQ(FindResourceByDomainID(context, contentKey.domainID()).size(), cachesBefore.size());
+  auto collidingKey = PathRef::GetContentKey(collidingPath);
+  EXPECT_FALSE(FindResourceByDomainID(context, collidingKey.domainID()).empty());
+}
+
+TGFX_TEST(CanvasTest, MergeInterleavedDraws) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  for (int i = 0; i < 4; i++) {
+    auto x = static_cast<float>(i * 50);
+    canvas->drawRect(Rect::MakeXYWH(x, 0.f, 40.f, 40.f), paint);
+    canvas->drawRoundRect(Rect::MakeXYWH(x, 50.f, 40.f, 40.f), 10, 10, paint);
+  }
+  surface->renderContext->flush();
+  auto* drawingManager = context->drawingManager();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  EXPECT_EQ(task->ops.size(), 2u);
+  context->flush();
+  EXPECT_EQ(drawingManager->lastOpsMergeStats().mergedOps, 6u);
+  EXPECT_EQ(drawingManager->lastOpsMergeStats().savedProgramSwitches, 6u);
+
+  // Overlapping draws must keep their order.
+  canvas->drawRect(Rect::MakeXYWH(0, 0, 40, 40), paint);
+  canvas->drawRoundRect(Rect::MakeXYWH(20, 20, 40, 40), 10, 10, paint);
+  canvas->drawRect(Rect::MakeXYWH(40, 40, 40, 40), paint);
+  surface->renderContext->flush();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  EXPECT_EQ(task->ops.size(), 3u);
+  context->flush();
+  EXPECT_EQ(drawingManager->lastOpsMergeStats().mergedOps, 0u);
+}
+
+TGFX_TEST(CanvasTest, BatchMaskShapes) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  // A star with this many points in a small area is rasterized into a mask instead of triangles.
+  auto makeStar = [](float centerX, float centerY, float radius) {
+    Path path = {};
+    constexpr int PointCount = 240;
+    for (int i = 0; i < PointCount; i++) {
+      auto angle = static_cast<float>(i) * 2.f * static_cast<float>(M_PI) / PointCount;
+      auto length = i % 2 == 0 ? radius : radius * 0.6f;
+      auto x = centerX + length * cosf(angle);
+      auto y = centerY + length * sinf(angle);
+      if (i == 0) {
+        path.moveTo(x, y);
+      } else {
+        path.lineTo(x, y);
+      }
+    }
+    path.close();
+    return path;
+  };
+  Path triangle = {};
+  triangle.moveTo(10, 10);
+  triangle.lineTo(50, 30);
+  triangle.lineTo(10, 50);
+  triangle.close();
+  auto surface = Surface::Make(context, 400, 300);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  auto drawRow = [&](float top) {
+    for (int i = 0; i < 4; i++) {
+      auto left = static_cast<float>(i) * 100.f;
+      canvas->drawPath(makeStar(left + 50.f, top + 50.f, 40.f + static_cast<float>(i)), paint);
+      canvas->save();
+      canvas->translate(left, top);
+      canvas->drawPath(triangle, paint);
+      canvas->restore();
+    }
+  };
+  drawRow(0);
+  surface->renderContext->flush();
+  auto* drawingManager = context->drawingManager();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  if (context->caps()->instancedDrawSupport) {
+    ASSERT_EQ(task->ops.size(), 2u);
+    EXPECT_EQ(static_cast<ShapeDrawOp*>(task->ops[1].get())->shapes.size(), 8u);
+  }
+  context->flush();
+  // A scissor clip keeps the shapes in one batch.
+  canvas->save();
+  canvas->clipRect(Rect::MakeXYWH(0, 100, 390, 90));
+  drawRow(100);
+  canvas->restore();
+  // A shader or a path clip needs fragment processors, which puts every shape into its own op.
+  Path clip = {};
+  clip.addOval(Rect::MakeXYWH(0, 200, 400, 100));
+  canvas->save();
+  canvas->clipPath(clip);
+  paint.setShader(Shader::MakeLinearGradient(Point{0, 200}, Point{400, 300},
+                                             {Color::Blue(), Color::Green()}, {}));
+  drawRow(200);
+  canvas->restore();
+  context->flush();
+  EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/BatchMaskShapes"));
+}
+
 TGFX_TEST(CanvasTest, saveLayer) {
   ContextScope scope;
   auto context = scope.getContext();
@@ -1252,8 +1489,8 @@ TGFX_TEST(CanvasTest, Picture) {
   paint.setImageFilter(nullptr);
   auto imagePicture = recorder.finishRecordingAsPicture();
   ASSERT_TRUE(imagePicture != nullptr);
-  ASSERT_TRUE(imagePicture->records.size() == 1);
-  EXPECT_EQ(imagePicture->records[0]->type(), RecordType::DrawImage);
+  ASSERT_TRUE(imagePicture->records->size() == 1);
+  EXPECT_EQ((*imagePicture->records)[0]->type(), RecordType::DrawImage);
 
   surface = Surface::Make(context, image->width() - 200, image->height() - 200);
   canvas = surface->getCanvas();
@@ -1540,4 +1777,287 @@ TGFX_TEST(CanvasTest, StrokeShape) {
   canvas->drawShape(shape, Paint());
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/StrokeShape"));
 }
+
+TGFX_TEST(CanvasTest, GlyphAtlas) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  auto canvas = surface->getCanvas();
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 30.f);
+  Paint paint = {};
+  paint.setColor(Color::Black());
+  canvas->drawSimpleText("TGFX", 10, 40, font, paint);
+  auto glyphAtlas = context->resourceProvider()->glyphAtlas();
+  EXPECT_EQ(glyphAtlas->pages.size(), 1u);
+  EXPECT_EQ(glyphAtlas->glyphMap.size(), 4u);
+  // Drawing the same glyphs at the same subpixel positions hits the atlas.
+  canvas->drawSimpleText("GFXT", 10, 80, font, paint);
+  EXPECT_EQ(glyphAtlas->glyphMap.size(), 4u);
+  EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/GlyphAtlas"));
+  // Reading pixels flushes the context, which uploads the new glyphs to the atlas page and hands
+  // the page texture back to the resource cache.
+  auto page = glyphAtlas->pages.front().get();
+  EXPECT_TRUE(page->dirtyBounds.isEmpty());
+  EXPECT_TRUE(page->textureProxy == nullptr);
+  auto pageKey = page->textureKey;
+  EXPECT_TRUE(context->resourceCache()->hasUniqueResource(pageKey));
+
+  // Purging the cache releases the page texture, the next draw rasterizes the glyphs again.
+  context->purgeResourcesUntilMemoryTo(0);
+  EXPECT_FALSE(context->resourceCache()->hasUniqueResource(pageKey));
+  canvas->clear();
+  canvas->drawSimpleText("TGFX", 10, 40, font, paint);
+  canvas->drawSimpleText("GFXT", 10, 80, font, paint);
+  EXPECT_EQ(glyphAtlas->pages.size(), 1u);
+  EXPECT_EQ(glyphAtlas->glyphMap.size(), 4u);
+  EXPECT_FALSE(glyphAtlas->pages.front()->textureKey == pageKey);
+  EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/GlyphAtlas"));
+
+  // A skewed matrix falls back to rasterizing the whole text run.
+  canvas->clear();
+  canvas->skew(0.2f, 0);
+  canvas->drawSimpleText("TGFX", 10, 40, font, paint);
+  EXPECT_EQ(glyphAtlas->glyphMap.size(), 4u);
+  context->flushAndSubmit();
+}
+
+TGFX_TEST(CanvasTest, ImageAtlas) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  std::vector<std::shared_ptr<Image>> images = {};
+  auto info = ImageInfo::Make(32, 32, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  for (uint32_t i = 0; i < 4; i++) {
+    std::vector<uint32_t> pixels(32 * 32);
+    for (uint32_t j = 0; j < pixels.size(); j++) {
+      pixels[j] = 0xFF000000 | (i * 60) << 16 | (j % 32) * 8 << 8 | (j / 32) * 8;
+    }
+    auto data = Data::MakeWithCopy(pixels.data(), pixels.size() * sizeof(uint32_t));
+    images.push_back(Image::MakeFrom(info, std::move(data)));
+    ASSERT_TRUE(images.back() != nullptr);
+  }
+  auto drawImages = [&](Surface* surface) {
+    auto canvas = surface->getCanvas();
+    canvas->clear();
+    for (size_t i = 0; i < images.size(); i++) {
+      canvas->drawImage(images[i], static_cast<float>(i * 40 + 5), 5.f);
+    }
+  };
+  auto surface = Surface::Make(context, 200, 50);
+  drawImages(surface.get());
+  auto imageAtlas = context->resourceProvider()->imageAtlas();
+  EXPECT_EQ(imageAtlas->pages.size(), 1u);
+  EXPECT_EQ(imageAtlas->imageMap.size(), 4u);
+  surface->renderContext->flush();
+  auto* drawingManager = context->drawingManager();
+  ASSERT_TRUE(drawingManager->renderTasks.size() == 1);
+  auto task = static_cast<OpsRenderTask*>(drawingManager->renderTasks.front().get());
+  // The clear op and a single draw op for all images in the atlas page.
+  EXPECT_EQ(task->ops.size(), 2u);
+  Bitmap atlasBitmap(200, 50, false, false);
+  Pixmap atlasPixmap(atlasBitmap);
+  ASSERT_TRUE(surface->readPixels(atlasPixmap.info(), atlasPixmap.writablePixels()));
+  // Reading pixels flushes the context, which copies the images into the atlas page and hands the
+  // page texture back to the resource cache.
+  auto page = imageAtlas->pages.front().get();
+  EXPECT_TRUE(page->pendingCopies.empty());
+  EXPECT_TRUE(page->textureProxy == nullptr);
+  auto pageKey = page->textureKey;
+  EXPECT_TRUE(context->resourceCache()->hasUniqueResource(pageKey));
+
+  // The atlas gives the same result as drawing each image from its own texture.
+  context->setImageAtlasLimit(0);
+  drawImages(surface.get());
+  Bitmap bitmap(200, 50, false, false);
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  auto byteSize = pixmap.info().byteSize();
+  EXPECT_EQ(memcmp(atlasPixmap.pixels(), pixmap.pixels(), byteSize), 0);
+  context->setImageAtlasLimit(ImageAtlas::DefaultMaxImageSize);
+
+  // Purging the cache releases the page texture, the next draw copies the images again.
+  context->purgeResourcesUntilMemoryTo(0);
+  EXPECT_FALSE(context->resourceCache()->hasUniqueResource(pageKey));
+  drawImages(surface.get());
+  EXPECT_EQ(imageAtlas->pages.size(), 1u);
+  EXPECT_EQ(imageAtlas->imageMap.size(), 4u);
+  EXPECT_FALSE(imageAtlas->pages.front()->textureKey == pageKey);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  EXPECT_EQ(memcmp(atlasPixmap.pixels(), pixmap.pixels(), byteSize), 0);
+
+  // Antialiased draws scaled below MinAntiAliasScale don't go through the atlas.
+  std::vector<uint32_t> pixels(32 * 32, 0xFF00FF00);
+  auto data = Data::MakeWithCopy(pixels.data(), pixels.size() * sizeof(uint32_t));
+  auto smallImage = Image::MakeFrom(info, std::move(data));
+  ASSERT_TRUE(smallImage != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  canvas->scale(0.25f, 0.25f);
+  canvas->drawImage(smallImage, 8.f, 8.f);
+  EXPECT_EQ(imageAtlas->imageMap.size(), 4u);
+  Paint paint = {};
+  paint.setAntiAlias(false);
+  canvas->drawImage(smallImage, 8.f, 8.f, &paint);
+  EXPECT_EQ(imageAtlas->imageMap.size(), 5u);
+  canvas->resetMatrix();
+  context->flushAndSubmit();
+}
+
+TGFX_TEST(CanvasTest, ClipStack) {
+  ClipStack clip = {};
+  EXPECT_TRUE(clip.isWideOpen());
+  clip.clipRect(Rect::MakeXYWH(0, 0, 100, 100));
+  clip.clipRect(Rect::MakeXYWH(10, 10, 100, 100), Matrix::MakeScale(0.5f));
+  auto rect = Rect::MakeEmpty();
+  EXPECT_TRUE(clip.isRect(&rect));
+  EXPECT_EQ(rect, Rect::MakeLTRB(5, 5, 55, 55));
+  // A round rect containing the rect clips nothing more out.
+  RRect rRect = {};
+  rRect.setRectXY(Rect::MakeXYWH(0, 0, 60, 60), 5, 5);
+  clip.clipRRect(rRect);
+  EXPECT_TRUE(clip.isRect());
+  // A round rect inside the rect replaces it.
+  rRect.setRectXY(Rect::MakeXYWH(10, 10, 20, 20), 5, 5);
+  clip.clipRRect(rRect);
+  ASSERT_EQ(clip.elements().size(), 1u);
+  EXPECT_EQ(clip.elements().front().type(), ClipElement::Type::RRect);
+  clip.clipRect(Rect::MakeXYWH(20, 0, 100, 100));
+  EXPECT_EQ(clip.elements().size(), 2u);
+  EXPECT_EQ(clip.getBounds(), Rect::MakeLTRB(20, 10, 30, 30));
+  auto savedClip = clip;
+  clip.clipRect(Rect::MakeXYWH(200, 200, 10, 10));
+  EXPECT_TRUE(clip.isEmpty());
+  EXPECT_EQ(savedClip.elements().size(), 2u);
+  EXPECT_FALSE(savedClip.getPath().isEmpty());
+
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  Path path = {};
+  rRect.setRectXY(Rect::MakeXYWH(10, 10, 80, 80), 20, 20);
+  path.addRRect(rRect);
+  canvas->clipPath(path);
+  canvas->clipRect(Rect::MakeLTRB(0.f, 0.f, 50.5f, 100.f));
+  auto& elements = canvas->mcState->clip.elements();
+  EXPECT_EQ(elements.size(), 2u);
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  Bitmap bitmap(100, 100, false, false);
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  auto pixels = static_cast<const uint32_t*>(pixmap.pixels());
+  EXPECT_NE(pixels[40 * 100 + 40], 0u);
+  // Outside the round corner and the right edge of the rect.
+  EXPECT_EQ(pixels[12 * 100 + 12], 0u);
+  EXPECT_EQ(pixels[40 * 100 + 60], 0u);
+}
+
+TGFX_TEST(CanvasTest, ClipMaskCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  auto drawFrame = [&]() {
+    // The clip is rebuilt every frame, and translated by the canvas for the right half.
+    Path clip = {};
+    clip.moveTo(10, 10);
+    clip.lineTo(90, 50);
+    clip.lineTo(10, 90);
+    clip.close();
+    for (int i = 0; i < 2; i++) {
+      for (auto offset : {0.f, 100.f}) {
+        canvas->save();
+        canvas->translate(offset, 0);
+        canvas->clipPath(clip);
+        canvas->resetMatrix();
+        canvas->drawRect(Rect::MakeWH(200, 100), paint);
+        canvas->restore();
+      }
+    }
+    context->flush();
+  };
+  drawFrame();
+  auto drawingManager = context->drawingManager();
+  // Switching back to a clip reuses the mask rendered for it earlier in the frame.
+  EXPECT_EQ(drawingManager->lastClipMaskStats().misses, 2u);
+  EXPECT_EQ(drawingManager->lastClipMaskStats().hits, 2u);
+  // The masks survive in the resource cache and are found by the rebuilt clips of the next frame.
+  drawFrame();
+  EXPECT_EQ(drawingManager->lastClipMaskStats().misses, 0u);
+  EXPECT_EQ(drawingManager->lastClipMaskStats().hits, 4u);
+}
+
+TGFX_TEST(CanvasTest, StencilClip) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 100);
+  auto canvas = surface->getCanvas();
+  Path clip = {};
+  clip.moveTo(20, 10);
+  clip.lineTo(90, 50);
+  clip.lineTo(20, 90);
+  clip.close();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  paint.setAntiAlias(false);
+  canvas->save();
+  canvas->clipPath(clip);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->drawCircle(30, 50, 20, paint);
+  canvas->restore();
+  context->flush();
+  auto drawingManager = context->drawingManager();
+  // Aliased draws test the clip written into the stencil buffer once instead of sampling a mask.
+  EXPECT_EQ(drawingManager->lastClipMaskStats().stencilWrites, 1u);
+  EXPECT_EQ(drawingManager->lastClipMaskStats().hits, 1u);
+  EXPECT_EQ(drawingManager->lastClipMaskStats().misses, 0u);
+  Bitmap bitmap(200, 100, false, false);
+  ASSERT_FALSE(bitmap.isEmpty());
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  EXPECT_EQ(pixmap.getColor(30, 50), Color::Red());
+  EXPECT_EQ(pixmap.getColor(80, 15), Color::Transparent());
+
+  // Antialiased draws still need the coverage of a clip mask.
+  paint.setAntiAlias(true);
+  canvas->save();
+  canvas->clipPath(clip);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  context->flush();
+  EXPECT_EQ(drawingManager->lastClipMaskStats().stencilWrites, 0u);
+  EXPECT_EQ(drawingManager->lastClipMaskStats().misses, 1u);
+
+  // An opaque full-surface draw discards the recorded ops, including the stencil write of the clip,
+  // so drawing with the same clip again has to write the stencil again.
+  paint.setAntiAlias(false);
+  canvas->save();
+  canvas->clipPath(clip);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  Paint opaquePaint = {};
+  opaquePaint.setColor(Color::White());
+  canvas->drawRect(Rect::MakeWH(200, 100), opaquePaint);
+  paint.setColor(Color::Blue());
+  canvas->save();
+  canvas->clipPath(clip);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  context->flush();
+  EXPECT_EQ(drawingManager->lastClipMaskStats().stencilWrites, 2u);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  EXPECT_EQ(pixmap.getColor(30, 50), Color::Blue());
+  EXPECT_EQ(pixmap.getColor(80, 15), Color::White());
+}
 }  // namespace tgfx
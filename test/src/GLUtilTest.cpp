@@ -16,8 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <filesystem>
+#include "gpu/ProgramCache.h"
+#include "gpu/UniformBuffer.h"
 #include "gpu/opengl/GLCaps.h"
+#include "gpu/opengl/GLState.h"
+#include "gpu/opengl/GLUniformBuffer.h"
 #include "gpu/opengl/GLUtil.h"
+#include "tgfx/gpu/PersistentCache.h"
 #include "utils/TestUtils.h"
 
 namespace tgfx {
@@ -119,4 +125,155 @@ TGFX_TEST(GLUtilTest, Caps) {
     }
   }
 }
+
+TGFX_TEST(GLUtilTest, PersistentCache) {
+  auto directory = ProjectPath::Absolute("test/out/PersistentCache");
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  auto cache = PersistentCache::MakeFromDirectory(directory);
+  ASSERT_TRUE(cache != nullptr);
+  auto key = Data::MakeWithCopy("key", 3);
+  auto otherKey = Data::MakeWithCopy("other", 5);
+  EXPECT_TRUE(cache->load(*key) == nullptr);
+  auto value = Data::MakeWithCopy("program binary", 14);
+  cache->store(*key, *value);
+  auto result = cache->load(*key);
+  ASSERT_TRUE(result != nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(result->data()), result->size()),
+            "program binary");
+  EXPECT_TRUE(cache->load(*otherKey) == nullptr);
+
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  context->setPersistentCache(cache);
+  auto programCache = context->programCache();
+  programCache->releaseAll(true);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  surface->getCanvas()->drawRect(Rect::MakeWH(50, 50), Paint());
+  context->flushAndSubmit();
+  if (GLCaps::Get(context)->programBinarySupport) {
+    EXPECT_EQ(programCache->persistentCacheHits(), 0u);
+    EXPECT_GT(programCache->persistentCacheMisses(), 0u);
+    // Recompiling the same program after the in-memory cache is dropped loads the stored binary.
+    programCache->releaseAll(true);
+    surface->getCanvas()->drawRect(Rect::MakeWH(50, 50), Paint());
+    context->flushAndSubmit();
+    EXPECT_GT(programCache->persistentCacheHits(), 0u);
+  } else {
+    EXPECT_EQ(programCache->persistentCacheHits(), 0u);
+    EXPECT_EQ(programCache->persistentCacheMisses(), 0u);
+  }
+  context->setPersistentCache(nullptr);
+  std::filesystem::remove_all(directory);
+}
+
+class RecordingUniformBuffer : public UniformBuffer {
+ public:
+  explicit RecordingUniformBuffer(std::vector<Uniform> uniforms)
+      : UniformBuffer(std::move(uniforms)) {
+  }
+
+  std::vector<std::pair<size_t, size_t>> copies = {};
+
+ protected:
+  void onCopyData(size_t index, size_t offset, size_t, const void*) override {
+    copies.emplace_back(index, offset);
+  }
+};
+
+TGFX_TEST(GLUtilTest, UniformHandles) {
+  constexpr UniformHandle RTAdjust("RTAdjust");
+  constexpr UniformHandle Color("Color");
+  constexpr UniformHandle Alpha("Alpha");
+  EXPECT_TRUE(UniformHandle::MakeIndexed("Matrix_", 12) == UniformHandle("Matrix_12"));
+  EXPECT_TRUE(UniformHandle::MakeIndexed("Matrix_", 0) == UniformHandle("Matrix_0"));
+  EXPECT_TRUE(Color != Alpha);
+  RecordingUniformBuffer buffer({{"RTAdjust", Uniform::Type::Float4, RTAdjust, -1},
+                                 {"Color_P0", Uniform::Type::Float4, Color, 0},
+                                 {"Color_P1", Uniform::Type::Float4, Color, 1},
+                                 {"Alpha_P1", Uniform::Type::Float, Alpha, 1}});
+  ASSERT_EQ(buffer.slots.size(), 3u);
+  EXPECT_EQ(buffer.slots[0].size(), 1u);
+  EXPECT_EQ(buffer.slots[1].size(), 1u);
+  EXPECT_EQ(buffer.slots[2].size(), 2u);
+  std::array<float, 4> value = {1.f, 1.f, 1.f, 1.f};
+  for (int i = 0; i < 2; i++) {
+    buffer.setData(RTAdjust, value);
+    buffer.processorIndex = 0;
+    buffer.setData(Color, value);
+    // Uniforms of other processors are not visible.
+    buffer.setData(Alpha, 0.5f);
+    buffer.processorIndex = 1;
+    buffer.setData(Color, value);
+    buffer.setData(Alpha, 0.5f);
+    buffer.setData(UniformHandle("Missing"), 0.5f);
+    // A size mismatch must not write anything.
+    buffer.setData(Alpha, value);
+    buffer.processorIndex = -1;
+  }
+  std::vector<std::pair<size_t, size_t>> expected = {{0, 0}, {1, 16}, {2, 32}, {3, 48}};
+  ASSERT_EQ(buffer.copies.size(), expected.size() * 2);
+  for (size_t i = 0; i < buffer.copies.size(); i++) {
+    EXPECT_EQ(buffer.copies[i], expected[i % expected.size()]);
+  }
+}
+
+TGFX_TEST(GLUtilTest, UniformBlockLayout) {
+  constexpr UniformHandle Matrix3("Matrix");
+  constexpr UniformHandle Count("Count");
+  GLUniformBuffer buffer({{"Alpha", Uniform::Type::Float, UniformHandle("Alpha")},
+                          {"Offset", Uniform::Type::Float2, UniformHandle("Offset")},
+                          {"Color", Uniform::Type::Float3, UniformHandle("Color")},
+                          {"Matrix", Uniform::Type::Float3x3, Matrix3},
+                          {"Count", Uniform::Type::Int, Count}});
+  std::vector<size_t> expectedOffsets = {0, 8, 16, 32, 80};
+  EXPECT_EQ(buffer.blockOffsets, expectedOffsets);
+  EXPECT_EQ(buffer.blockSize, 96u);
+  auto matrix = Matrix::MakeTrans(10, 20);
+  buffer.setData(Matrix3, matrix);
+  buffer.setData(Count, 7);
+  auto floats = reinterpret_cast<const float*>(buffer.buffer);
+  // Each column of the 3x3 matrix is padded to a vec4.
+  std::vector<float> columns(floats + 8, floats + 20);
+  std::vector<float> expectedColumns = {1, 0, 0, 0, 0, 1, 0, 0, 10, 20, 1, 0};
+  EXPECT_EQ(columns, expectedColumns);
+  EXPECT_EQ(*reinterpret_cast<const int*>(buffer.buffer + 80), 7);
+  EXPECT_TRUE(buffer.bufferChanged);
+}
+
+TGFX_TEST(GLUtilTest, StateTracker) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto state = GLState::Get(context);
+  ASSERT_TRUE(state != nullptr);
+  state->reset();
+  auto issuedCalls = state->issuedCalls();
+  auto skippedCalls = state->skippedCalls();
+  state->setEnabled(GL_BLEND, true);
+  state->setBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  state->setEnabled(GL_BLEND, true);
+  state->setBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  EXPECT_EQ(state->issuedCalls() - issuedCalls, 2u);
+  EXPECT_EQ(state->skippedCalls() - skippedCalls, 2u);
+  // Unknown state is always forwarded after a reset.
+  state->reset();
+  state->setEnabled(GL_BLEND, true);
+  EXPECT_EQ(state->issuedCalls() - issuedCalls, 3u);
+
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  Paint paint;
+  paint.setColor(Color::Red());
+  canvas->drawRect(Rect::MakeXYWH(0, 0, 20, 20), paint);
+  canvas->drawCircle(50, 50, 20, paint);
+  canvas->drawRoundRect(Rect::MakeXYWH(60, 60, 30, 30), 5, 5, paint);
+  skippedCalls = state->skippedCalls();
+  context->flushAndSubmit();
+  // Consecutive draws share the blend and scissor state.
+  EXPECT_GT(state->skippedCalls(), skippedCalls);
+}
 }  // namespace tgfx
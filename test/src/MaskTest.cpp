@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <vector>
+#include "core/PixelBuffer.h"
 #include "core/images/BufferImage.h"
 #include "core/vectors/freetype/FTMask.h"
 #include "tgfx/core/Mask.h"
@@ -76,4 +77,86 @@ TGFX_TEST(MaskTest, Rasterize) {
   canvas->drawImage(glyphImage);
   EXPECT_TRUE(Baseline::Compare(surface, "MaskTest/rasterize_emoji"));
 }
+
+TGFX_TEST(MaskTest, TiledRasterize) {
+  Path path = {};
+  path.addOval(Rect::MakeLTRB(50, 50, 1150, 1150));
+  path.addRoundRect(Rect::MakeLTRB(300, 200, 900, 1000), 120, 80, true);
+  path.addOval(Rect::MakeLTRB(500.5f, 500.5f, 700.5f, 700.5f));
+  auto width = 1200;
+  auto height = 1200;
+  // A mask this large is rasterized in parallel row tiles.
+  auto mask = Mask::Make(width, height);
+  ASSERT_TRUE(mask != nullptr);
+  mask->fillPath(path);
+  auto maskBuffer = std::static_pointer_cast<PixelBuffer>(mask->makeBuffer());
+  ASSERT_TRUE(maskBuffer != nullptr);
+  auto pixels = static_cast<const uint8_t*>(maskBuffer->lockPixels());
+  ASSERT_TRUE(pixels != nullptr);
+  auto rowBytes = maskBuffer->info().rowBytes();
+  // Strips this small are rasterized in a single pass.
+  auto stripHeight = 200;
+  size_t mismatchCount = 0;
+  for (int y = 0; y < height; y += stripHeight) {
+    auto strip = Mask::Make(width, stripHeight);
+    ASSERT_TRUE(strip != nullptr);
+    strip->setMatrix(Matrix::MakeTrans(0, static_cast<float>(-y)));
+    strip->fillPath(path);
+    auto stripBuffer = std::static_pointer_cast<PixelBuffer>(strip->makeBuffer());
+    ASSERT_TRUE(stripBuffer != nullptr);
+    auto stripPixels = static_cast<const uint8_t*>(stripBuffer->lockPixels());
+    ASSERT_TRUE(stripPixels != nullptr);
+    auto stripRowBytes = stripBuffer->info().rowBytes();
+    for (int row = 0; row < stripHeight; row++) {
+      auto expected = stripPixels + static_cast<size_t>(row) * stripRowBytes;
+      auto actual = pixels + static_cast<size_t>(y + row) * rowBytes;
+      for (int x = 0; x < width; x++) {
+        if (expected[x] != actual[x]) {
+          mismatchCount++;
+        }
+      }
+    }
+    stripBuffer->unlockPixels();
+  }
+  maskBuffer->unlockPixels();
+  EXPECT_EQ(mismatchCount, 0u);
+}
+
+#ifdef TGFX_USE_FREETYPE
+TGFX_TEST(MaskTest, TiledRasterizeMatchesSingleTile) {
+  Path path = {};
+  path.addOval(Rect::MakeLTRB(20, 20, 1260, 1180));
+  path.addRoundRect(Rect::MakeLTRB(300, 200, 900, 1000), 120, 80, true);
+  path.addOval(Rect::MakeLTRB(500.5f, 500.5f, 700.5f, 700.5f));
+  auto width = 1280;
+  auto height = 1200;
+  for (auto needsGammaCorrection : {false, true}) {
+    auto tiledPixels = PixelRef::Make(width, height, true, false);
+    auto singlePixels = PixelRef::Make(width, height, true, false);
+    ASSERT_TRUE(tiledPixels != nullptr && singlePixels != nullptr);
+    tiledPixels->clear();
+    singlePixels->clear();
+    FTMask tiledMask(tiledPixels);
+    FTMask singleMask(singlePixels);
+    tiledMask.rasterize(path, Matrix::I(), needsGammaCorrection, 16);
+    singleMask.rasterize(path, Matrix::I(), needsGammaCorrection, 1);
+    auto rowBytes = tiledPixels->info().rowBytes();
+    auto tiled = static_cast<const uint8_t*>(tiledPixels->lockPixels());
+    auto single = static_cast<const uint8_t*>(singlePixels->lockPixels());
+    ASSERT_TRUE(tiled != nullptr && single != nullptr);
+    size_t mismatchCount = 0;
+    for (int y = 0; y < height; y++) {
+      auto offset = static_cast<size_t>(y) * rowBytes;
+      for (int x = 0; x < width; x++) {
+        if (tiled[offset + static_cast<size_t>(x)] != single[offset + static_cast<size_t>(x)]) {
+          mismatchCount++;
+        }
+      }
+    }
+    tiledPixels->unlockPixels();
+    singlePixels->unlockPixels();
+    EXPECT_EQ(mismatchCount, 0u) << "needsGammaCorrection: " << needsGammaCorrection;
+  }
+}
+#endif
 }  // namespace tgfx
@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/MeasureContext.h"
+#include "core/PictureRecords.h"
+#include "tgfx/core/Canvas.h"
+#include "tgfx/core/Clock.h"
+#include "tgfx/core/Recorder.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+TGFX_TEST(PictureTest, Records) {
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  canvas->clipRect(Rect::MakeWH(200, 200));
+  for (int i = 0; i < 10; i++) {
+    canvas->drawRect(Rect::MakeXYWH(i * 10, 0, 10, 10), paint);
+  }
+  canvas->translate(20, 20);
+  canvas->drawCircle(50, 50, 30, paint);
+  canvas->drawRoundRect(Rect::MakeWH(40, 40), 5, 5, paint);
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  auto& records = *picture->records;
+  ASSERT_EQ(records.size(), 12u);
+  // Consecutive records share the entries of the matrix and clip tables.
+  EXPECT_EQ(records.matrices.size(), 2u);
+  EXPECT_EQ(records.clips.size(), 1u);
+  EXPECT_EQ(records[0]->type(), RecordType::DrawRect);
+  EXPECT_EQ(records.matrix(records[0]), Matrix::I());
+  EXPECT_EQ(records[11]->type(), RecordType::DrawRRect);
+  EXPECT_EQ(records.matrix(records[11]), Matrix::MakeTrans(20, 20));
+  EXPECT_EQ(picture->getBounds(), Rect::MakeWH(100, 100));
+}
+
+/**
+ * Counts the rects replayed to it, so tests can check which records playback visits.
+ */
+class RectCounter : public MeasureContext {
+ public:
+  size_t rectCount = 0;
+
+  void drawRect(const Rect& rect, const MCState& state, const Fill& fill) override {
+    rectCount++;
+    MeasureContext::drawRect(rect, state, fill);
+  }
+};
+
+static std::shared_ptr<Picture> MakeGridPicture(int columns, int rows) {
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < columns; x++) {
+      canvas->drawRect(Rect::MakeXYWH(x * 10, y * 10, 8, 8), paint);
+    }
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
+TGFX_TEST(PictureTest, CachedBounds) {
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  canvas->drawRect(Rect::MakeXYWH(10, 10, 50, 50), paint);
+  canvas->clipRect(Rect::MakeWH(100, 80));
+  canvas->drawRoundRect(Rect::MakeXYWH(50, 50, 100, 100), 5, 5, paint);
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  EXPECT_FALSE(picture->records->hasScaleDependentBounds());
+  EXPECT_EQ(picture->getBounds(), Rect::MakeXYWH(10, 10, 90, 70));
+  // The cached bounds are mapped directly if the matrix keeps rects as rects.
+  auto matrix = Matrix::MakeScale(2, 3);
+  matrix.postTranslate(5, 5);
+  EXPECT_EQ(picture->getBounds(&matrix), Rect::MakeXYWH(25, 35, 180, 210));
+  MeasureContext context = {};
+  picture->playback(&context, MCState(matrix));
+  EXPECT_EQ(context.getBounds(), picture->getBounds(&matrix));
+
+  Path path = {};
+  path.moveTo(20, 20);
+  path.lineTo(60, 20);
+  path.lineTo(20, 50);
+  path.close();
+  canvas = recorder.beginRecording();
+  canvas->drawPath(path, paint);
+  picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  EXPECT_TRUE(picture->records->hasScaleDependentBounds());
+  EXPECT_EQ(picture->getBounds(), Rect::MakeXYWH(20, 20, 40, 30));
+}
+
+TGFX_TEST(PictureTest, CulledPlayback) {
+  // A small picture tests the bounds of each record, and a large one searches the RTree.
+  for (int size : {4, 40}) {
+    auto picture = MakeGridPicture(size, size);
+    ASSERT_TRUE(picture != nullptr);
+    EXPECT_EQ(picture->records->rTree != nullptr, size * size >= 64);
+    MCState state = {};
+    state.clip.clipRect(Rect::MakeXYWH(5, 5, 10, 10));
+    RectCounter counter = {};
+    picture->playback(&counter, state);
+    EXPECT_EQ(counter.rectCount, 4u);
+    EXPECT_EQ(counter.getBounds(), Rect::MakeXYWH(5, 5, 10, 10));
+
+    state.matrix = Matrix::MakeScale(0.5f);
+    counter = {};
+    picture->playback(&counter, state);
+    EXPECT_EQ(counter.rectCount, 9u);
+
+    counter = {};
+    auto cullRect = Rect::MakeXYWH(0, 0, 5, 5);
+    picture->playback(&counter, MCState(), &cullRect);
+    EXPECT_EQ(counter.rectCount, 1u);
+
+    counter = {};
+    picture->playback(&counter, MCState());
+    EXPECT_EQ(counter.rectCount, static_cast<size_t>(size * size));
+  }
+
+  // Unbounded fills are always replayed, in order with the culled records.
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  canvas->drawRect(Rect::MakeXYWH(100, 100, 10, 10), paint);
+  paint.setColor(Color::FromRGBA(255, 0, 0, 128));
+  canvas->drawPaint(paint);
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  EXPECT_TRUE(picture->hasUnboundedFill());
+  RectCounter counter = {};
+  MCState state = {};
+  state.clip.clipRect(Rect::MakeWH(10, 10));
+  picture->playback(&counter, state);
+  EXPECT_EQ(counter.rectCount, 0u);
+  EXPECT_EQ(counter.getBounds(), Rect::MakeWH(10, 10));
+}
+
+static std::shared_ptr<Picture> RecordRectGrid(int count) {
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  Path clip = {};
+  clip.addOval(Rect::MakeWH(1000, 1000));
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  canvas->clipPath(clip);
+  for (int i = 0; i < count; i++) {
+    canvas->save();
+    canvas->translate(static_cast<float>(i % 100) * 10, static_cast<float>(i / 100 % 100) * 10);
+    canvas->drawRect(Rect::MakeWH(8, 8), paint);
+    canvas->drawRoundRect(Rect::MakeWH(8, 8), 2, 2, paint);
+    canvas->restore();
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
+TGFX_TEST(PictureTest, RecordDedup) {
+  static constexpr int RecordCount = 200;
+  auto picture = RecordRectGrid(RecordCount);
+  ASSERT_TRUE(picture != nullptr);
+  auto& records = *picture->records;
+  ASSERT_EQ(records.size(), static_cast<size_t>(RecordCount) * 2);
+  // Both draws between a save and restore share one matrix, and all draws share the clip.
+  EXPECT_EQ(records.matrices.size(), static_cast<size_t>(RecordCount));
+  EXPECT_EQ(records.clips.size(), 1u);
+  RectCounter counter = {};
+  picture->playback(&counter, MCState());
+  EXPECT_EQ(counter.rectCount, static_cast<size_t>(RecordCount));
+  counter = {};
+  auto cullRect = Rect::MakeXYWH(42, 12, 4, 4);
+  picture->playback(&counter, MCState(), &cullRect);
+  EXPECT_EQ(counter.rectCount, 1u);
+}
+
+TGFX_TEST(PictureTest, DISABLED_RecordBenchmark) {
+  static constexpr int RecordCount = 100000;
+  Clock clock = {};
+  auto picture = RecordRectGrid(RecordCount);
+  auto recordTime = clock.elapsedTime();
+  ASSERT_TRUE(picture != nullptr);
+  auto& records = *picture->records;
+  clock.reset();
+  RectCounter counter = {};
+  picture->playback(&counter, MCState());
+  auto playbackTime = clock.elapsedTime();
+  clock.reset();
+  counter = {};
+  auto cullRect = Rect::MakeXYWH(400, 400, 100, 100);
+  picture->playback(&counter, MCState(), &cullRect);
+  auto culledTime = clock.elapsedTime();
+  auto bytesPerRecord = static_cast<double>(records.memoryUsage()) /
+                        static_cast<double>(records.size());
+  printf("records: %zu, record: %lld us, playback: %lld us, culled playback: %lld us, "
+         "memory: %.1f bytes/record\n",
+         records.size(), static_cast<long long>(recordTime),
+         static_cast<long long>(playbackTime), static_cast<long long>(culledTime),
+         bytesPerRecord);
+}
+}  // namespace tgfx
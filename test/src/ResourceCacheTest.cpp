@@ -16,9 +16,13 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <thread>
 #include <vector>
 #include "core/utils/UniqueID.h"
+#include "gpu/GpuBufferArena.h"
+#include "gpu/ProgramCache.h"
 #include "gpu/Resource.h"
+#include "gpu/opengl/GLGpu.h"
 #include "tgfx/core/Task.h"
 #include "utils/TestUtils.h"
 
@@ -60,4 +64,193 @@ TGFX_TEST(ResourceCacheTest, multiThreadRecycling) {
     }
   });
 }
+
+TGFX_TEST(ResourceCacheTest, ReturnQueue) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto resourceCache = context->resourceCache();
+  BytesKey bytesKey = {};
+  bytesKey.write(UniqueID::Next());
+  ScratchKey scratchKey = bytesKey;
+  auto first = Resource::AddToCache(context, new TestResource(), scratchKey);
+  auto second = Resource::AddToCache(context, new TestResource(), scratchKey);
+  auto firstPointer = first.get();
+  EXPECT_TRUE(Resource::Find<TestResource>(context, scratchKey) == nullptr);
+  // The last user reference can be dropped on any thread.
+  std::thread([resource = std::move(first)]() mutable { resource = nullptr; }).join();
+  resourceCache->processUnreferencedResources();
+  EXPECT_EQ(resourceCache->getPurgeableBytes(), 1u);
+  EXPECT_EQ(resourceCache->scratchKeyMap[scratchKey].size(), 1u);
+  auto reused = Resource::Find<TestResource>(context, scratchKey);
+  EXPECT_EQ(reused.get(), firstPointer);
+  EXPECT_EQ(resourceCache->getPurgeableBytes(), 0u);
+  EXPECT_TRUE(resourceCache->scratchKeyMap.find(scratchKey) == resourceCache->scratchKeyMap.end());
+  reused = nullptr;
+  second = nullptr;
+  resourceCache->purgeUntilMemoryTo(0);
+  EXPECT_EQ(resourceCache->getPurgeableBytes(), 0u);
+  EXPECT_TRUE(resourceCache->scratchKeyMap.empty());
+}
+
+TGFX_TEST(ResourceCacheTest, GpuBufferArena) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  GpuBufferArena arena(context, BufferType::Vertex, 256);
+  std::vector<float> vertices(10, 1.0f);
+  auto vertexSize = vertices.size() * sizeof(float);
+  auto first = arena.allocate(vertices.data(), vertexSize);
+  auto second = arena.allocate(vertices.data(), vertexSize);
+  auto third = arena.allocate(vertices.data(), vertexSize);
+  ASSERT_TRUE(first != nullptr && second != nullptr && third != nullptr);
+  EXPECT_EQ(first->buffer(), third->buffer());
+  EXPECT_EQ(first->offset(), 0u);
+  EXPECT_EQ(second->offset(), 48u);
+  EXPECT_EQ(third->offset(), 96u);
+  EXPECT_EQ(second->size(), vertexSize);
+  EXPECT_EQ(first->memoryUsage(), 0u);
+  EXPECT_EQ(arena.blockCount(), 1u);
+  // Freeing adjacent ranges merges them, so a larger range fits into the gap.
+  first = nullptr;
+  second = nullptr;
+  context->resourceCache()->purgeUntilMemoryTo(0);
+  std::vector<float> largeVertices(20, 1.0f);
+  auto large = arena.allocate(largeVertices.data(), largeVertices.size() * sizeof(float));
+  ASSERT_TRUE(large != nullptr);
+  EXPECT_EQ(large->buffer(), third->buffer());
+  EXPECT_EQ(large->offset(), 0u);
+  std::vector<float> hugeVertices(100, 1.0f);
+  auto huge = arena.allocate(hugeVertices.data(), hugeVertices.size() * sizeof(float));
+  ASSERT_TRUE(huge != nullptr);
+  EXPECT_NE(huge->buffer(), third->buffer());
+  EXPECT_EQ(huge->buffer()->size(), hugeVertices.size() * sizeof(float));
+  EXPECT_EQ(arena.blockCount(), 2u);
+  // The blocks are dropped once all their ranges are released.
+  std::weak_ptr<GpuBuffer> block = third->buffer();
+  huge = nullptr;
+  large = nullptr;
+  third = nullptr;
+  context->resourceCache()->purgeUntilMemoryTo(0);
+  EXPECT_EQ(arena.blockCount(), 0u);
+  EXPECT_TRUE(block.expired());
+}
+
+TGFX_TEST(ResourceCacheTest, GpuBufferArenaPurge) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto resourceCache = context->resourceCache();
+  resourceCache->purgeUntilMemoryTo(0);
+  auto baseBytes = resourceCache->getResourceBytes();
+  GpuBufferArena arena(context, BufferType::Vertex, 256);
+  // Two ranges fill a block, so four ranges end up in two blocks.
+  std::vector<float> vertices(32, 1.0f);
+  std::vector<std::shared_ptr<GpuBufferRange>> ranges = {};
+  std::vector<UniqueKey> keys = {};
+  for (int i = 0; i < 4; i++) {
+    auto range = arena.allocate(vertices.data(), vertices.size() * sizeof(float));
+    ASSERT_TRUE(range != nullptr);
+    keys.push_back(UniqueKey::Make());
+    range->assignUniqueKey(keys.back());
+    ranges.push_back(std::move(range));
+  }
+  EXPECT_EQ(arena.blockCount(), 2u);
+  EXPECT_EQ(ranges[0]->buffer(), ranges[1]->buffer());
+  EXPECT_EQ(ranges[2]->buffer(), ranges[3]->buffer());
+  EXPECT_EQ(resourceCache->getResourceBytes(), baseBytes + 512);
+  // Interleave the blocks in LRU order, so that evicting ranges one by one would leave a single
+  // range of each block behind before any bytes get freed.
+  for (auto index : {0, 2, 1, 3}) {
+    ranges[static_cast<size_t>(index)] = nullptr;
+    resourceCache->processUnreferencedResources();
+  }
+  // Evicting the least recently used range evicts its whole block.
+  resourceCache->purgeUntilMemoryTo(baseBytes + 256);
+  EXPECT_EQ(resourceCache->getResourceBytes(), baseBytes + 256);
+  EXPECT_EQ(arena.blockCount(), 1u);
+  EXPECT_FALSE(resourceCache->hasUniqueResource(keys[0]));
+  EXPECT_FALSE(resourceCache->hasUniqueResource(keys[1]));
+  EXPECT_TRUE(resourceCache->hasUniqueResource(keys[2]));
+  EXPECT_TRUE(resourceCache->hasUniqueResource(keys[3]));
+  // A range still in use keeps its block, while the other ranges of the block are evicted.
+  auto range = Resource::Find<GpuBufferRange>(context, keys[2]);
+  ASSERT_TRUE(range != nullptr);
+  resourceCache->purgeUntilMemoryTo(0);
+  EXPECT_EQ(resourceCache->getResourceBytes(), baseBytes + 256);
+  EXPECT_TRUE(resourceCache->hasUniqueResource(keys[2]));
+  EXPECT_FALSE(resourceCache->hasUniqueResource(keys[3]));
+  EXPECT_EQ(arena.blockCount(), 1u);
+  range = nullptr;
+  resourceCache->purgeUntilMemoryTo(0);
+  EXPECT_EQ(resourceCache->getResourceBytes(), baseBytes);
+  EXPECT_EQ(arena.blockCount(), 0u);
+}
+
+TGFX_TEST(ResourceCacheTest, ProgramCacheLimit) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto programCache = context->programCache();
+  programCache->releaseAll(true);
+  EXPECT_EQ(context->programCacheLimit(), ProgramCache::DefaultCacheLimit);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  canvas->drawRect(Rect::MakeWH(50, 50), paint);
+  paint.setShader(Shader::MakeLinearGradient({0, 0}, {50, 50}, {Color::Red(), Color::Blue()}, {}));
+  canvas->drawRect(Rect::MakeXYWH(50, 50, 50, 50), paint);
+  context->flushAndSubmit();
+  EXPECT_GE(programCache->programLRU.size(), 2u);
+  EXPECT_GT(programCache->memoryUsage(), 0u);
+  // The most recently used program is kept even if it alone exceeds the budget.
+  context->setProgramCacheLimit(1);
+  EXPECT_EQ(programCache->programLRU.size(), 1u);
+  EXPECT_EQ(programCache->memoryUsage(), programCache->programLRU.front()->memoryUsage());
+  context->setProgramCacheLimit(ProgramCache::DefaultCacheLimit);
+  programCache->releaseAll(true);
+  EXPECT_EQ(programCache->memoryUsage(), 0u);
+}
+
+TGFX_TEST(ResourceCacheTest, PrecompilePrograms) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto programCache = context->programCache();
+  programCache->releaseAll(true);
+  auto manifest = ProgramManifest::Make();
+  context->recordPrograms(manifest);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto drawContent = [&]() {
+    auto canvas = surface->getCanvas();
+    Paint paint = {};
+    canvas->drawRect(Rect::MakeWH(50, 50), paint);
+    paint.setShader(
+        Shader::MakeLinearGradient({0, 0}, {50, 50}, {Color::Red(), Color::Blue()}, {}));
+    canvas->drawRect(Rect::MakeXYWH(50, 50, 50, 50), paint);
+    context->flushAndSubmit();
+  };
+  drawContent();
+  context->recordPrograms(nullptr);
+  auto programCount = manifest->size();
+  EXPECT_GE(programCount, 2u);
+
+  auto restored = ProgramManifest::MakeFrom(manifest->serialize());
+  ASSERT_TRUE(restored != nullptr);
+  EXPECT_EQ(restored->size(), programCount);
+  EXPECT_TRUE(ProgramManifest::MakeFrom(Data::MakeWithCopy("TGPM", 4)) == nullptr);
+
+  // Programs that have been built already are skipped.
+  EXPECT_EQ(context->precompilePrograms(*restored), 0u);
+  programCache->releaseAll(true);
+  EXPECT_EQ(context->precompilePrograms(*restored, 1), programCount - 1);
+  EXPECT_EQ(context->precompilePrograms(*restored), 0u);
+  auto gpu = static_cast<GLGpu*>(context->gpu());
+  EXPECT_EQ(gpu->precompiledPrograms.size(), programCount);
+  // The precompiled programs are adopted by the first draws that need them.
+  drawContent();
+  EXPECT_TRUE(gpu->precompiledPrograms.empty());
+}
 }  // namespace tgfx
@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "core/PathTriangulator.h"
+#include "core/ShapeRasterizer.h"
+#include "tgfx/core/Task.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+/**
+ * Rasterizes the triangles by sampling pixel centers and returns the coverage of each pixel.
+ */
+static std::vector<uint8_t> RasterizeTriangles(const std::vector<float>& vertices, int width,
+                                               int height) {
+  std::vector<uint8_t> coverage(static_cast<size_t>(width * height), 0);
+  for (size_t i = 0; i + 5 < vertices.size(); i += 6) {
+    auto x0 = vertices[i], y0 = vertices[i + 1];
+    auto x1 = vertices[i + 2], y1 = vertices[i + 3];
+    auto x2 = vertices[i + 4], y2 = vertices[i + 5];
+    auto area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    if (area == 0) {
+      continue;
+    }
+    auto left = std::max(static_cast<int>(floorf(std::min({x0, x1, x2}))), 0);
+    auto top = std::max(static_cast<int>(floorf(std::min({y0, y1, y2}))), 0);
+    auto right = std::min(static_cast<int>(ceilf(std::max({x0, x1, x2}))), width);
+    auto bottom = std::min(static_cast<int>(ceilf(std::max({y0, y1, y2}))), height);
+    for (int y = top; y < bottom; y++) {
+      for (int x = left; x < right; x++) {
+        auto px = static_cast<float>(x) + 0.5f;
+        auto py = static_cast<float>(y) + 0.5f;
+        auto w0 = ((x1 - px) * (y2 - py) - (x2 - px) * (y1 - py)) / area;
+        auto w1 = ((x2 - px) * (y0 - py) - (x0 - px) * (y2 - py)) / area;
+        auto w2 = 1.0f - w0 - w1;
+        if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+          coverage[static_cast<size_t>(y * width + x)] = 255;
+        }
+      }
+    }
+  }
+  return coverage;
+}
+
+TGFX_TEST(ShapeRasterizerTest, BandedTriangles) {
+  constexpr int width = 512;
+  constexpr int height = 512;
+  // A jagged star with more verbs than the banding threshold, crossing every band many times.
+  std::mt19937 random(12345);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  Path path = {};
+  constexpr int pointCount = 12000;
+  for (int i = 0; i < pointCount; i++) {
+    auto angle = static_cast<float>(i) * 2.0f * static_cast<float>(M_PI) / pointCount;
+    auto radius = 60.0f + 190.0f * distribution(random);
+    auto x = 256.3f + radius * cosf(angle);
+    auto y = 256.7f + radius * sinf(angle);
+    if (i == 0) {
+      path.moveTo(x, y);
+    } else {
+      path.lineTo(x, y);
+    }
+  }
+  path.close();
+  ASSERT_GE(path.countVerbs(), 10000);
+  auto bandCount = ShapeRasterizer::GetBandCount(path, height);
+  auto threadCount = Task::MaxThreadCount();
+  EXPECT_EQ(bandCount, std::max(std::min({threadCount, 16, height / 64}), 1));
+  auto bounds = Rect::MakeWH(width, height);
+  std::vector<float> vertices = {};
+  auto count = PathTriangulator::ToTriangles(path, bounds, &vertices);
+  ASSERT_GT(count, 0u);
+  ShapeRasterizer rasterizer(width, height, Shape::MakeFrom(path), AAType::None);
+  auto data = rasterizer.makeTriangles(path);
+  ASSERT_TRUE(data != nullptr);
+  auto floats = static_cast<const float*>(data->data());
+  std::vector<float> bandedVertices(floats, floats + data->size() / sizeof(float));
+  if (bandCount > 1) {
+    // The bands are cut with path operations, so the triangles differ from the serial ones.
+    EXPECT_NE(bandedVertices, vertices);
+  }
+  auto expected = RasterizeTriangles(vertices, width, height);
+  auto actual = RasterizeTriangles(bandedVertices, width, height);
+  size_t mismatchCount = 0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (expected[i] != actual[i]) {
+      mismatchCount++;
+    }
+  }
+  // Only pixel centers lying exactly on an edge may be classified differently.
+  EXPECT_LE(mismatchCount, expected.size() / 10000);
+}
+}  // namespace tgfx
@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "gpu/StreamingBufferAllocator.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+TGFX_TEST(StreamingBufferAllocatorTest, WriteAndRecycle) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  StreamingBufferAllocator allocator(context, BufferType::Vertex, 256);
+  std::vector<float> vertices(10, 1.0f);
+  auto vertexSize = vertices.size() * sizeof(float);
+  auto first = allocator.write(vertices.data(), vertexSize);
+  auto second = allocator.write(vertices.data(), vertexSize);
+  ASSERT_TRUE(first.buffer != nullptr);
+  // The ring is rewritten every flush, so its blocks must not be allocated as static storage.
+  EXPECT_EQ(first.buffer->usage(), BufferUsage::Dynamic);
+  EXPECT_EQ(first.buffer, second.buffer);
+  EXPECT_EQ(first.offset, 0u);
+  EXPECT_EQ(second.offset, 48u);
+  EXPECT_EQ(allocator.usedBytes(), vertexSize * 2);
+  std::vector<float> largeVertices(100, 1.0f);
+  auto large = allocator.write(largeVertices.data(), largeVertices.size() * sizeof(float));
+  ASSERT_TRUE(large.buffer != nullptr);
+  EXPECT_NE(large.buffer, first.buffer);
+  EXPECT_EQ(large.offset, 0u);
+  EXPECT_EQ(large.buffer->size(), largeVertices.size() * sizeof(float));
+  allocator.recycle();
+  EXPECT_EQ(allocator.usedBytes(), 0u);
+  auto next = allocator.write(vertices.data(), vertexSize);
+  ASSERT_TRUE(next.buffer != nullptr);
+  EXPECT_EQ(next.offset, 0u);
+  allocator.releaseAll(true);
+}
+}  // namespace tgfx
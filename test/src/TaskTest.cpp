@@ -0,0 +1,325 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include "core/utils/LockFreeQueue.h"
+#include "core/utils/TaskGroup.h"
+#include "tgfx/core/Clock.h"
+#include "tgfx/core/Task.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+class CountTask : public Task {
+ public:
+  explicit CountTask(std::atomic_int* counter) : counter(counter) {
+  }
+
+ protected:
+  void onExecute() override {
+    counter->fetch_add(1, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic_int* counter = nullptr;
+};
+
+/**
+ * Blocks a thread until a given number of tasks have counted down, or until a timeout expires.
+ */
+class TaskLatch {
+ public:
+  explicit TaskLatch(int count) : count(count) {
+  }
+
+  void countDown() {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (--count == 0) {
+      condition.notify_all();
+    }
+  }
+
+  /**
+   * Returns true if the count reached zero before the timeout.
+   */
+  bool waitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> autoLock(locker);
+    return condition.wait_for(autoLock, timeout, [this] { return count == 0; });
+  }
+
+ private:
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  int count = 0;
+};
+
+/**
+ * Records how many times the task runs and the thread that ran it last, then counts down the latch
+ * if there is one.
+ */
+class RecordTask : public Task {
+ public:
+  RecordTask(std::atomic_int* runCount, std::thread::id* threadID, TaskLatch* latch = nullptr)
+      : runCount(runCount), threadID(threadID), latch(latch) {
+  }
+
+ protected:
+  void onExecute() override {
+    *threadID = std::this_thread::get_id();
+    runCount->fetch_add(1);
+    if (latch != nullptr) {
+      latch->countDown();
+    }
+  }
+
+ private:
+  std::atomic_int* runCount = nullptr;
+  std::thread::id* threadID = nullptr;
+  TaskLatch* latch = nullptr;
+};
+
+/**
+ * A copy of the previous TaskGroup design used as the benchmark baseline: a single bounded global
+ * queue, a mutex taken on every dequeue, and tasks running on the caller thread when the queue is
+ * full.
+ */
+class GlobalQueueTaskGroup {
+ public:
+  explicit GlobalQueueTaskGroup(int threadCount) : tasks(1024) {
+    for (int i = 0; i < threadCount; i++) {
+      threads.emplace_back([this] {
+        while (!exited) {
+          auto task = popTask();
+          if (task) {
+            task->execute();
+          }
+        }
+      });
+    }
+  }
+
+  ~GlobalQueueTaskGroup() {
+    exited = true;
+    condition.notify_all();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    while (tasks.dequeue() != nullptr) {
+    }
+  }
+
+  void pushTask(std::shared_ptr<Task> task) {
+    if (!tasks.enqueue(task)) {
+      task->execute();
+      return;
+    }
+    if (waitingThreads > 0) {
+      condition.notify_one();
+    }
+  }
+
+ private:
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  std::atomic_bool exited = false;
+  std::atomic_int waitingThreads = 0;
+  LockFreeQueue<std::shared_ptr<Task>> tasks;
+  std::vector<std::thread> threads = {};
+
+  std::shared_ptr<Task> popTask() {
+    std::unique_lock<std::mutex> autoLock(locker);
+    while (!exited) {
+      auto task = tasks.dequeue();
+      if (task) {
+        return task;
+      }
+      waitingThreads++;
+      condition.wait_for(autoLock, std::chrono::milliseconds(10));
+      waitingThreads--;
+    }
+    return nullptr;
+  }
+};
+
+static constexpr int BenchmarkTaskCount = 1 << 15;
+
+/**
+ * Runs BenchmarkTaskCount tasks submitted from producerCount threads with the given submit
+ * function, and returns the throughput in tasks per millisecond.
+ */
+template <typename SubmitFunc>
+static double MeasureThroughput(int producerCount, const SubmitFunc& submit) {
+  std::atomic_int counter = 0;
+  auto tasksPerProducer = BenchmarkTaskCount / producerCount;
+  auto totalTasks = tasksPerProducer * producerCount;
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  tasks.reserve(static_cast<size_t>(totalTasks));
+  for (int i = 0; i < totalTasks; i++) {
+    tasks.push_back(std::make_shared<CountTask>(&counter));
+  }
+  Clock clock = {};
+  std::vector<std::thread> producers = {};
+  for (int i = 0; i < producerCount; i++) {
+    producers.emplace_back([&, i] {
+      auto start = tasks.begin() + static_cast<std::ptrdiff_t>(i * tasksPerProducer);
+      for (auto task = start; task != start + tasksPerProducer; ++task) {
+        submit(*task);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  auto elapsed = static_cast<double>(clock.elapsedTime());
+  EXPECT_EQ(counter.load(), totalTasks);
+  return elapsed > 0 ? static_cast<double>(totalTasks) * 1000.0 / elapsed : 0;
+}
+
+TGFX_TEST(TaskTest, Run) {
+  std::atomic_int counter = 0;
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int i = 0; i < 2000; i++) {
+    tasks.push_back(Task::Run([&counter] {
+      // Submit nested tasks from the worker threads to exercise their own queues.
+      auto nestedTask = Task::Run([&counter] { counter++; });
+      nestedTask->wait();
+      counter++;
+    }));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  EXPECT_EQ(counter.load(), 4000);
+}
+
+TGFX_TEST(TaskTest, ParallelFor) {
+  std::vector<int> values(10000, 0);
+  Task::ParallelFor(values.size(), 64, [&values](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      values[i] += static_cast<int>(i);
+    }
+  });
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values[i], static_cast<int>(i));
+  }
+  std::atomic_int chunkCount = 0;
+  Task::ParallelFor(10, 0, [&chunkCount](size_t begin, size_t end) {
+    EXPECT_EQ(end, begin + 1);
+    chunkCount++;
+  });
+  EXPECT_EQ(chunkCount.load(), 10);
+}
+
+TGFX_TEST(TaskTest, ThreadPoolOptions) {
+  auto taskGroup = TaskGroup::GetInstance();
+  auto threadCount = Task::PrewarmThreadPool();
+  EXPECT_EQ(threadCount, taskGroup->getMaxThreads());
+  EXPECT_EQ(taskGroup->activeThreads.load(), threadCount);
+  // The worker threads have started, the options can no longer change.
+  ThreadPoolOptions options = {};
+  options.maxThreads = threadCount + 1;
+  EXPECT_FALSE(Task::SetThreadPoolOptions(options));
+  EXPECT_EQ(taskGroup->getMaxThreads(), threadCount);
+}
+
+TGFX_TEST(TaskTest, ManyProducers) {
+  static constexpr int ProducerCount = 8;
+  static constexpr int TasksPerProducer = 4096;
+  static constexpr int TaskCount = ProducerCount * TasksPerProducer;
+  std::vector<std::atomic_int> runCounts(TaskCount);
+  std::vector<std::thread::id> threadIDs(TaskCount);
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int i = 0; i < TaskCount; i++) {
+    tasks.push_back(std::make_shared<RecordTask>(&runCounts[i], &threadIDs[i]));
+  }
+  // Tasks submitted from outside the pool go through the shared queue and its overflow list.
+  std::vector<std::thread> producers = {};
+  for (int i = 0; i < ProducerCount; i++) {
+    producers.emplace_back([&tasks, i] {
+      for (int j = i * TasksPerProducer; j < (i + 1) * TasksPerProducer; j++) {
+        Task::Run(tasks[j]);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  for (int i = 0; i < TaskCount; i++) {
+    ASSERT_EQ(runCounts[i].load(), 1) << "task " << i;
+  }
+}
+
+TGFX_TEST(TaskTest, WorkStealing) {
+  if (TaskGroup::GetInstance()->getMaxThreads() < 2) {
+    GTEST_SKIP() << "Stealing needs at least two worker threads.";
+  }
+  static constexpr int TaskCount = 1024;
+  std::vector<std::atomic_int> runCounts(TaskCount);
+  std::vector<std::thread::id> threadIDs(TaskCount);
+  TaskLatch latch(TaskCount);
+  bool allFinished = false;
+  std::thread::id producerID = {};
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int i = 0; i < TaskCount; i++) {
+    tasks.push_back(std::make_shared<RecordTask>(&runCounts[i], &threadIDs[i], &latch));
+  }
+  auto producer = Task::Run([&] {
+    producerID = std::this_thread::get_id();
+    for (auto& task : tasks) {
+      // Submitted from a worker, the task goes to the queue of this worker.
+      Task::Run(task);
+    }
+    // Block this worker without running its own queue, so only the other workers can finish the
+    // tasks by stealing them.
+    allFinished = latch.waitFor(std::chrono::seconds(10));
+  });
+  producer->wait();
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  ASSERT_TRUE(allFinished);
+  for (int i = 0; i < TaskCount; i++) {
+    ASSERT_EQ(runCounts[i].load(), 1) << "task " << i;
+    EXPECT_NE(threadIDs[i], producerID) << "task " << i;
+  }
+}
+
+/**
+ * Compares the throughput of the work-stealing scheduler against the previous global-queue design
+ * with 1 to 64 producer threads. Disabled by default, run it with --gtest_also_run_disabled_tests.
+ */
+TGFX_TEST(TaskTest, DISABLED_SchedulerThroughput) {
+  GlobalQueueTaskGroup globalQueue(TaskGroup::GetInstance()->getMaxThreads());
+  for (int producerCount = 1; producerCount <= 64; producerCount *= 2) {
+    auto globalQueueThroughput = MeasureThroughput(
+        producerCount, [&](std::shared_ptr<Task> task) { globalQueue.pushTask(std::move(task)); });
+    auto workStealingThroughput =
+        MeasureThroughput(producerCount, [](std::shared_ptr<Task> task) { Task::Run(task); });
+    printf("producers: %2d, global queue: %8.1f tasks/ms, work stealing: %8.1f tasks/ms\n",
+           producerCount, globalQueueThroughput, workStealingThroughput);
+  }
+}
+}  // namespace tgfx